@@ -1,4 +1,6 @@
 #include "Camera.hpp"
+#include "../Utils/Utils.hpp"
+#include <cmath>
 
 Camera::Camera()
 {
@@ -21,6 +23,8 @@ Camera::Camera()
     roll = 0.0f;
     fov = 45.0f;
     speed = 2.5f;
+    aspectRatio = CAMERA_DEFAULT_ASPECT_RATIO;
+    dirtyFlags = CAMERA_ALL_DIRTY;
 }
 
 Camera::Camera(const Matrix &position, const Matrix &upDirection, float yaw, float pitch, float roll, float fov,
@@ -37,6 +41,8 @@ Camera::Camera(const Matrix &position, const Matrix &upDirection, float yaw, flo
     this->roll = roll;
     this->fov = fov;
     this->speed = speed;
+    aspectRatio = CAMERA_DEFAULT_ASPECT_RATIO;
+    dirtyFlags = CAMERA_ALL_DIRTY;
 }
 
 Camera::Camera(const Camera &copy)
@@ -49,14 +55,14 @@ Camera &Camera::operator=(const Camera &copy)
     if (&copy != this)
     {
         position = copy.getPosition();
-        frontDirection = copy.getFrontDirection();
-        rightDirection = copy.getRightDirection();
         upDirection = copy.getUpDirection();
         yaw = copy.getYaw();
         pitch = copy.getPitch();
         roll = copy.getRoll();
         fov = copy.getFov();
         speed = copy.getSpeed();
+        aspectRatio = copy.getAspectRatio();
+        dirtyFlags = CAMERA_ALL_DIRTY;
     }
     return (*this);
 }
@@ -72,11 +78,13 @@ Matrix Camera::getPosition() const
 
 Matrix Camera::getFrontDirection() const
 {
+    updateDirections();
     return (frontDirection);
 }
 
 Matrix Camera::getRightDirection() const
 {
+    updateDirections();
     return (rightDirection);
 }
 
@@ -108,45 +116,84 @@ float Camera::getSpeed() const
     return (speed);
 }
 
-void Camera::setPosition(const Matrix &position)
+float Camera::getAspectRatio() const
 {
-    if (position.getRows() != 3 || position.getColumns() != 1)
-        throw(Exception("SET_POSITION", "INVALID_SIZE", position));
+    return (aspectRatio);
+}
 
-    this->position = position;
+const Matrix &Camera::getView() const
+{
+    updateMatrices();
+    return (view);
 }
-void Camera::setFrontDirection(const Matrix &frontDirection)
+
+const Matrix &Camera::getProjection() const
 {
-    if (frontDirection.getRows() != 3 || frontDirection.getColumns() != 1)
-        throw(Exception("SET_FRONT_DIRECTION", "INVALID_SIZE", frontDirection));
+    updateMatrices();
+    return (projection);
+}
 
-    this->frontDirection = frontDirection;
+/*
+    the matrices are stored transposed for OpenGL,
+    so the projection applied after the view is on the right
+*/
+const Matrix &Camera::getViewProjection() const
+{
+    updateMatrices();
+    return (viewProjection);
 }
 
-void Camera::setRightDirection(const Matrix &rightDirection)
+const std::array<s_plane, NB_FRUSTUM_PLANES> &Camera::getFrustum() const
 {
-    if (rightDirection.getRows() != 3 || rightDirection.getColumns() != 1)
-        throw(Exception("SET_RIGHT_DIRECTION", "INVALID_SIZE", rightDirection));
+    updateMatrices();
+    return (frustum);
+}
 
-    this->rightDirection = rightDirection;
+/*
+    a sphere is only hidden when it's entirely behind one of the planes.
+    a sphere near a corner of the frustum can be kept even if it's outside, never the opposite
+*/
+bool Camera::isSphereVisible(const std::array<float, 3> &center, float radius) const
+{
+    updateMatrices();
+    for (size_t i = 0; i < NB_FRUSTUM_PLANES; i++)
+    {
+        const s_plane &plane = frustum[i];
+        const float distance = plane.normal[0] * center[0] + plane.normal[1] * center[1] +
+                               plane.normal[2] * center[2] + plane.distance;
+        if (distance < -radius)
+            return (false);
+    }
+    return (true);
 }
 
+void Camera::setPosition(const Matrix &position)
+{
+    if (position.getRows() != 3 || position.getColumns() != 1)
+        throw(Exception("SET_POSITION", "INVALID_SIZE", position));
+
+    this->position = position;
+    dirtyFlags |= CAMERA_VIEW_DIRTY;
+}
 void Camera::setUpDirection(const Matrix &upDirection)
 {
     if (upDirection.getRows() != 3 || upDirection.getColumns() != 1)
         throw(Exception("SET_UP_DIRECTION", "INVALID_SIZE", upDirection));
 
     this->upDirection = upDirection;
+    dirtyFlags |= CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY;
 }
 
 void Camera::setYaw(float yaw)
 {
     this->yaw = yaw;
+    dirtyFlags |= CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY;
 }
 
 void Camera::setPitch(float pitch)
 {
     this->pitch = pitch;
+    dirtyFlags |= CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY;
 }
 
 void Camera::setRoll(float roll)
@@ -157,6 +204,7 @@ void Camera::setRoll(float roll)
 void Camera::setFov(float fov)
 {
     this->fov = fov;
+    dirtyFlags |= CAMERA_PROJECTION_DIRTY;
 }
 
 void Camera::setSpeed(float speed)
@@ -164,27 +212,102 @@ void Camera::setSpeed(float speed)
     this->speed = speed;
 }
 
+/*
+    a minimized window has a framebuffer of 0 * 0, the last aspect ratio is kept
+*/
+void Camera::setViewport(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+        return;
+    aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+    dirtyFlags |= CAMERA_PROJECTION_DIRTY;
+}
+
 void Camera::addToPosition(const Matrix &position)
 {
     if (position.getRows() != 3 || position.getColumns() != 1)
         throw(Exception("ADD_TO_POSITION", "INVALID_SIZE", position));
 
     this->position = this->position + position;
+    dirtyFlags |= CAMERA_VIEW_DIRTY;
 }
 
 void Camera::addToYaw(float yaw)
 {
     this->yaw += yaw;
+    dirtyFlags |= CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY;
 }
 
 void Camera::addToPitch(float pitch)
 {
     this->pitch += pitch;
+    dirtyFlags |= CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY;
 }
 
 void Camera::addToFov(float fov)
 {
     this->fov += fov;
+    dirtyFlags |= CAMERA_PROJECTION_DIRTY;
+}
+
+void Camera::updateDirections() const
+{
+    if (!(dirtyFlags & CAMERA_DIRECTIONS_DIRTY))
+        return;
+    Matrix direction(3, 1);
+    float directionValues[] = {cosf(Utils::DegToRad(yaw)) * cosf(Utils::DegToRad(pitch)),
+                               sinf(Utils::DegToRad(pitch)),
+                               sinf(Utils::DegToRad(yaw)) * cosf(Utils::DegToRad(pitch))};
+    direction.setData(directionValues, 3);
+    frontDirection = Matrix::normalize(direction);
+    rightDirection = Matrix::normalize(Matrix::crossProduct(frontDirection, upDirection));
+    dirtyFlags &= ~CAMERA_DIRECTIONS_DIRTY;
+}
+
+/*
+    the view-projection and the frustum follow both the view and the projection
+*/
+void Camera::updateMatrices() const
+{
+    if (!(dirtyFlags & (CAMERA_VIEW_DIRTY | CAMERA_PROJECTION_DIRTY)))
+        return;
+    if (dirtyFlags & CAMERA_VIEW_DIRTY)
+    {
+        updateDirections();
+        view = Matrix::lookAt(position, position + frontDirection, upDirection);
+    }
+    if (dirtyFlags & CAMERA_PROJECTION_DIRTY)
+        projection = Matrix::perspective(fov, aspectRatio, CAMERA_NEAR_PLANE, CAMERA_FAR_PLANE);
+    viewProjection = view * projection;
+    updateFrustum();
+    dirtyFlags &= ~(CAMERA_VIEW_DIRTY | CAMERA_PROJECTION_DIRTY);
+}
+
+/*
+    the planes are the sums and the differences of the rows of the view-projection (Gribb and Hartmann).
+    a row of the matrix seen by OpenGL is a column of the stored matrix
+*/
+void Camera::updateFrustum() const
+{
+    float rows[4][4];
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        for (unsigned int j = 0; j < 4; j++)
+            rows[i][j] = viewProjection.getData(j, i);
+    }
+    for (unsigned int i = 0; i < NB_FRUSTUM_PLANES; i++)
+    {
+        const float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+        float values[4];
+
+        for (unsigned int j = 0; j < 4; j++)
+            values[j] = rows[3][j] + sign * rows[i / 2][j];
+        const float length = sqrtf(values[0] * values[0] + values[1] * values[1] + values[2] * values[2]);
+        for (unsigned int j = 0; j < 3; j++)
+            frustum[i].normal[j] = values[j] / length;
+        frustum[i].distance = values[3] / length;
+    }
 }
 
 Camera::Exception::Exception(const std::string &functionName, const std::string &errorMessage, const Matrix &position)
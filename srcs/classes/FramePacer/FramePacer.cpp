@@ -0,0 +1,149 @@
+#include "FramePacer.hpp"
+#include <chrono>
+#include <thread>
+
+FramePacer::FramePacer()
+{
+    mode = VSYNC_MODE;
+    frameDuration = 1.0 / DEFAULT_FIXED_FPS;
+    idleMode = true;
+    nextFrame = 0;
+}
+
+FramePacer::FramePacer(e_frameMode mode, double fps, bool idleMode)
+{
+    this->mode = mode;
+    setFPS(fps);
+    this->idleMode = idleMode;
+    nextFrame = 0;
+}
+
+FramePacer::FramePacer(const FramePacer &copy)
+{
+    *this = copy;
+}
+
+FramePacer &FramePacer::operator=(const FramePacer &copy)
+{
+    if (&copy != this)
+    {
+        mode = copy.getMode();
+        frameDuration = copy.frameDuration;
+        idleMode = copy.isIdleMode();
+        nextFrame = copy.nextFrame;
+    }
+    return (*this);
+}
+
+FramePacer::~FramePacer()
+{
+}
+
+e_frameMode FramePacer::getMode() const
+{
+    return (mode);
+}
+
+std::string FramePacer::getModeName() const
+{
+    if (mode == VSYNC_MODE)
+        return ("vsync");
+    if (mode == UNCAPPED_MODE)
+        return ("uncapped");
+    return (std::to_string(static_cast<int>(getFPS() + 0.5)) + " fps");
+}
+
+double FramePacer::getFPS() const
+{
+    return (1.0 / frameDuration);
+}
+
+bool FramePacer::isIdleMode() const
+{
+    return (idleMode);
+}
+
+bool FramePacer::isVsync() const
+{
+    return (mode == VSYNC_MODE);
+}
+
+void FramePacer::setMode(e_frameMode mode)
+{
+    this->mode = mode;
+    nextFrame = 0;
+}
+
+void FramePacer::setFPS(double fps)
+{
+    if (!(fps > 0))
+        throw(Exception("SET_FPS", "INVALID_FPS", fps));
+    frameDuration = 1.0 / fps;
+}
+
+/*
+    the window only sleeps in idle mode when nothing changed since the last frame:
+    a held key changes the scene every frame without sending any new event
+*/
+bool FramePacer::canWaitEvents(bool changed, bool inputHeld) const
+{
+    return (idleMode && !changed && !inputHeld);
+}
+
+void FramePacer::setIdleMode(bool idleMode)
+{
+    this->idleMode = idleMode;
+}
+
+void FramePacer::nextMode()
+{
+    setMode(static_cast<e_frameMode>((mode + 1) % (FIXED_FPS_MODE + 1)));
+}
+
+/*
+    a frame late by more than a period doesn't make the next frames faster to catch up,
+    the schedule restarts from now.
+    a frame that wasn't rendered already waited for an event, it doesn't wait again
+*/
+void FramePacer::waitNextFrame(bool rendered)
+{
+    if (!rendered || mode != FIXED_FPS_MODE)
+    {
+        nextFrame = 0;
+        return;
+    }
+    const double now = getTime();
+    if (nextFrame == 0 || now - nextFrame > frameDuration)
+        nextFrame = now;
+    nextFrame += frameDuration;
+    sleepUntil(nextFrame);
+}
+
+double FramePacer::getTime()
+{
+    return (std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/*
+    the thread sleeps until SPIN_DURATION before the time, then yields until the time
+*/
+void FramePacer::sleepUntil(double time)
+{
+    double remaining = time - getTime();
+
+    if (remaining > SPIN_DURATION)
+        std::this_thread::sleep_for(std::chrono::duration<double>(remaining - SPIN_DURATION));
+    while (getTime() < time)
+        std::this_thread::yield();
+}
+
+FramePacer::Exception::Exception(const std::string &functionName, const std::string &errorMessage, double value)
+{
+    this->errorMessage = "FRAME_PACER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + std::to_string(value) + "\n|";
+}
+
+const char *FramePacer::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
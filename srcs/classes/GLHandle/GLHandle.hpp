@@ -0,0 +1,160 @@
+#pragma once
+
+#include "../../../libs/glad/glad.h"
+
+/**
+ * owns an OpenGL name and deletes it with the handle.
+ * a handle can be moved but not copied, so a name is deleted exactly once
+ * whatever the containers its owner goes through. a handle of 0 owns nothing
+ */
+template <unsigned int (*Create)(), void (*Destroy)(unsigned int)> class GLHandle
+{
+  private:
+    GLHandle(const GLHandle &copy) = delete;
+    GLHandle &operator=(const GLHandle &copy) = delete;
+
+    unsigned int ID;
+
+  public:
+    GLHandle() : ID(0)
+    {
+    }
+
+    GLHandle(GLHandle &&move) noexcept : ID(move.ID)
+    {
+        move.ID = 0;
+    }
+
+    GLHandle &operator=(GLHandle &&move) noexcept
+    {
+        if (&move != this)
+        {
+            reset();
+            ID = move.ID;
+            move.ID = 0;
+        }
+        return (*this);
+    }
+
+    ~GLHandle()
+    {
+        reset();
+    }
+
+    // a new name, the OpenGL context must be current
+    static GLHandle create()
+    {
+        GLHandle handle;
+
+        handle.ID = Create();
+        return (handle);
+    }
+
+    void reset()
+    {
+        if (ID != 0)
+            Destroy(ID);
+        ID = 0;
+    }
+
+    unsigned int get() const
+    {
+        return (ID);
+    }
+};
+
+inline unsigned int createBuffer()
+{
+    unsigned int ID = 0;
+
+    glGenBuffers(1, &ID);
+    return (ID);
+}
+
+inline void deleteBuffer(unsigned int ID)
+{
+    glDeleteBuffers(1, &ID);
+}
+
+inline unsigned int createVertexArray()
+{
+    unsigned int ID = 0;
+
+    glGenVertexArrays(1, &ID);
+    return (ID);
+}
+
+inline void deleteVertexArray(unsigned int ID)
+{
+    glDeleteVertexArrays(1, &ID);
+}
+
+inline unsigned int createTexture()
+{
+    unsigned int ID = 0;
+
+    glGenTextures(1, &ID);
+    return (ID);
+}
+
+inline void deleteTexture(unsigned int ID)
+{
+    glDeleteTextures(1, &ID);
+}
+
+inline unsigned int createProgram()
+{
+    return (glCreateProgram());
+}
+
+inline void deleteProgram(unsigned int ID)
+{
+    glDeleteProgram(ID);
+}
+
+inline unsigned int createFramebuffer()
+{
+    unsigned int ID = 0;
+
+    glGenFramebuffers(1, &ID);
+    return (ID);
+}
+
+inline void deleteFramebuffer(unsigned int ID)
+{
+    glDeleteFramebuffers(1, &ID);
+}
+
+inline unsigned int createRenderbuffer()
+{
+    unsigned int ID = 0;
+
+    glGenRenderbuffers(1, &ID);
+    return (ID);
+}
+
+inline void deleteRenderbuffer(unsigned int ID)
+{
+    glDeleteRenderbuffers(1, &ID);
+}
+
+inline unsigned int createQuery()
+{
+    unsigned int ID = 0;
+
+    glGenQueries(1, &ID);
+    return (ID);
+}
+
+inline void deleteQuery(unsigned int ID)
+{
+    glDeleteQueries(1, &ID);
+}
+
+typedef GLHandle<createBuffer, deleteBuffer> BufferHandle;
+typedef GLHandle<createVertexArray, deleteVertexArray> VertexArrayHandle;
+typedef GLHandle<createTexture, deleteTexture> TextureHandle;
+typedef GLHandle<createProgram, deleteProgram> ProgramHandle;
+typedef GLHandle<createFramebuffer, deleteFramebuffer> FramebufferHandle;
+typedef GLHandle<createRenderbuffer, deleteRenderbuffer> RenderbufferHandle;
+typedef GLHandle<createQuery, deleteQuery> QueryHandle;
\ No newline at end of file
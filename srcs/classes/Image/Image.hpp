@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../MappedFile/MappedFile.hpp"
+#include <memory>
+#include <string>
+
+typedef enum imageFormat
+{
+    ASCII_RGB,   // P3
+    BINARY_GRAY, // P5
+    BINARY_RGB   // P6
+} e_imageFormat;
+
+/**
+ * decoded PNM image (P3, P5 and P6).
+ * binary images with 8 bits per sample are not copied,
+ * the pixels point directly into the mapped file
+ */
+class Image
+{
+  private:
+    Image() = delete;
+
+    void loadImage(const std::string &path);
+    const unsigned char *readHeader(const unsigned char *cursor, const unsigned char *end);
+    void readAsciiPixels(const unsigned char *cursor, const unsigned char *end);
+    void readBinaryPixels(const unsigned char *cursor, const unsigned char *end);
+    void scalePixels(const unsigned char *cursor, size_t bytesPerSample);
+
+    static bool isSpace(unsigned char c);
+    static const unsigned char *skipSpaces(const unsigned char *cursor, const unsigned char *end);
+    const unsigned char *readNumber(const unsigned char *cursor, const unsigned char *end, unsigned int &value);
+
+    std::unique_ptr<MappedFile> file;
+    e_imageFormat format;
+    int width;
+    int height;
+    unsigned int valueMax;
+    unsigned int channels;
+    const unsigned char *pixels;
+    std::unique_ptr<unsigned char[]> data;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const MappedFile &file,
+                  const unsigned char *position);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    Image(const std::string &path);
+    Image(const Image &copy);
+    Image &operator=(const Image &copy);
+    ~Image();
+
+    e_imageFormat getFormat() const;
+    int getWidth() const;
+    int getHeight() const;
+    unsigned int getChannels() const;
+    size_t getSize() const;
+    const unsigned char *getPixels() const;
+};
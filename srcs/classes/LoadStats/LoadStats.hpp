@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#define LOAD_STATS_ENV "SCOP_LOAD_STATS" // "text" prints the stats at exit, a path ending with .json saves them
+
+typedef enum loadStage
+{
+    READ_FILE_STAGE,
+    PARSE_STAGE, // includes the combination of the vertices and the triangulation
+    COMBINE_VERTICES_STAGE,
+    TRIANGULATE_STAGE,
+    GENERATE_COLORS_STAGE,
+    UPLOAD_STAGE,
+    NB_LOAD_STAGES
+} e_loadStage;
+
+typedef enum loadCounter
+{
+    UNIQUE_VERTICES,
+    DEDUP_HITS,
+    UNIQUE_COLORED_VERTICES,
+    COLORED_DEDUP_HITS,
+    EARS_CLIPPED,
+    TRIANGLES,
+    BYTES_UPLOADED,
+    TEXTURE_CONTAINERS, // textures loaded from their precomputed mipmaps
+    NB_LOAD_COUNTERS
+} e_loadCounter;
+
+typedef struct stageStats
+{
+    size_t calls;
+    double wallTime; // seconds
+    long peakRSS;    // kilobytes, the highest resident memory of the process at the end of the stage
+} s_stageStats;
+
+/**
+ * counters and timings of the loading of a scene, from the file to the GPU.
+ * nothing is measured until the stats are enabled,
+ * the material files parsed in the background aren't measured.
+ * the jobs can measure from any thread, the times of the stages run in parallel are added together,
+ * the counters are added up on the thread without lock and merged when the thread records a stage
+ */
+class LoadStats
+{
+  private:
+    LoadStats() = delete;
+
+    static bool enabled;
+    static std::mutex mutex;
+    static std::map<std::string, size_t, std::less<>> symbols;
+    static std::array<size_t, NB_LOAD_COUNTERS> counters;
+    static std::array<s_stageStats, NB_LOAD_STAGES> stages;
+    static const std::array<const char *, NB_LOAD_STAGES> stageNames;
+    static const std::array<const char *, NB_LOAD_COUNTERS> counterNames;
+    static thread_local std::array<s_stageStats, NB_LOAD_STAGES> spans;
+    static thread_local std::array<size_t, NB_LOAD_COUNTERS> pendingCounters;
+
+    static double getTime();
+    static void mergeCounters();
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &path);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    // measures the time until the end of the scope, or until end() is called
+    class Stage
+    {
+      private:
+        Stage() = delete;
+        Stage(const Stage &copy) = delete;
+        Stage &operator=(const Stage &copy) = delete;
+
+        e_loadStage stage;
+        double start;
+
+      public:
+        Stage(e_loadStage stage);
+        ~Stage();
+
+        void end();
+    };
+
+    // a part of a stage repeated in a loop (a face, a corner), its time is added up on the thread without lock
+    // and recorded as a single call of the stage by flush()
+    class Span
+    {
+      private:
+        Span() = delete;
+        Span(const Span &copy) = delete;
+        Span &operator=(const Span &copy) = delete;
+
+        e_loadStage stage;
+        double start;
+
+      public:
+        Span(e_loadStage stage);
+        ~Span();
+    };
+
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+    static void reset();
+
+    static void countSymbol(std::string_view symbol);
+    static void add(e_loadCounter counter, size_t value = 1);
+    static void flush(e_loadStage stage);
+
+    static size_t getSymbolCount(const std::string &symbol);
+    static size_t getCounter(e_loadCounter counter);
+    static s_stageStats getStage(e_loadStage stage);
+    static long getPeakRSS();
+
+    static std::string toText();
+    static std::string toJSON();
+    static void report();
+};
\ No newline at end of file
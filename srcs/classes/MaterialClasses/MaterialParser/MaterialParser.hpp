@@ -6,7 +6,8 @@
 #include <string>
 #include <vector>
 
-typedef std::map<std::string, void (*)(MaterialData &, const std::string &, unsigned int)> MapMaterialParsingMethods;
+typedef std::map<std::string, void (*)(MaterialData &, const std::string &, unsigned int), std::less<>>
+    MapMaterialParsingMethods;
 
 class MaterialParser
 {
@@ -0,0 +1,153 @@
+#include "MaterialRegistry.hpp"
+#include "../MaterialParser/MaterialParser.hpp"
+#include <algorithm>
+#include <filesystem>
+
+std::mutex MaterialRegistry::mutex;
+std::map<std::string, std::shared_future<std::vector<Material>>> MaterialRegistry::files;
+std::vector<std::string> MaterialRegistry::pendingFiles;
+std::unordered_map<std::string, unsigned int> MaterialRegistry::materialIDs;
+std::vector<Material> MaterialRegistry::materials;
+
+/*
+    the file is parsed in another thread while the object file continues to be parsed,
+    a file already known (even by another path, or by a previous scene) isn't parsed again:
+    its result is only queued to be registered in the current scene
+*/
+void MaterialRegistry::prefetch(const std::string &path)
+{
+    const std::string normalizedPath = normalizePath(path);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (std::find(pendingFiles.begin(), pendingFiles.end(), normalizedPath) != pendingFiles.end())
+        return;
+    if (files.find(normalizedPath) == files.end())
+        files[normalizedPath] = std::async(std::launch::async, &MaterialParser::parseMaterialFile, path).share();
+    pendingFiles.push_back(normalizedPath);
+}
+
+void MaterialRegistry::waitAll()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    registerPendingFiles();
+}
+
+/*
+    the files are registered in the order they were declared,
+    if 2 materials of the scene have the same name, the first one declared is kept.
+    an error in a material file is thrown here, and the file will be parsed again if it is declared again
+*/
+void MaterialRegistry::registerPendingFiles()
+{
+    while (!pendingFiles.empty())
+    {
+        const std::string path = pendingFiles.front();
+        pendingFiles.erase(pendingFiles.begin());
+
+        std::vector<Material> newMaterials;
+        try
+        {
+            newMaterials = files[path].get();
+        }
+        catch (...)
+        {
+            files.erase(path);
+            throw;
+        }
+        for (size_t i = 0; i < newMaterials.size(); i++)
+        {
+            if (materialIDs.find(newMaterials[i].getName()) != materialIDs.end())
+                continue;
+            materialIDs[newMaterials[i].getName()] = materials.size();
+            materials.push_back(newMaterials[i]);
+        }
+    }
+}
+
+std::string MaterialRegistry::normalizePath(const std::string &path)
+{
+    return (std::filesystem::absolute(path).lexically_normal().string());
+}
+
+bool MaterialRegistry::hasMaterial(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    registerPendingFiles();
+    return (materialIDs.find(name) != materialIDs.end());
+}
+
+unsigned int MaterialRegistry::getMaterialID(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    registerPendingFiles();
+    auto it = materialIDs.find(name);
+    if (it == materialIDs.end())
+        throw(Exception("GET_MATERIAL_ID", "UNKNOWN_MATERIAL", name));
+    return (it->second);
+}
+
+Material MaterialRegistry::getMaterial(unsigned int materialID)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (materialID >= materials.size())
+        throw(Exception("GET_MATERIAL", "INVALID_ID", std::to_string(materialID)));
+    return (materials[materialID]);
+}
+
+Material MaterialRegistry::getMaterial(const std::string &name)
+{
+    return (getMaterial(getMaterialID(name)));
+}
+
+size_t MaterialRegistry::getNbMaterials()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    registerPendingFiles();
+    return (materials.size());
+}
+
+/*
+    a new scene starts without any material, the files already parsed are kept for it,
+    the material IDs given before are no longer valid
+*/
+void MaterialRegistry::resetScene()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    pendingFiles.clear();
+    materialIDs.clear();
+    materials.clear();
+}
+
+/*
+    the files still parsed are waited before being forgotten,
+    the material IDs given before are no longer valid
+*/
+void MaterialRegistry::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = files.begin(); it != files.end(); it++)
+        it->second.wait();
+    files.clear();
+    pendingFiles.clear();
+    materialIDs.clear();
+    materials.clear();
+}
+
+MaterialRegistry::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                       const std::string &name)
+{
+    this->errorMessage = "MATERIAL_REGISTRY::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + name + "\n|";
+}
+
+const char *MaterialRegistry::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
@@ -1,47 +1,24 @@
 #include "Object.hpp"
 #include "../../../../libs/glad/glad.h"
+#include "../../LoadStats/LoadStats.hpp"
 #include <cstdlib>
 #include <ctime>
 
-Object::Object(const ObjectData &data)
-{
-    name = data.getName();
-    vertices = data.getVertices();
-    combinedVertices = data.getCombinedVertices();
-    faces = data.getFaces();
-    smoothShading = data.getSmoothShading();
-    material = data.getMaterial();
-    VAOInit = false;
-}
-
-Object::Object(const Object &copy)
-{
-    *this = copy;
-}
-
-Object &Object::operator=(const Object &copy)
+/*
+    the vectors of the data are moved into the object, nothing is copied
+*/
+Object::Object(ObjectData &&data) : ObjectData(std::move(data))
 {
-    if (&copy != this)
-    {
-        vertices = copy.getVertices();
-        combinedVertices = copy.getCombinedVertices();
-        faces = copy.getFaces();
-        name = copy.getName();
-        smoothShading = copy.getSmoothShading();
-        material = copy.getMaterial();
-        VAOInit = false;
-    }
-    return (*this);
 }
 
-Object::~Object()
+/*
+    the work done on the CPU before the upload, it touches nothing but the object
+    so the objects can be prepared on several threads
+*/
+void Object::prepare()
 {
-    if (VAOInit)
-    {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-        glDeleteBuffers(1, &EBO);
-    }
+    centerObject();
+    generateFacesColor();
 }
 
 /*
@@ -52,47 +29,45 @@ Object::~Object()
     glGen* : generate what is asked
     glBind* : bind the element to tell which one is used for each Buffer, 0 = reinitialized
     glBufferData : store informations into the corresponding buffer
-    glVertexAttribPointer : how the VBO is configured
+    glVertexAttribPointer : how the VBO is configured (set by the vertex layout)
     if a VBO is bind after a VAO, it's stored in the VAO
+    the object must be prepared before
 
 */
 void Object::initVAO()
 {
-    centerObject();
-    generateFacesColor();
+    const LoadStats::Stage stage(UPLOAD_STAGE);
 
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
+    VAO = VertexArrayHandle::create();
+    VBO = BufferHandle::create();
+    EBO = BufferHandle::create();
 
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBindVertexArray(VAO.get());
+    glBindBuffer(GL_ARRAY_BUFFER, VBO.get());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO.get());
 
     std::unique_ptr<float[]> verticesArray = getCombinedVerticesIntoArray();
     std::unique_ptr<unsigned int[]> facesArray = getFacesIntoArray();
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * combinedVertices.size() * 7, &verticesArray[0], GL_STATIC_DRAW);
+    const size_t verticesSize = sizeof(float) * combinedVertices.size() * ObjectVertexLayout::size;
+    glBufferData(GL_ARRAY_BUFFER, verticesSize, &verticesArray[0], GL_STATIC_DRAW);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * faces.size() * 3, &facesArray[0], GL_STATIC_DRAW);
+    LoadStats::add(BYTES_UPLOADED, verticesSize + sizeof(unsigned int) * faces.size() * 3);
 
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void *)(4 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    ObjectVertexLayout::setAttributes();
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    VAOInit = true;
 }
 
 bool Object::isVAOInit() const
 {
-    return (VAOInit);
+    return (VAO.get() != 0);
 }
 unsigned int Object::getVAO() const
 {
-    return (VAO);
+    return (VAO.get());
 }
 
 std::ostream &operator<<(std::ostream &os, const Object &instance)
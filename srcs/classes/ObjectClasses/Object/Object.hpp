@@ -1,25 +1,28 @@
 #pragma once
 
+#include "../../GLHandle/GLHandle.hpp"
 #include "../ObjectData/ObjectData.hpp"
 #include <iostream>
 
 // possibility to create a sub class named "OpenGLObject" containing VAO
+// an object owns its buffers, it can be moved but not copied
 class Object : public ObjectData
 {
   private:
     Object() = delete;
+    Object(const Object &copy) = delete;
+    Object &operator=(const Object &copy) = delete;
 
-    bool VAOInit;
-    unsigned int VAO;
-    unsigned int VBO;
-    unsigned int EBO;
+    VertexArrayHandle VAO;
+    BufferHandle VBO;
+    BufferHandle EBO;
 
   public:
-    Object(const ObjectData &data);
-    Object(const Object &copy);
-    Object &operator=(const Object &copy);
-    ~Object();
+    Object(ObjectData &&data);
+    Object(Object &&move) = default;
+    Object &operator=(Object &&move) = default;
 
+    void prepare();
     void initVAO();
     bool isVAOInit() const;
     unsigned int getVAO() const;
@@ -1,6 +1,9 @@
 #include "ObjectData.hpp"
+#include "../../LoadStats/LoadStats.hpp"
 #include <algorithm>
+#include <array>
 #include <ctime>
+#include <random>
 ObjectData::ObjectData()
 {
     reset();
@@ -38,18 +41,21 @@ std::vector<std::vector<float>> ObjectData::getCombinedVertices() const
 
 std::unique_ptr<float[]> ObjectData::getCombinedVerticesIntoArray() const
 {
-    size_t j;
-    std::unique_ptr<float[]> array;
+    return (ObjectVertexLayout::pack(combinedVertices));
+}
 
-    j = 0;
-    array = std::make_unique<float[]>(combinedVertices.size() * 7);
-    for (size_t i = 0; i < combinedVertices.size(); i++)
-    {
-        for (int k = 0; k < 7; k++)
-            array[j + k] = combinedVertices[i][k];
-        j += 7;
-    }
-    return (array);
+/*
+    the accessors of a single element don't copy the whole vector,
+    the parser reads the data of the object being built with them
+*/
+const Vertex &ObjectData::getVertex(size_t index) const
+{
+    return (vertices[index]);
+}
+
+size_t ObjectData::getNbVertices() const
+{
+    return (vertices.size());
 }
 
 std::unique_ptr<unsigned int[]> ObjectData::getFacesIntoArray() const
@@ -142,12 +148,15 @@ void ObjectData::addFace(const Face &face)
 
 void ObjectData::generateFacesColor()
 {
-    srand(time(NULL));
+    const LoadStats::Stage stage(GENERATE_COLORS_STAGE);
+
+    // rand shares its state between the threads, each object has its own generator
+    std::minstd_rand random(time(NULL));
 
     std::vector<Face> newFaces;
     for (size_t i = 0; i < faces.size(); i++)
     {
-        float randomColor = static_cast<float>(rand() % 10000) / 10000;
+        float randomColor = static_cast<float>(random() % 10000) / 10000;
         Face newFace;
 
         for (int j = 0; j < 3; j++)
@@ -157,21 +166,28 @@ void ObjectData::generateFacesColor()
     faces = newFaces;
 }
 
+/*
+    the colored corner is built on the stack, it is copied to the heap only if no combined vertex is the same
+*/
 int ObjectData::CombineVertexWithColor(size_t vertexIndex, float color)
 {
-    Vertex combinedVertex;
+    std::array<float, 7> combinedVertex;
 
     for (size_t j = 0; j < 4; j++)
-        combinedVertex.push_back((vertices[vertexIndex][j]));
+        combinedVertex[j] = vertices[vertexIndex][j];
     for (size_t j = 0; j < 3; j++)
-        combinedVertex.push_back(color);
+        combinedVertex[4 + j] = color;
 
-    auto it = std::find(combinedVertices.begin(), combinedVertices.end(), combinedVertex);
+    auto it = std::find_if(combinedVertices.begin(), combinedVertices.end(), [&combinedVertex](const Vertex &vertex) {
+        return (std::equal(combinedVertex.begin(), combinedVertex.end(), vertex.begin(), vertex.end()));
+    });
     if (it == combinedVertices.end())
     {
-        combinedVertices.push_back(combinedVertex);
+        combinedVertices.emplace_back(combinedVertex.begin(), combinedVertex.end());
+        LoadStats::add(UNIQUE_COLORED_VERTICES);
         return (combinedVertices.size() - 1);
     }
+    LoadStats::add(COLORED_DEDUP_HITS);
     return (std::distance(combinedVertices.begin(), it));
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../MaterialClasses/Material/Material.hpp"
+#include "../../VertexLayout/VertexLayout.hpp"
 #include <memory>
 #include <optional>
 #include <string>
@@ -9,12 +10,29 @@
 typedef std::vector<float> Vertex;
 typedef std::vector<int> Face;
 
+// the locations of the inputs of the vertex shader
+typedef enum attributeLocation
+{
+    POSITION_LOCATION,
+    COLOR_LOCATION
+} e_attributeLocation;
+
+inline constexpr char POSITION_INPUT[] = "aPos";
+inline constexpr char COLOR_INPUT[] = "aColor";
+
+// a combined vertex: position (4), color (3)
+typedef VertexLayout<VertexAttribute<POSITION_LOCATION, 4, POSITION_INPUT>,
+                     VertexAttribute<COLOR_LOCATION, 3, COLOR_INPUT>>
+    ObjectVertexLayout;
+
 class ObjectData
 {
   public:
     ObjectData();
     ObjectData(const ObjectData &copy);
     ObjectData &operator=(const ObjectData &copy);
+    ObjectData(ObjectData &&move) = default;
+    ObjectData &operator=(ObjectData &&move) = default;
     ~ObjectData();
 
     std::string getName() const;
@@ -22,6 +40,8 @@ class ObjectData
     std::unique_ptr<float[]> getVerticesIntoArray() const;
     std::vector<Vertex> getCombinedVertices() const;
     std::unique_ptr<float[]> getCombinedVerticesIntoArray() const;
+    const Vertex &getVertex(size_t index) const;
+    size_t getNbVertices() const;
     std::vector<Face> getFaces() const;
     std::unique_ptr<unsigned int[]> getFacesIntoArray() const;
     bool getSmoothShading() const;
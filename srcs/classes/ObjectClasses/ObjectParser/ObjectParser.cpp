@@ -1,82 +1,123 @@
 #include "ObjectParser.hpp"
-#include "../../MaterialClasses/MaterialParser/MaterialParser.hpp"
+#include "../../MaterialClasses/MaterialRegistry/MaterialRegistry.hpp"
+#include "../../LoadStats/LoadStats.hpp"
 #include "../../Utils/Utils.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 MapObjectParsingMethods ObjectParser::parsingMethods = {{"v", &ObjectParser::defineVertex},
                                                         {"f", &ObjectParser::defineFace},
                                                         {"s", &ObjectParser::defineSmoothShading},
                                                         {"mtllib", &ObjectParser::saveNewMTL},
                                                         {"usemtl", &ObjectParser::defineMTL}};
+thread_local std::pmr::memory_resource *ObjectParser::arena = std::pmr::get_default_resource();
 
-std::vector<Material> ObjectParser::materials;
-
+/*
+    a scene only knows the materials of its own files,
+    the ones of a scene parsed before are forgotten (their files stay parsed)
+*/
 std::vector<Object> ObjectParser::parseObjectFile(const std::string &path)
 {
+    MaterialRegistry::resetScene();
     if (!Utils::checkExtension(path, ".obj"))
         throw(Exception("PARSE_OBJECT_FILE", "INVALID_EXTENSION", path, 0));
 
     ObjectData objectData;
     std::vector<Object> objects;
-    std::stringstream fileStream = Utils::readFile(path);
-    fileStream = Utils::readFile(path);
+    std::ifstream file;
+    LoadStats::Stage readStage(READ_FILE_STAGE);
+    // the file is read a line at a time, its size doesn't matter
+    file.exceptions(std::ifstream::badbit);
+    file.open(path);
+    if (!file.is_open())
+        throw(Exception("PARSE_OBJECT_FILE", "OPEN_FAILED", path, 0));
+    readStage.end();
+    LoadStats::Stage parseStage(PARSE_STAGE);
+    char arenaBuffer[PARSER_ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource lineArena(arenaBuffer, sizeof(arenaBuffer));
     std::string line;
     unsigned int lineIndex = 1;
-    while (std::getline(fileStream, line))
+    arena = &lineArena;
+    while (std::getline(file, line))
     {
-        line = line.substr(0, line.find("#"));
-        std::string symbol = line.substr(0, line.find(" "));
-        auto it = parsingMethods.find(symbol);
-        if (symbol == "o")
+        try
         {
-            if (objectData.getFaces().size() > 0)
-            {
-                Object newObject(objectData);
-                objects.push_back(newObject);
-            }
-            objectData.reset();
-            defineName(objectData, line, lineIndex);
+            parseLine(objectData, objects, line, lineIndex);
+        }
+        catch (...)
+        {
+            arena = std::pmr::get_default_resource();
+            LoadStats::flush(TRIANGULATE_STAGE);
+            throw;
         }
-        else if (it != parsingMethods.end())
-            (it->second)(objectData, line, lineIndex);
-        else if (symbol.length() != 0)
-            throw(Exception("PARSE_OBJECT_FILE", "INVALID_SYMBOL", line, lineIndex));
+        // the temporary data of the line is freed at once, the next line reuses the buffer
+        lineArena.release();
         lineIndex++;
     }
+    arena = std::pmr::get_default_resource();
+    // the faces are measured in spans, the stages are recorded once per file
+    LoadStats::flush(TRIANGULATE_STAGE);
     if (objectData.getFaces().size() > 0)
+        objects.emplace_back(std::move(objectData));
+    parseStage.end();
+    MaterialRegistry::waitAll();
+    return (objects);
+}
+
+/*
+    the temporary data of a line is allocated from the arena,
+    only what is kept in the object data uses the heap
+*/
+void ObjectParser::parseLine(ObjectData &objectData, std::vector<Object> &objects, std::string &line,
+                             unsigned int lineIndex)
+{
+    const size_t comment = line.find('#');
+    if (comment != std::string::npos)
+        line.erase(comment);
+    const std::string_view symbol = std::string_view(line).substr(0, Utils::findSeparator(line, 0));
+    LoadStats::countSymbol(symbol);
+    auto it = parsingMethods.find(symbol);
+    if (symbol == "o")
     {
-        Object newObject(objectData);
-        objects.push_back(newObject);
+        // the data is moved into the object, then reset for the next one
+        if (objectData.getFaces().size() > 0)
+            objects.emplace_back(std::move(objectData));
+        objectData.reset();
+        defineName(objectData, line, lineIndex);
     }
-    return (objects);
+    else if (it != parsingMethods.end())
+        (it->second)(objectData, line, lineIndex);
+    else if (symbol.length() != 0)
+        throw(Exception("PARSE_OBJECT_FILE", "INVALID_SYMBOL", line, lineIndex));
 }
 
 void ObjectParser::defineName(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line);
     if (words.size() != 2)
         throw(Exception("DEFINE_NAME", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
-    objectData.setName(words[1]);
+    objectData.setName(std::string(words[1]));
 }
 
 void ObjectParser::defineVertex(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
     Vertex vertex;
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line);
     if (words.size() < 4 || words.size() > 5)
         throw(Exception("DEFINE_VERTEX", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
     for (size_t i = 1; i < words.size(); i++)
     {
-        if (!Utils::isFloat(words[i]))
+        float value;
+        if (!Utils::parseFloat(words[i], value))
             throw(Exception("DEFINE_VERTEX", "INVALID_ARGUMENT", line, lineIndex));
-        vertex.push_back(std::stof(words[i]));
+        vertex.push_back(value);
     }
     if (words.size() == 4)
         vertex.push_back(1.0f);
@@ -93,19 +134,17 @@ void ObjectParser::defineVertex(ObjectData &objectData, const std::string &line,
 void ObjectParser::defineFace(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
     Face face;
-    int vertexID;
-    const int nbVertices = static_cast<int>(objectData.getVertices().size());
-    std::vector<std::string> words;
+    long vertexID;
+    const long nbVertices = static_cast<long>(objectData.getNbVertices());
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line);
     if (words.size() < 4)
         throw(Exception("DEFINE_FACE", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
     for (size_t i = 1; i < words.size(); i++)
     {
-        if (!Utils::isInt(words[i]))
+        if (!Utils::parseInt(words[i], vertexID))
             throw(Exception("DEFINE_FACE", "INVALID_ARGUMENT", line, lineIndex));
-        vertexID = std::stoi(words[i]);
         if (vertexID < -nbVertices || vertexID > nbVertices || vertexID == 0)
             throw(Exception("DEFINE_FACE", "INVALID_VERTEX_INDEX", line, lineIndex));
 
@@ -118,18 +157,20 @@ void ObjectParser::defineFace(ObjectData &objectData, const std::string &line, u
 
 void ObjectParser::triangulate(ObjectData &objectData, Face &face)
 {
+    const LoadStats::Span span(TRIANGULATE_STAGE);
+
     while (face.size() > 3)
     {
         for (size_t i = 1; i < face.size() - 1; i++)
         {
-            Vertex a = objectData.getVertices()[face[i]];
-            Vertex b = objectData.getVertices()[face[i - 1]];
-            Vertex c = objectData.getVertices()[face[i + 1]];
+            const Vertex &a = objectData.getVertex(face[i]);
+            const Vertex &b = objectData.getVertex(face[i - 1]);
+            const Vertex &c = objectData.getVertex(face[i + 1]);
 
             bool isEar = true;
-            for (size_t j = 0; j < objectData.getVertices().size(); j++)
+            for (size_t j = 0; j < objectData.getNbVertices(); j++)
             {
-                Vertex p = objectData.getVertices()[j];
+                const Vertex &p = objectData.getVertex(j);
                 if (p == a || p == b || p == c)
                     continue;
                 if (insideTriangle(p, a, b, c))
@@ -154,11 +195,14 @@ void ObjectParser::triangulate(ObjectData &objectData, Face &face)
                     }
                 }
                 objectData.addFace(newFace);
+                LoadStats::add(EARS_CLIPPED);
+                LoadStats::add(TRIANGLES);
                 break;
             }
         }
     }
     objectData.addFace(face);
+    LoadStats::add(TRIANGLES);
 }
 
 bool ObjectParser::insideTriangle(const Vertex &p, const Vertex &a, const Vertex &b, const Vertex &c)
@@ -176,15 +220,8 @@ bool ObjectParser::insideTriangle(const Vertex &p, const Vertex &a, const Vertex
 
 float ObjectParser::triangleArea(const Vertex &a, const Vertex &b, const Vertex &c)
 {
-    Vertex AB;
-    AB.push_back(b[0] - a[0]);
-    AB.push_back(b[1] - a[1]);
-    AB.push_back(b[2] - a[2]);
-
-    Vertex AC;
-    AC.push_back(c[0] - a[0]);
-    AC.push_back(c[1] - a[1]);
-    AC.push_back(c[2] - a[2]);
+    const std::array<float, 3> AB = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const std::array<float, 3> AC = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
 
     float dotProduct = AB[0] * AC[0] + AB[1] * AC[1] + AB[2] * AC[2];
     float magnitudeAB = sqrt(pow(AB[0], 2) + pow(AB[1], 2) + pow(AB[2], 2));
@@ -197,9 +234,8 @@ float ObjectParser::triangleArea(const Vertex &a, const Vertex &b, const Vertex
 
 void ObjectParser::defineSmoothShading(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line);
     if (words.size() != 2)
         throw(Exception("DEFINE_SMOOTH_SHADING", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
@@ -211,36 +247,32 @@ void ObjectParser::defineSmoothShading(ObjectData &objectData, const std::string
         throw(Exception("DEFINE_SMOOTH_SHADING", "INVALID_ARGUMENT", line, lineIndex));
 }
 
+/*
+    the material file is parsed in the background,
+    it is only waited for when one of its materials is used
+*/
 void ObjectParser::saveNewMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
     (void)objectData;
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line);
     if (words.size() != 2)
         throw(Exception("CREATE_NEW_MTL", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    std::vector<Material> newMaterials = MaterialParser::parseMaterialFile(words[1]);
-    materials.insert(materials.end(), newMaterials.begin(), newMaterials.end());
+    MaterialRegistry::prefetch(std::string(words[1]));
 }
 
 void ObjectParser::defineMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line);
     if (words.size() != 2)
         throw(Exception("DEFINE_MTL", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    for (size_t i = 0; i < materials.size(); i++)
-    {
-        if (materials[i].getName() == words[1])
-        {
-            objectData.setMaterial(materials[i]);
-            return;
-        }
-    }
-    throw(Exception("DEFINE_MTL", "INVALID_ARGUMENT", line, lineIndex));
+    const std::string name(words[1]);
+    if (!MaterialRegistry::hasMaterial(name))
+        throw(Exception("DEFINE_MTL", "INVALID_ARGUMENT", line, lineIndex));
+    objectData.setMaterial(MaterialRegistry::getMaterial(name));
 }
 
 ObjectParser::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
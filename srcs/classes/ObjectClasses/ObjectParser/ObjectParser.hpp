@@ -4,9 +4,13 @@
 #include "../Object/Object.hpp"
 #include "../ObjectData/ObjectData.hpp"
 #include <map>
+#include <memory_resource>
 #include <vector>
 
-typedef std::map<std::string, void (*)(ObjectData &, const std::string &, unsigned int)> MapObjectParsingMethods;
+#define PARSER_ARENA_SIZE 16384 // the temporary data of a line usually fits, a longer line spills to the heap
+
+typedef std::map<std::string, void (*)(ObjectData &, const std::string &, unsigned int), std::less<>>
+    MapObjectParsingMethods;
 
 class ObjectParser
 {
@@ -16,6 +20,8 @@ class ObjectParser
     static void triangulate(ObjectData &objectData, Face &face);
     static size_t CombineVertices(ObjectData &objectData, size_t vertexIndex);
 
+    static void parseLine(ObjectData &objectData, std::vector<Object> &objects, std::string &line,
+                          unsigned int lineIndex);
     static void defineName(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
 
     static void defineVertex(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
@@ -24,8 +30,7 @@ class ObjectParser
     static void saveNewMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static void defineMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static MapObjectParsingMethods parsingMethods;
-
-    static std::vector<Material> materials;
+    static thread_local std::pmr::memory_resource *arena; // per thread, files can be parsed at the same time
 
     class Exception : public std::exception
     {
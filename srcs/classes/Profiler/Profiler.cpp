@@ -0,0 +1,208 @@
+#include "Profiler.hpp"
+#include "../../../libs/glad/glad.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+bool Profiler::enabled = false;
+double Profiler::origin = Profiler::getTime();
+unsigned int Profiler::frame = 0;
+std::vector<s_profileEvent> Profiler::events;
+size_t Profiler::nextEvent = 0;
+size_t Profiler::nbEvents = 0;
+std::vector<unsigned int> Profiler::freeQueries;
+std::deque<s_gpuQuery> Profiler::pendingQueries;
+bool Profiler::gpuScopeActive = false;
+
+Profiler::Scope::Scope(const char *name)
+{
+    this->name = name;
+    start = (enabled) ? getTime() : 0;
+}
+
+Profiler::Scope::~Scope()
+{
+    if (enabled && start != 0)
+        record(name, CPU_CLOCK, start, getTime() - start);
+}
+
+/*
+    GL_TIME_ELAPSED queries can't overlap, a scope inside another one measures nothing
+*/
+Profiler::GPUScope::GPUScope(const char *name)
+{
+    active = enabled && !gpuScopeActive;
+    if (!active)
+        return;
+
+    unsigned int query;
+    if (freeQueries.empty())
+        glGenQueries(1, &query);
+    else
+    {
+        query = freeQueries.back();
+        freeQueries.pop_back();
+    }
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    pendingQueries.push_back({query, name, frame, getTime()});
+    gpuScopeActive = true;
+}
+
+Profiler::GPUScope::~GPUScope()
+{
+    if (!active)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    gpuScopeActive = false;
+}
+
+bool Profiler::isEnabled()
+{
+    return (enabled);
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    Profiler::enabled = enabled;
+}
+
+/*
+    steady_clock in seconds, a double keeps a sub-microsecond precision for months
+*/
+double Profiler::getTime()
+{
+    return (std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+unsigned int Profiler::getFrame()
+{
+    return (frame);
+}
+
+void Profiler::nextFrame()
+{
+    frame++;
+    collectQueries();
+}
+
+/*
+    the queries finish in order, the first one not available stops the collection until the next frame
+*/
+void Profiler::collectQueries()
+{
+    while (!pendingQueries.empty())
+    {
+        const s_gpuQuery &pending = pendingQueries.front();
+        GLint available = 0;
+        GLuint64 elapsed = 0;
+
+        glGetQueryObjectiv(pending.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+        glGetQueryObjectui64v(pending.query, GL_QUERY_RESULT, &elapsed);
+        if (enabled)
+            push({pending.name, GPU_CLOCK, pending.frame, pending.start - origin, elapsed / 1e9});
+        freeQueries.push_back(pending.query);
+        pendingQueries.pop_front();
+    }
+}
+
+void Profiler::record(const char *name, e_profileClock clock, double start, double duration)
+{
+    push({name, clock, frame, start - origin, duration});
+}
+
+void Profiler::push(const s_profileEvent &event)
+{
+    if (events.size() != PROFILER_CAPACITY)
+        events.resize(PROFILER_CAPACITY);
+    events[nextEvent] = event;
+    nextEvent = (nextEvent + 1) % PROFILER_CAPACITY;
+    if (nbEvents < PROFILER_CAPACITY)
+        nbEvents++;
+}
+
+/*
+    the events from the oldest to the newest
+*/
+std::vector<s_profileEvent> Profiler::getEvents()
+{
+    std::vector<s_profileEvent> orderedEvents;
+    const size_t first = (nextEvent + PROFILER_CAPACITY - nbEvents) % PROFILER_CAPACITY;
+
+    orderedEvents.reserve(nbEvents);
+    for (size_t i = 0; i < nbEvents; i++)
+        orderedEvents.push_back(events[(first + i) % PROFILER_CAPACITY]);
+    return (orderedEvents);
+}
+
+void Profiler::clear()
+{
+    nextEvent = 0;
+    nbEvents = 0;
+    frame = 0;
+}
+
+/*
+    needs the OpenGL context, before the window is destroyed
+*/
+void Profiler::releaseQueries()
+{
+    for (size_t i = 0; i < pendingQueries.size(); i++)
+        freeQueries.push_back(pendingQueries[i].query);
+    pendingQueries.clear();
+    if (!freeQueries.empty())
+        glDeleteQueries(freeQueries.size(), freeQueries.data());
+    freeQueries.clear();
+    gpuScopeActive = false;
+}
+
+/*
+    "X" events of the trace event format, in microseconds.
+    the CPU stages are on the thread 0, the GPU ones on the thread 1
+*/
+std::string Profiler::toChromeTrace()
+{
+    const std::vector<s_profileEvent> orderedEvents = getEvents();
+    std::ostringstream trace;
+
+    trace.precision(3);
+    trace << std::fixed << "{\"traceEvents\":[";
+    trace << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"CPU\"}},";
+    trace << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"GPU\"}}";
+    for (size_t i = 0; i < orderedEvents.size(); i++)
+    {
+        trace << ",\n{\"name\":\"" << orderedEvents[i].name << "\",\"cat\":\""
+              << ((orderedEvents[i].clock == CPU_CLOCK) ? "cpu" : "gpu") << "\",\"ph\":\"X\",\"ts\":"
+              << orderedEvents[i].start * 1e6 << ",\"dur\":" << orderedEvents[i].duration * 1e6
+              << ",\"pid\":1,\"tid\":" << orderedEvents[i].clock << ",\"args\":{\"frame\":" << orderedEvents[i].frame
+              << "}}";
+    }
+    trace << "\n]}\n";
+    return (trace.str());
+}
+
+void Profiler::dumpChromeTrace(const std::string &path)
+{
+    std::ofstream file(path);
+
+    if (!file.is_open())
+        throw(Exception("DUMP_CHROME_TRACE", "OPEN_FAILED", path + ": " + strerror(errno)));
+    file << toChromeTrace();
+    if (!file.good())
+        throw(Exception("DUMP_CHROME_TRACE", "WRITE_FAILED", path));
+}
+
+Profiler::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                               const std::string &path)
+{
+    this->errorMessage = "PROFILER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + path + "\n|";
+}
+
+const char *Profiler::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
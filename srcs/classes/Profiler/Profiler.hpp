@@ -0,0 +1,112 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#define PROFILER_CAPACITY 65536 // the oldest events are overwritten
+#define PROFILER_OUTPUT "scop_trace.json"
+
+typedef enum profileClock
+{
+    CPU_CLOCK,
+    GPU_CLOCK
+} e_profileClock;
+
+typedef struct profileEvent
+{
+    const char *name; // a string literal, never freed
+    e_profileClock clock;
+    unsigned int frame;
+    double start;    // seconds since the start of the program
+    double duration; // seconds
+} s_profileEvent;
+
+typedef struct gpuQuery
+{
+    unsigned int query;
+    const char *name;
+    unsigned int frame;
+    double start;
+} s_gpuQuery;
+
+/**
+ * records how long each stage of a frame takes, on the CPU and on the GPU.
+ * the events are stored in a ring buffer, so the last PROFILER_CAPACITY events are kept,
+ * and can be saved as a chrome trace (chrome://tracing or https://ui.perfetto.dev).
+ * a GPU timer doesn't stall the pipeline: its result is read a few frames later
+ */
+class Profiler
+{
+  private:
+    Profiler() = delete;
+
+    static bool enabled;
+    static double origin;
+    static unsigned int frame;
+    static std::vector<s_profileEvent> events;
+    static size_t nextEvent;
+    static size_t nbEvents;
+    static std::vector<unsigned int> freeQueries;
+    static std::deque<s_gpuQuery> pendingQueries;
+    static bool gpuScopeActive;
+
+    static void collectQueries();
+    static void push(const s_profileEvent &event);
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &path);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    // measures the CPU time until the end of the scope
+    class Scope
+    {
+      private:
+        Scope() = delete;
+        Scope(const Scope &copy) = delete;
+        Scope &operator=(const Scope &copy) = delete;
+
+        const char *name;
+        double start;
+
+      public:
+        Scope(const char *name);
+        ~Scope();
+    };
+
+    // measures the GPU time of the commands sent until the end of the scope, the scopes can't be nested
+    class GPUScope
+    {
+      private:
+        GPUScope() = delete;
+        GPUScope(const GPUScope &copy) = delete;
+        GPUScope &operator=(const GPUScope &copy) = delete;
+
+        bool active;
+
+      public:
+        GPUScope(const char *name);
+        ~GPUScope();
+    };
+
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+    static double getTime();
+    static unsigned int getFrame();
+
+    static void nextFrame();
+    static void record(const char *name, e_profileClock clock, double start, double duration);
+    static std::vector<s_profileEvent> getEvents();
+    static void clear();
+    static void releaseQueries();
+
+    static std::string toChromeTrace();
+    static void dumpChromeTrace(const std::string &path);
+};
\ No newline at end of file
@@ -1,40 +1,38 @@
 #pragma once
 
-#include <memory>
+#include "../GLHandle/GLHandle.hpp"
+#include "../Image/Image.hpp"
+#include "../TextureContainer/TextureContainer.hpp"
 #include <string>
 
+// not part of the core profile, available with GL_EXT_texture_compression_s3tc
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+
+// a texture owns its OpenGL name, it can be moved but not copied
 class Texture
 {
   private:
     Texture() = delete;
-    void checkHeader(const std::string &line, unsigned int nbLine);
-    void loadImage(const std::string &texturePath);
+    Texture(const Texture &copy) = delete;
+    Texture &operator=(const Texture &copy) = delete;
+    void uploadImage(const Image &image);
+    void uploadContainer(const TextureContainer &container);
+    static bool isCompressionSupported();
 
-    unsigned int ID;
+    TextureHandle texture;
     int width;
     int height;
-    unsigned int valueMax;
-    std::unique_ptr<unsigned char[]> data;
 
     static bool textureInit;
-    class Exception : public std::exception
-    {
-      public:
-        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &line,
-                  unsigned int lineIndex);
-        const char *what(void) const throw();
-
-      private:
-        std::string errorMessage;
-    };
 
   public:
     Texture(const std::string &texturePath);
-    Texture(const Texture &copy);
-    Texture &operator=(const Texture &copy);
-    ~Texture();
+    Texture(Texture &&move) = default;
+    Texture &operator=(Texture &&move) = default;
 
     static void initTexParameter();
 
     unsigned int getID() const;
-};
\ No newline at end of file
+    int getWidth() const;
+    int getHeight() const;
+};
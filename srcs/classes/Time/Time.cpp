@@ -1,8 +1,9 @@
 #include "Time.hpp"
 
-float Time::currentFrame = glfwGetTime();
-float Time::lastFrame = currentFrame;
-float Time::deltaTime = 0;
+// glfwGetTime can't be used before glfwInit, the time starts at 0 with GLFW
+double Time::currentFrame = 0;
+double Time::lastFrame = 0;
+double Time::deltaTime = 0;
 
 void Time::updateTime()
 {
@@ -11,12 +12,22 @@ void Time::updateTime()
     lastFrame = currentFrame;
 }
 
-float Time::getDeltaTime()
+/*
+    the next frame starts from now, the time spent waiting isn't counted
+*/
+void Time::resetTime()
+{
+    currentFrame = glfwGetTime();
+    lastFrame = currentFrame;
+    deltaTime = 0;
+}
+
+double Time::getDeltaTime()
 {
     return (deltaTime);
 }
 
-float Time::getTime()
+double Time::getTime()
 {
     return (currentFrame);
 }
\ No newline at end of file
@@ -5,12 +5,13 @@
 class Time
 {
   private:
-    static float currentFrame;
-    static float lastFrame;
-    static float deltaTime;
+    static double currentFrame;
+    static double lastFrame;
+    static double deltaTime;
 
   public:
     static void updateTime();
-    static float getDeltaTime();
-    static float getTime();
+    static void resetTime();
+    static double getDeltaTime();
+    static double getTime();
 };
\ No newline at end of file
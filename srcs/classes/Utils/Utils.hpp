@@ -1,16 +1,27 @@
 #pragma once
 
+#include <cstdint>
+#include <memory_resource>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 class Utils
 {
   public:
-    static bool isInt(const std::string &word);
-    static bool isFloat(const std::string &words);
-    static std::vector<std::string> splitLine(std::string line);
+    static bool parseInt(std::string_view word, long &value);
+    static bool parseFloat(std::string_view word, float &value);
+    static size_t findSeparator(std::string_view text, size_t index, char separator = ' ');
+    static size_t skipSeparators(std::string_view text, size_t index, char separator = ' ');
+    static std::pmr::vector<std::string_view> splitLine(
+        std::string_view line, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    static std::pmr::vector<std::string_view> splitLine(
+        std::string_view line, char separator, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
     static float DegToRad(float angle);
     static std::stringstream readFile(const std::string &path);
-    static bool checkExtension(const std::string &path, const std::string &extension);
+    static bool checkExtension(std::string_view path, std::string_view extension);
+
+  private:
+    static uint32_t separatorMask(const char *data, size_t size, char separator);
 };
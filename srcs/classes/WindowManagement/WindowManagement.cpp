@@ -1,27 +1,34 @@
 #include "WindowManagement.hpp"
+#include "../JobSystem/JobSystem.hpp"
+#include "../Profiler/Profiler.hpp"
 #include "../Shader/Shader.hpp"
 #include "../Texture/Texture.hpp"
 #include "../Time/Time.hpp"
 #include "../Utils/Utils.hpp"
 #include <GLFW/glfw3.h>
 #include <cmath>
+#include <iostream>
+#include <utility>
 
-WindowManagement::WindowManagement(const std::vector<Object> &objects)
+WindowManagement::WindowManagement(std::vector<Object> &&objects)
 {
-    start(objects);
+    start(std::move(objects));
     updateLoop();
 }
 
 WindowManagement::~WindowManagement()
 {
+    if (Profiler::isEnabled())
+        saveProfile();
+    Profiler::releaseQueries();
     glfwTerminate();
 }
 
-void WindowManagement::start(const std::vector<Object> &objects)
+void WindowManagement::start(std::vector<Object> &&objects)
 {
     initGLFW();
     initOpenGL();
-    initData(objects);
+    initData(std::move(objects));
 }
 
 void WindowManagement::initGLFW()
@@ -31,7 +38,7 @@ void WindowManagement::initGLFW()
 
     initWindow();
 
-    glfwSetWindowUserPointer(window, &camera);
+    glfwSetWindowUserPointer(window, static_cast<s_data *>(this));
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetCursorPosCallback(window, mouse_callback);
     glfwSetScrollCallback(window, scroll_callback);
@@ -59,13 +66,27 @@ void WindowManagement::initOpenGL()
     glEnable(GL_DEPTH_TEST);
 }
 
-void WindowManagement::initData(const std::vector<Object> &objects)
+void WindowManagement::initData(std::vector<Object> &&objects)
 {
-    this->objects = objects;
+    this->objects = std::move(objects);
+    // the objects are prepared in parallel, OpenGL is only called from this thread
+    JobSystem::getShared().parallelFor(this->objects.size(), 1, [this](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            this->objects[i].prepare();
+    });
     for (size_t i = 0; i < this->objects.size(); i++)
         this->objects[i].initVAO();
     camera = Camera();
+    int width;
+    int height;
+    glfwGetFramebufferSize(window, &width, &height);
+    camera.setViewport(width, height);
+    framePacer = FramePacer(DEFAULT_FRAME_MODE, DEFAULT_FIXED_FPS, true);
+    glfwSwapInterval(framePacer.isVsync());
+    updateWindowTitle();
+    dirtyFlags = ALL_DIRTY;
     displayColor = true;
+    inputHeld = false;
     mixedValue = 0;
     for (size_t i = 0; i < 3; i++)
     {
@@ -87,22 +108,48 @@ void WindowManagement::initData(const std::vector<Object> &objects)
 void WindowManagement::updateLoop()
 {
     const Texture texture("srcs/textures/myLittlePony.ppm");
-    const Shader shader("srcs/shaders/shader.vs", "srcs/shaders/shader.fs");
+    const Shader shader("srcs/shaders/shader.vs", "srcs/shaders/shader.fs",
+                        ObjectVertexLayout::getShaderInputs());
     while (!glfwWindowShouldClose(window))
     {
+        waitEvents();
         Time::updateTime();
         processInput();
-        updateScene(texture, shader);
+        const bool rendered = dirtyFlags != 0 || !framePacer.isIdleMode();
+        if (rendered)
+            updateScene(texture, shader);
+        framePacer.waitNextFrame(rendered);
     }
 }
 
+/*
+    while nothing changes and no key is held the thread sleeps until an event arrives,
+    the time spent waiting doesn't count in the next frame
+*/
+void WindowManagement::waitEvents()
+{
+    if (!framePacer.canWaitEvents(dirtyFlags != 0, inputHeld))
+    {
+        glfwPollEvents();
+        return;
+    }
+    glfwWaitEventsTimeout(IDLE_TIMEOUT);
+    Time::resetTime();
+}
+
 void WindowManagement::processInput()
 {
+    const Profiler::Scope profile("processInput");
+
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
+    inputHeld = false;
     updateCameraPosition();
     updateSceneOrientation();
     updateDisplayMode();
+    updateFrameMode();
+    updateIdleMode();
+    updateProfilerMode();
 }
 
 bool WindowManagement::isKeyPressed(int key)
@@ -122,6 +169,11 @@ void WindowManagement::updateCameraPosition()
 
     int up = isKeyPressed(GLFW_KEY_SPACE) - isKeyPressed(GLFW_KEY_LEFT_SHIFT);
     camera.addToPosition(up * camera.getUpDirection() * speed);
+    if (front != 0 || right != 0 || up != 0)
+    {
+        dirtyFlags |= CAMERA_DIRTY;
+        inputHeld = true;
+    }
 }
 
 void WindowManagement::updateSceneOrientation()
@@ -129,6 +181,13 @@ void WindowManagement::updateSceneOrientation()
     inputRotation[X_AXIS] = isKeyPressed(GLFW_KEY_U) - isKeyPressed(GLFW_KEY_Y);
     inputRotation[Y_AXIS] = isKeyPressed(GLFW_KEY_J) - isKeyPressed(GLFW_KEY_H);
     inputRotation[Z_AXIS] = isKeyPressed(GLFW_KEY_M) - isKeyPressed(GLFW_KEY_N);
+    if (inputRotation[X_AXIS] == 0 && inputRotation[Y_AXIS] == 0 && inputRotation[Z_AXIS] == 0)
+        return;
+    sceneRotation[X_AXIS] += inputRotation[X_AXIS] * Time::getDeltaTime();
+    sceneRotation[Y_AXIS] += inputRotation[Y_AXIS] * Time::getDeltaTime();
+    sceneRotation[Z_AXIS] += inputRotation[Z_AXIS] * Time::getDeltaTime();
+    dirtyFlags |= ROTATION_DIRTY;
+    inputHeld = true;
 }
 
 void WindowManagement::updateDisplayMode()
@@ -151,6 +210,7 @@ void WindowManagement::updateWireframeMode()
                 glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
             else
                 glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            dirtyFlags |= DISPLAY_DIRTY;
         }
         keyEnable = false;
     }
@@ -165,36 +225,120 @@ void WindowManagement::updateTextureMode()
     if (isKeyPressed(GLFW_KEY_F2))
     {
         if (keyEnable == true)
+        {
             displayColor = !displayColor;
+            dirtyFlags |= BLEND_DIRTY;
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+void WindowManagement::updateFrameMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F3))
+    {
+        if (keyEnable == true)
+        {
+            framePacer.nextMode();
+            glfwSwapInterval(framePacer.isVsync());
+            updateWindowTitle();
+        }
         keyEnable = false;
     }
     else
         keyEnable = true;
 }
 
+void WindowManagement::updateIdleMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F4))
+    {
+        if (keyEnable == true)
+        {
+            framePacer.setIdleMode(!framePacer.isIdleMode());
+            updateWindowTitle();
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+/*
+    the profile is saved when the profiler is disabled
+*/
+void WindowManagement::updateProfilerMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F5))
+    {
+        if (keyEnable == true)
+        {
+            if (Profiler::isEnabled())
+                saveProfile();
+            else
+                Profiler::clear();
+            Profiler::setEnabled(!Profiler::isEnabled());
+            updateWindowTitle();
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+/*
+    a profile that can't be saved doesn't stop the program
+*/
+void WindowManagement::saveProfile()
+{
+    try
+    {
+        Profiler::dumpChromeTrace(PROFILER_OUTPUT);
+        std::cout << "profile saved in " << PROFILER_OUTPUT << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void WindowManagement::updateWindowTitle()
+{
+    std::string title = "Scop - " + framePacer.getModeName();
+
+    if (framePacer.isIdleMode())
+        title += " - idle";
+    if (Profiler::isEnabled())
+        title += " - profiling";
+    glfwSetWindowTitle(window, title.c_str());
+}
+
 void WindowManagement::updateScene(const Texture &texture, const Shader &shader)
 {
+    dirtyFlags = 0;
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    updateCameraView();
     updateTexture();
 
     for (size_t i = 0; i < objects.size(); i++)
         renderObject(objects[i], texture, shader);
 
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+    swapBuffers();
+    Profiler::nextFrame();
 }
 
-void WindowManagement::updateCameraView()
+void WindowManagement::swapBuffers()
 {
-    Matrix direction(3, 1);
-    float directionValues[] = {cosf(Utils::DegToRad(camera.getYaw())) * cosf(Utils::DegToRad(camera.getPitch())),
-                               sinf(Utils::DegToRad(camera.getPitch())),
-                               sinf(Utils::DegToRad(camera.getYaw())) * cosf(Utils::DegToRad(camera.getPitch()))};
-    direction.setData(directionValues, 3);
-    camera.setFrontDirection(Matrix::normalize(direction));
-    camera.setRightDirection(
-        Matrix::normalize(Matrix::crossProduct(camera.getFrontDirection(), camera.getUpDirection())));
+    const Profiler::Scope profile("glfwSwapBuffers");
+
+    glfwSwapBuffers(window);
 }
 
 void WindowManagement::updateTexture()
@@ -202,12 +346,14 @@ void WindowManagement::updateTexture()
     if (displayColor == true && mixedValue > 0)
     {
         mixedValue -= Time::getDeltaTime();
+        dirtyFlags |= BLEND_DIRTY;
         if (mixedValue < 0)
             mixedValue = 0;
     }
     else if (displayColor == false && mixedValue < 1)
     {
         mixedValue += Time::getDeltaTime();
+        dirtyFlags |= BLEND_DIRTY;
         if (mixedValue > 1)
             mixedValue = 1;
     }
@@ -219,6 +365,9 @@ void WindowManagement::updateTexture()
 */
 void WindowManagement::renderObject(const Object &object, const Texture &texture, const Shader &shader)
 {
+    const Profiler::Scope profile("renderObject");
+    const Profiler::GPUScope gpuProfile("renderObject");
+
     updateShader(texture, shader);
     glBindVertexArray(object.getVAO());
     glDrawElements(GL_TRIANGLES, object.getFaces().size() * 3, GL_UNSIGNED_INT, 0);
@@ -226,15 +375,14 @@ void WindowManagement::renderObject(const Object &object, const Texture &texture
 
 void WindowManagement::updateShader(const Texture &texture, const Shader &shader)
 {
+    const Profiler::Scope profile("updateShader");
+
     shader.use();
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, texture.getID());
     shader.setInt("texture1", 0);
     shader.setFloat("aMixValue", mixedValue);
 
-    sceneRotation[X_AXIS] += inputRotation[X_AXIS] * Time::getDeltaTime();
-    sceneRotation[Y_AXIS] += inputRotation[Y_AXIS] * Time::getDeltaTime();
-    sceneRotation[Z_AXIS] += inputRotation[Z_AXIS] * Time::getDeltaTime();
     Matrix rotation(4, 4);
     rotation.uniform(1);
     rotation = Matrix::rotate(rotation, sceneRotation[X_AXIS], axis[X_AXIS]) *
@@ -242,12 +390,9 @@ void WindowManagement::updateShader(const Texture &texture, const Shader &shader
                Matrix::rotate(rotation, sceneRotation[Z_AXIS], axis[Z_AXIS]);
     shader.setMat4("rotation", rotation);
 
-    Matrix projection = Matrix::perspective(camera.getFov(), (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT, 0.1f, 100.0f);
-    shader.setMat4("projection", projection);
-
-    Matrix view = Matrix::lookAt(camera.getPosition(), camera.getPosition() + camera.getFrontDirection(),
-                                 camera.getUpDirection());
-    shader.setMat4("view", view);
+    // only computed again when the camera moved or the window was resized
+    shader.setMat4("projection", camera.getProjection());
+    shader.setMat4("view", camera.getView());
 }
 
 /**
@@ -256,8 +401,10 @@ void WindowManagement::updateShader(const Texture &texture, const Shader &shader
  */
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
-    (void)window;
+    s_data *data = reinterpret_cast<s_data *>(glfwGetWindowUserPointer(window));
     glViewport(0, 0, width, height);
+    data->camera.setViewport(width, height);
+    data->dirtyFlags |= DISPLAY_DIRTY | CAMERA_DIRTY;
 }
 
 void mouse_callback(GLFWwindow *window, double xPos, double yPos)
@@ -269,7 +416,9 @@ void mouse_callback(GLFWwindow *window, double xPos, double yPos)
 
     float xOffset;
     float yOffset;
-    Camera *camera = reinterpret_cast<Camera *>(glfwGetWindowUserPointer(window));
+    s_data *data = reinterpret_cast<s_data *>(glfwGetWindowUserPointer(window));
+    Camera *camera = &data->camera;
+    data->dirtyFlags |= CAMERA_DIRTY;
     xOffset = (xPos - lastX) * sensitivity;
     yOffset = (lastY - yPos) * sensitivity;
     lastX = xPos;
@@ -286,7 +435,9 @@ void scroll_callback(GLFWwindow *window, double xOffset, double yOffset)
 {
     (void)xOffset;
 
-    Camera *camera = reinterpret_cast<Camera *>(glfwGetWindowUserPointer(window));
+    s_data *data = reinterpret_cast<s_data *>(glfwGetWindowUserPointer(window));
+    Camera *camera = &data->camera;
+    data->dirtyFlags |= CAMERA_DIRTY;
     camera->addToFov((float)-yOffset);
     if (camera->getFov() < 1.0f)
         camera->setFov(1.0f);
@@ -4,6 +4,7 @@
 #include <GLFW/glfw3.h>
 
 #include "../Camera/Camera.hpp"
+#include "../FramePacer/FramePacer.hpp"
 #include "../ObjectClasses/Object/Object.hpp"
 #include "../Shader/Shader.hpp"
 #include "../Texture/Texture.hpp"
@@ -11,6 +12,8 @@
 
 #define WINDOW_WIDTH 800
 #define WINDOW_HEIGHT 600
+#define DEFAULT_FRAME_MODE VSYNC_MODE
+#define IDLE_TIMEOUT 1.0 // seconds waited for an event before checking the window again
 
 typedef enum axis
 {
@@ -19,15 +22,28 @@ typedef enum axis
     Z_AXIS
 } e_axis;
 
+// what changed since the last rendered frame
+typedef enum dirtyFlag
+{
+    CAMERA_DIRTY = 1 << 0,
+    ROTATION_DIRTY = 1 << 1,
+    DISPLAY_DIRTY = 1 << 2,
+    BLEND_DIRTY = 1 << 3,
+    ALL_DIRTY = CAMERA_DIRTY | ROTATION_DIRTY | DISPLAY_DIRTY | BLEND_DIRTY
+} e_dirtyFlag;
+
 typedef struct data
 {
     std::vector<Object> objects;
     Camera camera;
+    FramePacer framePacer;
+    unsigned int dirtyFlags; // e_dirtyFlag
 
     bool displayColor;
     float mixedValue;
     float sceneRotation[3];
     float inputRotation[3];
+    bool inputHeld; // a movement or rotation key is held, the next frame can't wait for an event
     Matrix axis[3];
 } s_data;
 
@@ -40,29 +56,35 @@ class WindowManagement : public s_data
   private:
     GLFWwindow *window;
 
-    void start(const std::vector<Object> &objects);
+    void start(std::vector<Object> &&objects);
     void initGLFW();
     void initWindow();
     void initOpenGL();
-    void initData(const std::vector<Object> &objects);
+    void initData(std::vector<Object> &&objects);
 
     void updateLoop();
+    void waitEvents();
 
     void processInput();
     bool isKeyPressed(int key);
     void updateDisplayMode();
     void updateWireframeMode();
     void updateTextureMode();
+    void updateFrameMode();
+    void updateIdleMode();
+    void updateProfilerMode();
+    void saveProfile();
+    void updateWindowTitle();
     void updateCameraPosition();
     void updateSceneOrientation();
 
     void updateScene(const Texture &texture, const Shader &shader);
-    void updateCameraView();
     void updateTexture();
+    void swapBuffers();
     void renderObject(const Object &object, const Texture &texture, const Shader &shader);
     void updateShader(const Texture &texture, const Shader &shader);
 
   public:
-    WindowManagement(const std::vector<Object> &objects);
+    WindowManagement(std::vector<Object> &&objects);
     ~WindowManagement();
 };
\ No newline at end of file
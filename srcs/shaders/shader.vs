@@ -3,8 +3,7 @@
 //uniform: global variables, allow to pass data to the GPU for the shaders
 
 #version 330 core
-layout (location = 0) in vec4 aPos;
-layout (location = 1) in vec3 aColor;
+// the inputs (aPos, aColor) are inserted from the vertex layout of the objects
 
 
 uniform mat4 rotation;
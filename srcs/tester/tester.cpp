@@ -1,30 +1,98 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../classes/Utils/Utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <type_traits>
 
 // allow to use private methods only on this file
 #define private public
 
 #include "../../libs/doctest.h"
+#include "../classes/Camera/Camera.hpp"
+#include "../classes/FramePacer/FramePacer.hpp"
+#include "../classes/GLHandle/GLHandle.hpp"
+#include "../classes/Image/Image.hpp"
+#include "../classes/JobSystem/JobSystem.hpp"
+#include "../classes/LoadStats/LoadStats.hpp"
+#include "../classes/Profiler/Profiler.hpp"
+#include "../classes/Shader/Shader.hpp"
+#include "../classes/TextureContainer/TextureContainer.hpp"
 #include "../classes/MaterialClasses/MaterialParser/MaterialParser.hpp"
+#include "../classes/MaterialClasses/MaterialRegistry/MaterialRegistry.hpp"
 #include "../classes/ObjectClasses/ObjectParser/ObjectParser.hpp"
 
-// maybe test texture too
 TEST_CASE("test useful functions")
 {
+    auto split = [](std::string_view line, char separator = ' ') {
+        const std::pmr::vector<std::string_view> words = Utils::splitLine(line, separator);
+        return (std::vector<std::string_view>(words.begin(), words.end()));
+    };
+
     SUBCASE("test the splitLine function")
     {
         std::string line1 = "hi ! How are you ?";
-        std::vector<std::string> lineSplit1 = {"hi", "!", "How", "are", "you", "?"};
-        CHECK_MESSAGE(Utils::splitLine(line1) == lineSplit1, "line: ", line1);
+        std::vector<std::string_view> lineSplit1 = {"hi", "!", "How", "are", "you", "?"};
+        CHECK_MESSAGE(split(line1) == lineSplit1, "line: ", line1);
         std::string line2 = "     multiples     spaces     ";
-        std::vector<std::string> lineSplit2 = {"multiples", "spaces"};
-        CHECK_MESSAGE(Utils::splitLine(line2) == lineSplit2, "line: ", line2);
+        std::vector<std::string_view> lineSplit2 = {"multiples", "spaces"};
+        CHECK_MESSAGE(split(line2) == lineSplit2, "line: ", line2);
         std::string line3 = "";
-        std::vector<std::string> lineSplit3 = {};
-        CHECK_MESSAGE(Utils::splitLine(line3) == lineSplit3, "line: {nothing}");
+        std::vector<std::string_view> lineSplit3 = {};
+        CHECK_MESSAGE(split(line3) == lineSplit3, "line: {nothing}");
         std::string line4 = "            ";
-        std::vector<std::string> lineSplit4 = {};
-        CHECK_MESSAGE(Utils::splitLine(line4) == lineSplit4, "line: {only space}");
+        std::vector<std::string_view> lineSplit4 = {};
+        CHECK_MESSAGE(split(line4) == lineSplit4, "line: {only space}");
+        std::string line5 = "v\t1.0 \t 2.0\r";
+        std::vector<std::string_view> lineSplit5 = {"v", "1.0", "2.0"};
+        CHECK_MESSAGE(split(line5) == lineSplit5, "line: {tabs}");
+        std::string line6 = "f 1/2 3/4";
+        std::vector<std::string_view> lineSplit6 = {"f", "1", "2", "3", "4"};
+        CHECK_MESSAGE(split(line6, '/') == lineSplit6, "line: ", line6);
+    }
+
+    SUBCASE("test the splitLine function on words across the blocks")
+    {
+        // the words and the separators cross the 16 or 32 bytes compared at once
+        const std::string whitespaces[] = {" ", "\t", "  \t ", "\r\n"};
+        std::string line;
+        std::vector<std::string> words;
+        for (size_t i = 0; i < 200; i++)
+        {
+            words.push_back(std::string(i % 37 + 1, 'a' + i % 26));
+            line += whitespaces[i % 4] + words.back();
+        }
+        const std::vector<std::string_view> lineSplit = split(line);
+        CHECK(std::equal(lineSplit.begin(), lineSplit.end(), words.begin(), words.end()));
+
+        const std::string letters(100, 'x');
+        const std::string spaces(100, ' ');
+        CHECK(Utils::findSeparator(letters, 0) == letters.size());
+        CHECK(Utils::findSeparator(letters + " x", 0) == letters.size());
+        CHECK(Utils::findSeparator("abc/def", 0, '/') == 3);
+        CHECK(Utils::skipSeparators(spaces, 0) == spaces.size());
+        CHECK(Utils::skipSeparators(spaces + "x", 10) == spaces.size());
+    }
+
+    SUBCASE("test the splitLine function with an arena")
+    {
+        char buffer[1024];
+        // nothing can be allocated out of the buffer
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        const std::vector<std::string> lines = {"hi ! How are you ?", "     multiples     spaces     ", "", "            "};
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            {
+                const std::pmr::vector<std::string_view> words = Utils::splitLine(lines[i], &arena);
+                const std::vector<std::string_view> lineSplit = split(lines[i]);
+                CHECK_MESSAGE(std::equal(words.begin(), words.end(), lineSplit.begin(), lineSplit.end()),
+                              "line: ", lines[i]);
+                CHECK(words.get_allocator().resource() == &arena);
+            }
+            arena.release();
+        }
     }
 
     // didn't test degToRad function because comparaison of float is always false
@@ -41,28 +109,42 @@ TEST_CASE("test useful functions")
 
     SUBCASE("testing if a string can be converted to an int")
     {
-        CHECK(Utils::isInt("0123456789"));
-        CHECK(Utils::isInt("-1"));
-        CHECK_FALSE(Utils::isInt("0.1"));
-        CHECK_FALSE(Utils::isInt("1-"));
-        CHECK_FALSE(Utils::isInt("-100-1"));
-        CHECK_FALSE(Utils::isInt("1a"));
-        CHECK_FALSE(Utils::isInt("a1"));
+        long integer;
+        CHECK(Utils::parseInt("0123456789", integer));
+        CHECK(Utils::parseInt("-1", integer));
+        CHECK_FALSE(Utils::parseInt("0.1", integer));
+        CHECK_FALSE(Utils::parseInt("1-", integer));
+        CHECK_FALSE(Utils::parseInt("-100-1", integer));
+        CHECK_FALSE(Utils::parseInt("1a", integer));
+        CHECK_FALSE(Utils::parseInt("a1", integer));
+        CHECK_FALSE(Utils::parseInt("", integer));
+        CHECK_FALSE(Utils::parseInt("+1", integer));
+        CHECK_FALSE(Utils::parseInt("99999999999999999999", integer));
+        CHECK((Utils::parseInt("-42", integer) && integer == -42));
     }
 
     SUBCASE("testing if a string can be converted to a float")
     {
-        CHECK(Utils::isFloat("0123456789"));
-        CHECK(Utils::isFloat("0.01"));
-        CHECK(Utils::isFloat("-0.01"));
-        CHECK_FALSE(Utils::isFloat(".1"));
-        CHECK_FALSE(Utils::isFloat("0..1"));
-        CHECK_FALSE(Utils::isFloat("-.1"));
-        CHECK_FALSE(Utils::isFloat("a.1"));
-        CHECK_FALSE(Utils::isFloat("1-"));
-        CHECK_FALSE(Utils::isFloat("-100-1"));
-        CHECK_FALSE(Utils::isFloat("1a"));
-        CHECK_FALSE(Utils::isFloat("a1"));
+        float number;
+        CHECK(Utils::parseFloat("0123456789", number));
+        CHECK(Utils::parseFloat("0.01", number));
+        CHECK(Utils::parseFloat("-0.01", number));
+        CHECK_FALSE(Utils::parseFloat(".1", number));
+        CHECK_FALSE(Utils::parseFloat("0..1", number));
+        CHECK_FALSE(Utils::parseFloat("-.1", number));
+        CHECK_FALSE(Utils::parseFloat("a.1", number));
+        CHECK_FALSE(Utils::parseFloat("1-", number));
+        CHECK_FALSE(Utils::parseFloat("-100-1", number));
+        CHECK_FALSE(Utils::parseFloat("1a", number));
+        CHECK_FALSE(Utils::parseFloat("a1", number));
+        CHECK_FALSE(Utils::parseFloat("", number));
+        CHECK_FALSE(Utils::parseFloat("inf", number));
+        CHECK_FALSE(Utils::parseFloat("nan", number));
+        CHECK_FALSE(Utils::parseFloat("1e", number));
+        CHECK_FALSE(Utils::parseFloat("1e99", number));
+        CHECK((Utils::parseFloat("1e-5", number) && number == 1e-5f));
+        CHECK((Utils::parseFloat("-2.5E+2", number) && number == -250.0f));
+        CHECK((Utils::parseFloat("0.125", number) && number == 0.125f));
     }
 }
 
@@ -86,6 +168,27 @@ TEST_CASE("test the definition of an object")
         CHECK_THROWS(ObjectParser::parseObjectFile("srcs/tester/ressources/objectWrongSymbol.obj"));
     }
 
+    SUBCASE("testing the parsing of files at the same time")
+    {
+        const std::vector<Face> expectedFaces =
+            ObjectParser::parseObjectFile("srcs/tester/ressources/object.obj")[0].getFaces();
+        std::vector<std::future<bool>> results;
+        for (size_t i = 0; i < 4; i++)
+        {
+            results.push_back(std::async(std::launch::async, [&expectedFaces]() {
+                for (size_t j = 0; j < 50; j++)
+                {
+                    if (ObjectParser::parseObjectFile("srcs/tester/ressources/object.obj")[0].getFaces() !=
+                        expectedFaces)
+                        return (false);
+                }
+                return (true);
+            }));
+        }
+        for (size_t i = 0; i < results.size(); i++)
+            CHECK(results[i].get());
+    }
+
     ObjectData objectData;
     SUBCASE("testing the definition of a name")
     {
@@ -100,6 +203,8 @@ TEST_CASE("test the definition of an object")
         objectData.reset();
         CHECK_NOTHROW(ObjectParser::defineVertex(objectData, "v -0.5 0 0.5 ", 0));
         CHECK_NOTHROW(ObjectParser::defineVertex(objectData, "v -0.5 0 0.5 1", 0));
+        CHECK_NOTHROW(ObjectParser::defineVertex(objectData, "v -5e-1 0 5E-1", 0));
+        CHECK(objectData.getVertex(objectData.getNbVertices() - 1) == Vertex({-0.5f, 0, 0.5f, 1}));
         CHECK_THROWS(ObjectParser::defineVertex(objectData, "v -0.5 0 0 0", 0));
         CHECK_THROWS(ObjectParser::defineVertex(objectData, "v -0.5 0", 0));
         CHECK_THROWS(ObjectParser::defineVertex(objectData, "v -0.5 0 0.5 1 1", 0));
@@ -147,14 +252,45 @@ TEST_CASE("test the definition of an object")
     SUBCASE("testing the usage of a mtllib")
     {
         objectData.reset();
+        MaterialRegistry::clear();
         CHECK_NOTHROW(ObjectParser::saveNewMTL(objectData, "mtllib srcs/tester/ressources/material.mtl", 0));
-        CHECK(ObjectParser::materials.size() == 2);
-        CHECK(ObjectParser::materials[0].getName() == "Material");
-        CHECK(ObjectParser::materials[1].getName() == "Material2");
+        CHECK_NOTHROW(ObjectParser::saveNewMTL(objectData, "mtllib ./srcs/tester/ressources/material.mtl", 0));
+        CHECK(MaterialRegistry::getNbMaterials() == 2);
+        CHECK(MaterialRegistry::getMaterial(0u).getName() == "Material");
+        CHECK(MaterialRegistry::getMaterial(1u).getName() == "Material2");
+        CHECK(MaterialRegistry::getMaterialID("Material2") == 1);
+        CHECK_THROWS(MaterialRegistry::getMaterialID("dontExist"));
+        CHECK_NOTHROW(ObjectParser::saveNewMTL(objectData, "mtllib srcs/tester/ressources/materialWronSymbol.mtl", 0));
+        CHECK_THROWS(MaterialRegistry::waitAll());
+        CHECK_NOTHROW(MaterialRegistry::waitAll());
         CHECK_THROWS(ObjectParser::saveNewMTL(objectData, "mtllib ", 0));
         CHECK_THROWS(ObjectParser::saveNewMTL(objectData, "mtllib first.mtl second.mtl", 0));
     }
 
+    SUBCASE("testing the materials of a previous scene")
+    {
+        MaterialRegistry::clear();
+        MaterialRegistry::prefetch("srcs/tester/ressources/material.mtl");
+        CHECK(MaterialRegistry::hasMaterial("Material2"));
+
+        // a file changed after being parsed keeps its first result: it isn't parsed again by the next scenes
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string materialPath = (directory / "scop_test_scene.mtl").string();
+        const std::string objectPath = (directory / "scop_test_scene.obj").string();
+        std::ofstream(materialPath) << "newmtl Scene\nKa 0.1 0.1 0.1\n";
+        std::ofstream(objectPath) << "mtllib " << materialPath << "\nv 0 0 0\nv 1 0 0\nv 1 1 0\nusemtl Scene\nf 1 2 3";
+        ObjectParser::parseObjectFile(objectPath);
+        CHECK_FALSE(MaterialRegistry::hasMaterial("Material2"));
+        const size_t nbFiles = MaterialRegistry::files.size();
+        std::ofstream(materialPath) << "newmtl Scene\nKa 0.9 0.9 0.9\n";
+        ObjectParser::parseObjectFile(objectPath);
+        CHECK(MaterialRegistry::files.size() == nbFiles);
+        CHECK(MaterialRegistry::getNbMaterials() == 1);
+        CHECK(MaterialRegistry::getMaterial("Scene").getColor(AMBIANT_COLOR)[0] == doctest::Approx(0.1f));
+        std::filesystem::remove(materialPath);
+        std::filesystem::remove(objectPath);
+    }
+
     SUBCASE("testing the definition of a material")
     {
         objectData.reset();
@@ -275,4 +411,504 @@ TEST_CASE("test the definition of a material")
         CHECK_THROWS(MaterialParser::defineIllum(materialData, "illum 0.1", 0));
         CHECK_THROWS(MaterialParser::defineIllum(materialData, "illum 1a", 0));
     }
+}
+
+TEST_CASE("test the loading of an image")
+{
+    const unsigned char expectedPixels[] = {255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255};
+
+    SUBCASE("testing the loading of an ascii image")
+    {
+        Image image("srcs/tester/ressources/image.ppm");
+        CHECK(image.getWidth() == 2);
+        CHECK(image.getHeight() == 2);
+        CHECK(image.getChannels() == 3);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, image.getPixels()));
+    }
+
+    SUBCASE("testing the loading of a binary image")
+    {
+        Image image("srcs/tester/ressources/imageBinary.ppm");
+        CHECK(image.getChannels() == 3);
+        CHECK(image.data == nullptr);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, image.getPixels()));
+
+        Image image16Bits("srcs/tester/ressources/image16Bits.ppm");
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, image16Bits.getPixels()));
+
+        Image copy(image);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, copy.getPixels()));
+    }
+
+    SUBCASE("testing the loading of a gray image")
+    {
+        const unsigned char expectedGray[] = {0, 85, 170, 255};
+        Image image("srcs/tester/ressources/imageGray.pgm");
+        CHECK(image.getChannels() == 1);
+        CHECK(image.getSize() == 4);
+        CHECK(std::equal(expectedGray, expectedGray + 4, image.getPixels()));
+    }
+
+    SUBCASE("testing the loading of an invalid image")
+    {
+        CHECK_THROWS(Image("srcs/tester/ressources/dontExist.ppm"));
+        CHECK_THROWS(Image("srcs/tester/ressources/imageWrongHeader.ppm"));
+        CHECK_THROWS(Image("srcs/tester/ressources/imageWrongValue.ppm"));
+        CHECK_THROWS(Image("srcs/tester/ressources/imageMissingPixels.ppm"));
+
+        // an ascii header larger than the file is rejected before allocating its pixels
+        const std::string path = (std::filesystem::temp_directory_path() / "scop_test_ascii.ppm").string();
+        std::ofstream(path) << "P3 1000000 1000000 255\n0 0 0\n";
+        CHECK_THROWS_WITH(Image{path}, doctest::Contains("READ_ASCII_PIXELS::MISSING_PIXELS"));
+        std::filesystem::remove(path);
+        CHECK_THROWS(Image("srcs/tester/ressources/material.mtl"));
+    }
+}
+
+TEST_CASE("test the texture container")
+{
+    const Image image("srcs/tester/ressources/image.ppm");
+    const Image grayImage("srcs/tester/ressources/imageGray.pgm");
+
+    SUBCASE("testing the generation of the mipmap levels")
+    {
+        const unsigned char expectedLevel[] = {128, 128, 128};
+        TextureContainer container(image, RGB8_FORMAT);
+        CHECK(container.getLevels().size() == 2);
+        CHECK(container.getLevels()[0].width == 2);
+        CHECK(container.getLevels()[1].width == 1);
+        CHECK(std::equal(image.getPixels(), image.getPixels() + 12, container.getLevels()[0].data));
+        CHECK(std::equal(expectedLevel, expectedLevel + 3, container.getLevels()[1].data));
+    }
+
+    SUBCASE("testing the BC1 compression")
+    {
+        const unsigned char expectedPixels[] = {0, 0, 0, 85, 85, 85, 170, 170, 170, 255, 255, 255};
+        TextureContainer container(grayImage, BC1_FORMAT);
+        CHECK(container.getLevels()[0].size == 8);
+        std::vector<unsigned char> pixels = TextureContainer::decompressBC1(container.getLevels()[0]);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, pixels.data()));
+    }
+
+    SUBCASE("testing the saving and the loading of a container")
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "scop_test.stx").string();
+        TextureContainer container(image, BC1_FORMAT);
+        container.save(path);
+        TextureContainer loadedContainer(path);
+        CHECK(loadedContainer.getFormat() == BC1_FORMAT);
+        CHECK(loadedContainer.getDataSize() == container.getDataSize());
+        CHECK(std::equal(container.getData(), container.getData() + container.getDataSize(),
+                         loadedContainer.getData()));
+        std::filesystem::remove(path);
+        CHECK_THROWS(TextureContainer("srcs/tester/ressources/image.ppm"));
+    }
+
+    SUBCASE("testing the container preferred to an image")
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string imagePath = (directory / "scop_test_texture.ppm").string();
+        const std::string containerPath = (directory / "scop_test_texture.stx").string();
+        std::filesystem::remove(containerPath);
+        CHECK(TextureContainer::getContainerPath(imagePath) == imagePath);
+        TextureContainer(image, RGB8_FORMAT).save(containerPath);
+        CHECK(TextureContainer::getContainerPath(imagePath) == containerPath);
+        CHECK(TextureContainer::getContainerPath(containerPath) == containerPath);
+        // an image modified after its conversion is loaded instead of its stale container
+        std::filesystem::copy_file("srcs/tester/ressources/image.ppm", imagePath,
+                                   std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::last_write_time(imagePath, std::filesystem::last_write_time(containerPath) -
+                                                        std::chrono::seconds(10));
+        CHECK(TextureContainer::getContainerPath(imagePath) == containerPath);
+        std::filesystem::last_write_time(imagePath, std::filesystem::last_write_time(containerPath) +
+                                                        std::chrono::seconds(10));
+        CHECK(TextureContainer::getContainerPath(imagePath) == imagePath);
+        std::filesystem::remove(imagePath);
+        std::filesystem::remove(containerPath);
+        CHECK(TextureContainer::getContainerPath("srcs/tester/ressources/image.ppm") ==
+              "srcs/tester/ressources/image.ppm");
+    }
+}
+
+TEST_CASE("test the frame pacer")
+{
+    SUBCASE("testing the modes")
+    {
+        FramePacer framePacer(VSYNC_MODE, 60, true);
+        CHECK(framePacer.isVsync());
+        framePacer.nextMode();
+        CHECK(framePacer.getMode() == UNCAPPED_MODE);
+        framePacer.nextMode();
+        CHECK(framePacer.getModeName() == "60 fps");
+        framePacer.nextMode();
+        CHECK(framePacer.getMode() == VSYNC_MODE);
+        CHECK_THROWS(framePacer.setFPS(0));
+        CHECK_THROWS(framePacer.setFPS(-30));
+    }
+
+    SUBCASE("testing the wait for events while a key is held")
+    {
+        FramePacer framePacer(VSYNC_MODE, 60, true);
+        CHECK(framePacer.canWaitEvents(false, false));
+        CHECK_FALSE(framePacer.canWaitEvents(true, false));
+        CHECK_FALSE(framePacer.canWaitEvents(false, true));
+        framePacer.setIdleMode(false);
+        CHECK_FALSE(framePacer.canWaitEvents(false, false));
+    }
+
+    SUBCASE("testing the wait between frames")
+    {
+        FramePacer framePacer(FIXED_FPS_MODE, 200, true);
+        double start = FramePacer::getTime();
+        for (int i = 0; i < 5; i++)
+            framePacer.waitNextFrame(true);
+        CHECK(FramePacer::getTime() - start >= 4.0 / 200);
+
+        framePacer.setMode(UNCAPPED_MODE);
+        start = FramePacer::getTime();
+        framePacer.waitNextFrame(true);
+        CHECK(FramePacer::getTime() - start < 1.0 / 200);
+
+        framePacer.setMode(FIXED_FPS_MODE);
+        start = FramePacer::getTime();
+        framePacer.waitNextFrame(false);
+        CHECK(FramePacer::getTime() - start < 1.0 / 200);
+
+        start = FramePacer::getTime();
+        FramePacer::sleepUntil(start + 0.005);
+        CHECK(FramePacer::getTime() >= start + 0.005);
+    }
+}
+
+TEST_CASE("test the profiler")
+{
+    Profiler::clear();
+    Profiler::setEnabled(false);
+
+    SUBCASE("testing the scoped timers")
+    {
+        {
+            const Profiler::Scope profile("disabled");
+        }
+        CHECK(Profiler::getEvents().empty());
+        Profiler::setEnabled(true);
+        {
+            const Profiler::Scope profile("enabled");
+            FramePacer::sleepUntil(FramePacer::getTime() + 0.002);
+        }
+        Profiler::nextFrame();
+        {
+            const Profiler::Scope profile("nextFrame");
+        }
+        std::vector<s_profileEvent> events = Profiler::getEvents();
+        CHECK(events.size() == 2);
+        CHECK(std::string(events[0].name) == "enabled");
+        CHECK(events[0].clock == CPU_CLOCK);
+        CHECK(events[0].duration >= 0.002);
+        CHECK(events[0].frame == 0);
+        CHECK(events[1].frame == 1);
+        CHECK(events[1].start >= events[0].start + events[0].duration);
+    }
+
+    SUBCASE("testing the ring buffer")
+    {
+        for (size_t i = 0; i < PROFILER_CAPACITY + 10; i++)
+            Profiler::record((i < 10) ? "old" : "new", CPU_CLOCK, Profiler::getTime(), 0);
+        std::vector<s_profileEvent> events = Profiler::getEvents();
+        CHECK(events.size() == PROFILER_CAPACITY);
+        CHECK(std::string(events.front().name) == "new");
+        CHECK(std::string(events.back().name) == "new");
+    }
+
+    SUBCASE("testing the chrome trace")
+    {
+        Profiler::record("processInput", CPU_CLOCK, Profiler::getTime(), 0.001);
+        Profiler::record("renderObject", GPU_CLOCK, Profiler::getTime(), 0.002);
+        const std::string trace = Profiler::toChromeTrace();
+        CHECK(trace.find("{\"traceEvents\":[") == 0);
+        CHECK(trace.find("\"name\":\"processInput\",\"cat\":\"cpu\",\"ph\":\"X\"") != std::string::npos);
+        CHECK(trace.find("\"dur\":2000.000,\"pid\":1,\"tid\":1") != std::string::npos);
+
+        const std::string path = (std::filesystem::temp_directory_path() / "scop_test_trace.json").string();
+        CHECK_NOTHROW(Profiler::dumpChromeTrace(path));
+        CHECK(std::filesystem::file_size(path) == trace.size());
+        std::filesystem::remove(path);
+        CHECK_THROWS(Profiler::dumpChromeTrace("dontExist/trace.json"));
+    }
+    Profiler::setEnabled(false);
+    Profiler::clear();
+}
+
+TEST_CASE("test the vertex layout")
+{
+    const std::vector<Vertex> vertices = {{1, 2, 3, 1, 0.5f, 0.5f, 0.5f}, {4, 5, 6, 1, 0, 0, 1}};
+    const std::vector<float> expected = {1, 2, 3, 1, 0.5f, 0.5f, 0.5f, 4, 5, 6, 1, 0, 0, 1};
+    const std::string inputs = "layout (location = 0) in vec4 aPos;\nlayout (location = 1) in vec3 aColor;\n";
+
+    CHECK(ObjectVertexLayout::size == 7);
+    CHECK(ObjectVertexLayout::getOffset(POSITION_LOCATION) == 0);
+    CHECK(ObjectVertexLayout::getOffset(COLOR_LOCATION) == 4);
+    CHECK(ObjectVertexLayout::getShaderInputs() == inputs);
+
+    // the floats after the layout are ignored
+    const std::unique_ptr<float[]> array = ObjectVertexLayout::pack(vertices);
+    CHECK(std::equal(expected.begin(), expected.end(), array.get()));
+
+    const std::string code = "// comment\n#version 330 core\nvoid main() {}";
+    CHECK(Shader::insertAfterVersion(code, "in vec4 a;\n", "test.vs") ==
+          "// comment\n#version 330 core\nin vec4 a;\nvoid main() {}");
+    CHECK(Shader::insertAfterVersion(code, "", "test.vs") == code);
+    CHECK_THROWS_AS(Shader::insertAfterVersion("void main() {}", "in vec4 a;\n", "test.vs"), std::exception);
+}
+
+// a handle that counts its names instead of calling OpenGL
+static unsigned int nbFakeNames = 0;
+static unsigned int nbFakeDeletions = 0;
+
+static unsigned int createFakeName()
+{
+    return (++nbFakeNames);
+}
+
+static void deleteFakeName(unsigned int)
+{
+    nbFakeDeletions++;
+}
+
+typedef GLHandle<createFakeName, deleteFakeName> FakeHandle;
+
+TEST_CASE("test the GL handles")
+{
+    CHECK(!std::is_copy_constructible_v<FakeHandle>);
+    CHECK(!std::is_copy_constructible_v<Object>);
+    CHECK(!std::is_copy_constructible_v<Shader>);
+    CHECK(std::is_nothrow_move_constructible_v<BufferHandle>);
+    CHECK(std::is_nothrow_move_assignable_v<TextureHandle>);
+    CHECK(std::is_move_constructible_v<Object>);
+
+    {
+        FakeHandle first = FakeHandle::create();
+        CHECK(first.get() == 1);
+        FakeHandle second(std::move(first));
+        CHECK(first.get() == 0);
+        CHECK(second.get() == 1);
+
+        // the names follow the handles when the vector grows
+        std::vector<FakeHandle> handles;
+        handles.push_back(std::move(second));
+        for (size_t i = 0; i < 100; i++)
+            handles.push_back(FakeHandle::create());
+        CHECK(nbFakeDeletions == 0);
+        CHECK(handles[0].get() == 1);
+
+        handles[0] = FakeHandle::create();
+        CHECK(nbFakeDeletions == 1);
+        handles[1].reset();
+        handles[1].reset();
+        CHECK(nbFakeDeletions == 2);
+    }
+    // every name is deleted once
+    CHECK(nbFakeDeletions == nbFakeNames);
+
+    // the objects are moved, not copied
+    std::vector<Object> objects = ObjectParser::parseObjectFile("srcs/tester/ressources/object.obj");
+    REQUIRE(objects.size() > 0);
+    const size_t nbFaces = objects[0].getFaces().size();
+    std::vector<Object> moved = std::move(objects);
+    Object object(std::move(moved[0]));
+    CHECK(object.getFaces().size() == nbFaces);
+    CHECK(moved[0].getFaces().size() == 0);
+    CHECK(!object.isVAOInit());
+}
+
+TEST_CASE("test the camera")
+{
+    Camera camera;
+
+    // looks from (0, 0, 3) to -z
+    CHECK(camera.dirtyFlags == CAMERA_ALL_DIRTY);
+    CHECK(camera.getFrontDirection().getZ() == doctest::Approx(-1));
+    CHECK(camera.dirtyFlags == (CAMERA_VIEW_DIRTY | CAMERA_PROJECTION_DIRTY));
+    CHECK(camera.getView().getData(3, 2) == doctest::Approx(-3));
+    CHECK(camera.dirtyFlags == 0);
+
+    // the cache is kept until a change
+    const float *view = camera.getView().getData();
+    camera.setSpeed(5);
+    CHECK(camera.dirtyFlags == 0);
+    CHECK(camera.getView().getData() == view);
+    camera.addToYaw(10);
+    CHECK(camera.dirtyFlags == (CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY));
+    camera.addToYaw(-10);
+    camera.getViewProjection();
+    CHECK(camera.dirtyFlags == 0);
+
+    // the projection follows the framebuffer
+    camera.setViewport(800, 400);
+    CHECK(camera.getAspectRatio() == doctest::Approx(2));
+    CHECK(camera.dirtyFlags == CAMERA_PROJECTION_DIRTY);
+    camera.setViewport(0, 0);
+    CHECK(camera.getAspectRatio() == doctest::Approx(2));
+    const Matrix projection = Matrix::perspective(camera.getFov(), 2, CAMERA_NEAR_PLANE, CAMERA_FAR_PLANE);
+    for (unsigned int i = 0; i < 16; i++)
+        CHECK(camera.getProjection().getData()[i] == doctest::Approx(projection.getData()[i]));
+    const Matrix viewProjection = camera.getView() * camera.getProjection();
+    for (unsigned int i = 0; i < 16; i++)
+        CHECK(camera.getViewProjection().getData()[i] == doctest::Approx(viewProjection.getData()[i]));
+
+    // the planes of the frustum
+    const std::array<s_plane, NB_FRUSTUM_PLANES> &frustum = camera.getFrustum();
+    CHECK(frustum[NEAR_PLANE].normal[2] == doctest::Approx(-1));
+    CHECK(frustum[NEAR_PLANE].distance == doctest::Approx(3 - CAMERA_NEAR_PLANE));
+    CHECK(frustum[FAR_PLANE].normal[2] == doctest::Approx(1));
+    CHECK(camera.isSphereVisible({0, 0, 0}, 1));
+    CHECK(!camera.isSphereVisible({0, 0, 10}, 1));
+    CHECK(camera.isSphereVisible({0, 0, 10}, 8));
+    CHECK(!camera.isSphereVisible({0, 0, -200}, 1));
+    CHECK(!camera.isSphereVisible({50, 0, 0}, 1));
+    CHECK(camera.isSphereVisible({2.5f, 0, 0}, 0.1f));
+    CHECK(!camera.isSphereVisible({0, 2.5f, 0}, 0.1f));
+}
+
+TEST_CASE("test the job system")
+{
+    JobSystem jobs(3);
+
+    SUBCASE("testing a parallel loop")
+    {
+        std::vector<size_t> values(10000, 0);
+        size_t nbWrong = 0;
+        size_t nbIndices = 0;
+
+        jobs.parallelFor(values.size(), 16, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+                values[i] += i;
+        });
+        for (size_t i = 0; i < values.size(); i++)
+            nbWrong += (values[i] != i);
+        CHECK(nbWrong == 0);
+        jobs.parallelFor(0, 1, [&](size_t first, size_t last) { nbIndices += last - first + 1; });
+        jobs.parallelFor(5, 16, [&](size_t first, size_t last) { nbIndices += last - first; });
+        CHECK(nbIndices == 5);
+        CHECK(jobs.getNbThreads() == 4);
+        CHECK(JobSystem(0).getNbThreads() == 1);
+    }
+
+    SUBCASE("testing the jobs started by a job")
+    {
+        std::atomic<size_t> total(0);
+
+        jobs.parallelFor(8, 1, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+                jobs.parallelFor(1000, 10, [&](size_t start, size_t end) { total += end - start; });
+        });
+        CHECK(total == 8000);
+    }
+
+    SUBCASE("testing a graph of jobs")
+    {
+        std::mutex mutex;
+        std::string order;
+        JobSystem::Graph graph;
+        auto record = [&](char name) {
+            return ([&, name]() {
+                const std::lock_guard<std::mutex> lock(mutex);
+                order += name;
+            });
+        };
+
+        const size_t a = graph.add(record('a'));
+        const size_t b = graph.add(record('b'), {a});
+        const size_t c = graph.add(record('c'), {a});
+        graph.add(record('d'), {b, c});
+        jobs.run(graph);
+        CHECK((order == "abcd" || order == "acbd"));
+        order.clear();
+        jobs.run(graph);
+        CHECK(order.size() == 4);
+        CHECK_THROWS_AS(graph.add(record('e'), {4}), std::exception);
+        CHECK(graph.getSize() == 4);
+    }
+
+    SUBCASE("testing the exceptions of the jobs")
+    {
+        JobSystem::Group group;
+        JobSystem::Graph graph;
+        std::atomic<size_t> nbDone(0);
+        bool dependentRun = false;
+
+        for (size_t i = 0; i < 10; i++)
+        {
+            jobs.run(group, [&nbDone, i]() {
+                if (i == 5)
+                    throw(std::runtime_error("job 5"));
+                nbDone++;
+            });
+        }
+        CHECK_THROWS_WITH(jobs.wait(group), "job 5");
+        CHECK(nbDone == 9);
+        CHECK_NOTHROW(jobs.wait(group));
+
+        const size_t failing = graph.add([]() { throw(std::runtime_error("failed")); });
+        graph.add([&]() { dependentRun = true; }, {failing});
+        CHECK_THROWS_WITH(jobs.run(graph), "failed");
+        CHECK(!dependentRun);
+    }
+}
+
+TEST_CASE("test the load stats")
+{
+    LoadStats::reset();
+
+    SUBCASE("testing the counters of a loading")
+    {
+        LoadStats::setEnabled(true);
+        std::vector<Object> objects = ObjectParser::parseObjectFile("srcs/tester/ressources/object.obj");
+        objects[0].generateFacesColor();
+        LoadStats::setEnabled(false);
+        CHECK(LoadStats::getSymbolCount("v") == 4);
+        CHECK(LoadStats::getSymbolCount("f") == 2);
+        CHECK(LoadStats::getSymbolCount("s") == 1);
+        CHECK(LoadStats::getCounter(TRIANGLES) == 2);
+        CHECK(LoadStats::getCounter(EARS_CLIPPED) == 0);
+        CHECK(LoadStats::getStage(TRIANGULATE_STAGE).calls == 1);
+        CHECK(LoadStats::getCounter(UNIQUE_COLORED_VERTICES) + LoadStats::getCounter(COLORED_DEDUP_HITS) == 6);
+        CHECK(LoadStats::getStage(READ_FILE_STAGE).calls == 1);
+        CHECK(LoadStats::getStage(PARSE_STAGE).calls == 1);
+        CHECK(LoadStats::getStage(PARSE_STAGE).peakRSS > 0);
+        CHECK(LoadStats::getStage(GENERATE_COLORS_STAGE).calls == 1);
+        CHECK(LoadStats::getStage(UPLOAD_STAGE).calls == 0);
+
+        ObjectParser::parseObjectFile("srcs/tester/ressources/object.obj");
+        CHECK(LoadStats::getSymbolCount("v") == 4);
+        CHECK(LoadStats::getStage(PARSE_STAGE).calls == 1);
+    }
+
+    SUBCASE("testing the counters of another thread")
+    {
+        LoadStats::setEnabled(true);
+        std::async(std::launch::async, []() {
+            const LoadStats::Stage stage(UPLOAD_STAGE);
+            LoadStats::add(BYTES_UPLOADED, 8);
+            LoadStats::add(BYTES_UPLOADED, 4);
+        }).wait();
+        LoadStats::setEnabled(false);
+        CHECK(LoadStats::getCounter(BYTES_UPLOADED) == 12);
+        CHECK(LoadStats::getStage(UPLOAD_STAGE).calls == 1);
+    }
+
+    SUBCASE("testing the reports")
+    {
+        LoadStats::setEnabled(true);
+        LoadStats::countSymbol("v");
+        LoadStats::countSymbol("a\"b");
+        LoadStats::add(TRIANGLES, 12);
+        LoadStats::setEnabled(false);
+        const std::string json = LoadStats::toJSON();
+        CHECK(json.find("\"triangles\":12") != std::string::npos);
+        CHECK(json.find("\"lines\":{\"a\\\"b\":1,\"v\":1}") != std::string::npos);
+        CHECK(json.find("\"readFile\":{\"wallTimeMs\":0,\"calls\":0,\"peakRSSKB\":0}") != std::string::npos);
+        CHECK(LoadStats::toText().find("triangles: 12") != std::string::npos);
+    }
+    LoadStats::reset();
 }
\ No newline at end of file
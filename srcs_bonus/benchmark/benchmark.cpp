@@ -0,0 +1,187 @@
+#include "../classes/ObjectClasses/NormalGenerator/NormalGenerator.hpp"
+#include "../classes/Utils/Utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * compares the conversion of the numbers of an object file:
+ * the former path (a validation with std::string::find per character, then std::stof / std::stoi)
+ * against the single pass of Utils::parseFloat / Utils::parseInt.
+ * the tokens look like the ones of an exporter, without exponent since the former path refuses them.
+ *
+ * then measures the generation of the smooth normals of a height field of nbTriangles triangles
+ */
+
+static bool formerIsInt(const std::string &word)
+{
+    const std::string numbers = "0123456789";
+    size_t start = 0;
+    if (word[0] == '-')
+        start++;
+
+    for (size_t i = start; i < word.size(); i++)
+    {
+        if (numbers.find(word[i]) == std::string::npos)
+            return (false);
+    }
+    return (true);
+}
+
+static bool formerIsFloat(const std::string &word)
+{
+    const std::string numbers = "0123456789";
+    size_t start = 0;
+    bool pointFound = false;
+    if (word[0] == '-')
+        start++;
+
+    for (size_t i = start; i < word.size(); i++)
+    {
+        if (word[i] == '.')
+        {
+            if (pointFound || i == 0 || (word[0] == '-' && i == 1))
+                return (false);
+            pointFound = true;
+            continue;
+        }
+        if (numbers.find(word[i]) == std::string::npos)
+            return (false);
+    }
+    return (true);
+}
+
+static std::vector<std::string> generateTokens(size_t nbTokens, bool integers)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> floats(-100, 100);
+    std::uniform_int_distribution<long> indices(-1000, 100000);
+    std::vector<std::string> tokens;
+
+    tokens.reserve(nbTokens);
+    for (size_t i = 0; i < nbTokens; i++)
+    {
+        if (integers)
+            tokens.push_back(std::to_string(indices(generator) | 1));
+        else
+            tokens.push_back(std::to_string(floats(generator)));
+    }
+    return (tokens);
+}
+
+/*
+    the time of a conversion in nanoseconds, the sum keeps the results alive
+*/
+template <typename Function> static double measure(const std::vector<std::string> &tokens, Function convert, double &sum)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < tokens.size(); i++)
+        sum += convert(tokens[i]);
+    const auto end = std::chrono::steady_clock::now();
+    return (std::chrono::duration<double, std::nano>(end - start).count() / tokens.size());
+}
+
+static void printResult(const std::string &name, double former, double current)
+{
+    std::cout << name << ": isFloat/isInt + stof/stoi " << former << " ns, parse " << current << " ns, x"
+              << former / current << std::endl;
+}
+
+/*
+    a grid of about nbTriangles triangles sharing their vertices, in a single smoothing group
+*/
+static void benchmarkNormals(size_t nbTriangles)
+{
+    const size_t vertexSize = 7; // position and normal, the layout of the scene isn't needed
+    const size_t size = std::max(static_cast<size_t>(1), static_cast<size_t>(std::sqrt(nbTriangles / 2)));
+    std::vector<float> vertices((size + 1) * (size + 1) * vertexSize, 0);
+    std::vector<uint32_t> indices;
+    const std::vector<uint32_t> groups(size * size * 2, 1);
+
+    for (size_t y = 0; y <= size; y++)
+    {
+        for (size_t x = 0; x <= size; x++)
+        {
+            float *vertex = &vertices[(y * (size + 1) + x) * vertexSize];
+            vertex[0] = x;
+            vertex[1] = y;
+            vertex[2] = std::sin(x * 0.01f) * std::cos(y * 0.01f) * 10;
+        }
+    }
+    indices.reserve(groups.size() * 3);
+    for (size_t y = 0; y < size; y++)
+    {
+        for (size_t x = 0; x < size; x++)
+        {
+            const uint32_t corner = y * (size + 1) + x;
+            indices.insert(indices.end(), {corner, corner + 1, corner + static_cast<uint32_t>(size) + 1});
+            indices.insert(indices.end(), {corner + 1, corner + static_cast<uint32_t>(size) + 2,
+                                           corner + static_cast<uint32_t>(size) + 1});
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    NormalGenerator::generate(vertices.data(), {vertexSize, 4}, indices.data(), groups.size(), groups.data());
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << "normals: " << groups.size() << " triangles in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms with "
+              << NormalGenerator::getNbThreads(groups.size()) << " threads" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        const long nbTokens = (argc >= 2) ? std::atol(argv[1]) : 1000000;
+        const long nbTriangles = (argc == 3) ? std::atol(argv[2]) : 1000000;
+        if (argc > 3 || nbTokens <= 0 || nbTriangles <= 0)
+            throw(std::runtime_error("BENCHMARK::USAGE: ./scop_benchmark [nbTokens] [nbTriangles]"));
+
+        const std::vector<std::string> floats = generateTokens(nbTokens, false);
+        const std::vector<std::string> integers = generateTokens(nbTokens, true);
+        double formerSum = 0;
+        double currentSum = 0;
+
+        const double formerFloat = measure(floats, [](const std::string &token) {
+            if (!formerIsFloat(token))
+                throw(std::runtime_error("BENCHMARK::INVALID_TOKEN: " + token));
+            return (std::stof(token));
+        }, formerSum);
+        const double currentFloat = measure(floats, [](const std::string &token) {
+            float value;
+            if (!Utils::parseFloat(token, value))
+                throw(std::runtime_error("BENCHMARK::INVALID_TOKEN: " + token));
+            return (value);
+        }, currentSum);
+        const double formerInt = measure(integers, [](const std::string &token) {
+            if (!formerIsInt(token))
+                throw(std::runtime_error("BENCHMARK::INVALID_TOKEN: " + token));
+            return (std::stoi(token));
+        }, formerSum);
+        const double currentInt = measure(integers, [](const std::string &token) {
+            long value;
+            if (!Utils::parseInt(token, value))
+                throw(std::runtime_error("BENCHMARK::INVALID_TOKEN: " + token));
+            return (value);
+        }, currentSum);
+
+        std::cout << nbTokens << " tokens per run" << std::endl;
+        printResult("floats", formerFloat, currentFloat);
+        printResult("integers", formerInt, currentInt);
+        if (formerSum != currentSum)
+            throw(std::runtime_error("BENCHMARK::DIFFERENT_RESULTS"));
+        benchmarkNormals(nbTriangles);
+        return (EXIT_SUCCESS);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return (EXIT_FAILURE);
+    }
+}
\ No newline at end of file
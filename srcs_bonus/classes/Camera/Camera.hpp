@@ -1,19 +1,68 @@
 #pragma once
 
 #include "../Matrix/Matrix.hpp"
+#include <array>
 
+#define CAMERA_NEAR_PLANE 0.1f
+#define CAMERA_FAR_PLANE 100.0f
+#define CAMERA_DEFAULT_ASPECT_RATIO (4.0f / 3.0f) // until the size of the framebuffer is known
+
+// what must be computed again before the next read
+typedef enum cameraDirty
+{
+    CAMERA_DIRECTIONS_DIRTY = 1 << 0,
+    CAMERA_VIEW_DIRTY = 1 << 1,
+    CAMERA_PROJECTION_DIRTY = 1 << 2,
+    CAMERA_ALL_DIRTY = CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY | CAMERA_PROJECTION_DIRTY
+} e_cameraDirty;
+
+typedef enum frustumPlane
+{
+    LEFT_PLANE,
+    RIGHT_PLANE,
+    BOTTOM_PLANE,
+    TOP_PLANE,
+    NEAR_PLANE,
+    FAR_PLANE,
+    NB_FRUSTUM_PLANES
+} e_frustumPlane;
+
+// the points p inside the plane verify dot(normal, p) + distance >= 0, the normal has a length of 1
+typedef struct plane
+{
+    float normal[3];
+    float distance;
+} s_plane;
+
+/**
+ * position and orientation of the point of view.
+ * the directions, the matrices and the planes of the frustum are derived from them,
+ * they are only computed again when they are read after a change,
+ * so a frame where the camera doesn't move reuses them as they are
+ */
 class Camera
 {
   private:
     Matrix position;
-    Matrix frontDirection;
-    Matrix rightDirection;
     Matrix upDirection;
     float yaw;   // x-axis by euler
     float pitch; // y-axis by euler
     float roll;  // z-axis by euler
     float fov;
     float speed;
+    float aspectRatio; // width / height of the framebuffer
+
+    mutable unsigned int dirtyFlags; // e_cameraDirty
+    mutable Matrix frontDirection;
+    mutable Matrix rightDirection;
+    mutable Matrix view;
+    mutable Matrix projection;
+    mutable Matrix viewProjection;
+    mutable std::array<s_plane, NB_FRUSTUM_PLANES> frustum;
+
+    void updateDirections() const;
+    void updateMatrices() const;
+    void updateFrustum() const;
 
     class Exception : public std::exception
     {
@@ -42,19 +91,24 @@ class Camera
     float getRoll() const;
     float getFov() const;
     float getSpeed() const;
+    float getAspectRatio() const;
+    const Matrix &getView() const;
+    const Matrix &getProjection() const;
+    const Matrix &getViewProjection() const;
+    const std::array<s_plane, NB_FRUSTUM_PLANES> &getFrustum() const;
+    bool isSphereVisible(const std::array<float, 3> &center, float radius) const;
 
     void setPosition(const Matrix &position);
-    void setFrontDirection(const Matrix &frontDirection);
-    void setRightDirection(const Matrix &rightDirection);
     void setUpDirection(const Matrix &upDirection);
     void setYaw(float yaw);
     void setPitch(float pitch);
     void setRoll(float roll);
     void setFov(float fov);
     void setSpeed(float speed);
+    void setViewport(int width, int height);
 
     void addToPosition(const Matrix &position);
     void addToYaw(float yaw);
     void addToPitch(float pitch);
     void addToFov(float fov);
-};
+};
\ No newline at end of file
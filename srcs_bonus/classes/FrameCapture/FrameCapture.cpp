@@ -0,0 +1,150 @@
+#include "FrameCapture.hpp"
+#include <cstring>
+
+FrameCapture::FrameCapture()
+{
+    for (size_t i = 0; i < ring.size(); i++)
+    {
+        ring[i].allocatedSize = 0;
+        ring[i].fence = NULL;
+        ring[i].width = 0;
+        ring[i].height = 0;
+    }
+    nextFrame = 0;
+    nbWritten = 0;
+    nbDropped = 0;
+}
+
+/*
+    the frames still in the ring are lost, the encoder writes the frames it already has
+*/
+FrameCapture::~FrameCapture()
+{
+    for (size_t i = 0; i < ring.size(); i++)
+    {
+        if (ring[i].fence != NULL)
+            glDeleteSync(ring[i].fence);
+    }
+}
+
+bool FrameCapture::isCapturing() const
+{
+    return (encoder != NULL);
+}
+
+size_t FrameCapture::getNbWritten() const
+{
+    return ((encoder != NULL) ? encoder->getNbWritten() : nbWritten);
+}
+
+size_t FrameCapture::getNbDropped() const
+{
+    return (nbDropped + ((encoder != NULL) ? encoder->getNbDropped() : 0));
+}
+
+void FrameCapture::start(const std::string &path, int fps)
+{
+    nbWritten = 0;
+    nbDropped = 0;
+    encoder = std::make_unique<FrameEncoder>(path, fps);
+}
+
+/*
+    the buffer is mapped once the GPU has written it, so the mapping doesn't wait.
+    the copy is given to the encoder, the buffer is free for another frame
+*/
+void FrameCapture::readBack(s_pendingFrame &frame)
+{
+    s_capturedFrame captured = {frame.width, frame.height, {}};
+
+    glDeleteSync(frame.fence);
+    frame.fence = NULL;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.buffer.get());
+    const void *pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frame.allocatedSize, GL_MAP_READ_BIT);
+    if (pixels == NULL)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        nbDropped++;
+        return;
+    }
+    captured.pixels.resize(frame.allocatedSize);
+    std::memcpy(captured.pixels.data(), pixels, frame.allocatedSize);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    encoder->push(std::move(captured));
+}
+
+/*
+    the frames are read back in the order they were rendered,
+    without waiting the first frame the GPU hasn't finished stops the reading
+*/
+void FrameCapture::poll(bool wait)
+{
+    for (size_t i = 0; i < ring.size(); i++)
+    {
+        s_pendingFrame &frame = ring[(nextFrame + i) % ring.size()];
+        if (frame.fence == NULL)
+            continue;
+        const GLenum status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+        if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+            return;
+        readBack(frame);
+    }
+}
+
+/*
+    called once the frame is in the back buffer of the window, before it's swapped.
+    RGBA is the format the drivers copy without converting it
+*/
+void FrameCapture::capture(int width, int height)
+{
+    const size_t size = static_cast<size_t>(width) * height * 4;
+
+    if (encoder == NULL || width <= 0 || height <= 0)
+        return;
+    poll(false);
+    s_pendingFrame &frame = ring[nextFrame];
+    if (frame.fence != NULL)
+    {
+        nbDropped++;
+        return;
+    }
+    if (frame.buffer.get() == 0)
+        frame.buffer = BufferHandle::create();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.buffer.get());
+    if (frame.allocatedSize != size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        frame.allocatedSize = size;
+    }
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame.width = width;
+    frame.height = height;
+    nextFrame = (nextFrame + 1) % ring.size();
+}
+
+/*
+    the last frames are waited for, then the encoder finishes writing.
+    the error of the encoder is thrown once the capture is stopped, the counts stay readable
+*/
+void FrameCapture::stop()
+{
+    if (encoder == NULL)
+        return;
+    poll(true);
+    const std::unique_ptr<FrameEncoder> finished = std::move(encoder);
+    try
+    {
+        finished->finish();
+    }
+    catch (...)
+    {
+        nbWritten = finished->getNbWritten();
+        nbDropped += finished->getNbDropped();
+        throw;
+    }
+    nbWritten = finished->getNbWritten();
+    nbDropped += finished->getNbDropped();
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../FrameEncoder/FrameEncoder.hpp"
+#include "../GLHandle/GLHandle.hpp"
+#include <array>
+#include <memory>
+#include <string>
+
+#define CAPTURE_RING_SIZE 3 // frames read back at the same time, a frame is encoded 2 or 3 frames after it's rendered
+#define CAPTURE_ENV "SCOP_CAPTURE" // a path ending with .y4m records a video, any other path is a prefix of PPM files
+#define DEFAULT_CAPTURE_PATH "scop_capture"
+#define CAPTURE_FPS 60 // the frame rate written in a video, whatever the frame mode
+
+/**
+ * records the frames shown in the window without waiting for the GPU.
+ * each frame is copied to a pixel buffer object of a ring and fenced, it's read back a few frames later
+ * once its fence is signaled, then encoded by a background thread.
+ * a frame is dropped instead of stalling the render loop when the ring or the encoder is full
+ */
+class FrameCapture
+{
+  private:
+    FrameCapture(const FrameCapture &copy) = delete;
+    FrameCapture &operator=(const FrameCapture &copy) = delete;
+
+    typedef struct pendingFrame
+    {
+        BufferHandle buffer;
+        size_t allocatedSize;
+        GLsync fence; // NULL when the buffer is free
+        int width;
+        int height;
+    } s_pendingFrame;
+
+    std::array<s_pendingFrame, CAPTURE_RING_SIZE> ring;
+    size_t nextFrame; // the oldest pending frame, and the next one written
+    size_t nbWritten; // of the last capture, once it's stopped
+    size_t nbDropped;
+    std::unique_ptr<FrameEncoder> encoder;
+
+    void readBack(s_pendingFrame &frame);
+    void poll(bool wait);
+
+  public:
+    FrameCapture();
+    ~FrameCapture();
+
+    bool isCapturing() const;
+    size_t getNbWritten() const;
+    size_t getNbDropped() const;
+
+    void start(const std::string &path, int fps);
+    void capture(int width, int height);
+    void stop();
+};
\ No newline at end of file
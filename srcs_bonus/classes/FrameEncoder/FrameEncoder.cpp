@@ -0,0 +1,270 @@
+#include "FrameEncoder.hpp"
+#include <algorithm>
+#include <cstdio>
+
+FrameEncoder::FrameEncoder(const std::string &path, int fps)
+{
+    this->path = path;
+    this->format = getFormat(path);
+    this->fps = std::max(1, fps);
+    stopping = false;
+    nbWritten = 0;
+    nbDropped = 0;
+    streamWidth = 0;
+    streamHeight = 0;
+    thread = std::thread(&FrameEncoder::encoderLoop, this);
+}
+
+/*
+    the frames already pushed are still written
+*/
+FrameEncoder::~FrameEncoder()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    if (thread.joinable())
+        thread.join();
+}
+
+e_captureFormat FrameEncoder::getFormat(const std::string &path)
+{
+    const std::string extension = ".y4m";
+
+    if (path.size() >= extension.size() &&
+        path.compare(path.size() - extension.size(), extension.size(), extension) == 0)
+        return (Y4M_STREAM);
+    return (PPM_SEQUENCE);
+}
+
+std::string FrameEncoder::getFramePath(const std::string &prefix, size_t index)
+{
+    char number[32];
+
+    std::snprintf(number, sizeof(number), "_%05zu.ppm", index);
+    return (prefix + number);
+}
+
+/*
+    the rows are flipped, a PPM starts with the top row.
+    the alpha is dropped
+*/
+std::vector<unsigned char> FrameEncoder::encodePPM(const s_capturedFrame &frame)
+{
+    const std::string header = "P6\n" + std::to_string(frame.width) + " " + std::to_string(frame.height) + "\n255\n";
+    std::vector<unsigned char> file(header.begin(), header.end());
+
+    file.resize(header.size() + static_cast<size_t>(frame.width) * frame.height * 3);
+    unsigned char *output = file.data() + header.size();
+    for (int y = frame.height - 1; y >= 0; y--)
+    {
+        const unsigned char *pixel = frame.pixels.data() + static_cast<size_t>(y) * frame.width * 4;
+        for (int x = 0; x < frame.width; x++, pixel += 4, output += 3)
+            std::copy(pixel, pixel + 3, output);
+    }
+    return (file);
+}
+
+std::string FrameEncoder::getY4MHeader(int width, int height, int fps)
+{
+    return ("YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) + " F" + std::to_string(fps) +
+            ":1 Ip A1:1 C420jpeg\n");
+}
+
+/*
+    full range BT.601, like a JPEG: the luma of every pixel,
+    then the chroma averaged over each block of 2 * 2 pixels (a block can be cut by an odd size).
+    the rows are flipped, a video starts with the top row
+*/
+std::vector<unsigned char> FrameEncoder::encodeY4MFrame(const s_capturedFrame &frame)
+{
+    const std::string header = "FRAME\n";
+    const int chromaWidth = (frame.width + 1) / 2;
+    const int chromaHeight = (frame.height + 1) / 2;
+    const size_t lumaSize = static_cast<size_t>(frame.width) * frame.height;
+    const size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+    std::vector<unsigned char> data(header.begin(), header.end());
+
+    data.resize(header.size() + lumaSize + chromaSize * 2);
+    unsigned char *luma = data.data() + header.size();
+    unsigned char *blue = luma + lumaSize;
+    unsigned char *red = blue + chromaSize;
+    for (int y = 0; y < frame.height; y++)
+    {
+        const unsigned char *row = frame.pixels.data() + static_cast<size_t>(frame.height - 1 - y) * frame.width * 4;
+        for (int x = 0; x < frame.width; x++)
+        {
+            const unsigned char *pixel = row + x * 4;
+            luma[static_cast<size_t>(y) * frame.width + x] =
+                static_cast<unsigned char>(0.299f * pixel[0] + 0.587f * pixel[1] + 0.114f * pixel[2] + 0.5f);
+        }
+    }
+    for (int y = 0; y < chromaHeight; y++)
+    {
+        for (int x = 0; x < chromaWidth; x++)
+        {
+            float sum[3] = {0, 0, 0};
+            int nbPixels = 0;
+            for (int dy = 0; dy < 2 && y * 2 + dy < frame.height; dy++)
+            {
+                for (int dx = 0; dx < 2 && x * 2 + dx < frame.width; dx++)
+                {
+                    const unsigned char *pixel =
+                        frame.pixels.data() +
+                        (static_cast<size_t>(frame.height - 1 - (y * 2 + dy)) * frame.width + x * 2 + dx) * 4;
+                    for (size_t i = 0; i < 3; i++)
+                        sum[i] += pixel[i];
+                    nbPixels++;
+                }
+            }
+            for (size_t i = 0; i < 3; i++)
+                sum[i] /= nbPixels;
+            const float u = 128 - 0.168736f * sum[0] - 0.331264f * sum[1] + 0.5f * sum[2];
+            const float v = 128 + 0.5f * sum[0] - 0.418688f * sum[1] - 0.081312f * sum[2];
+            blue[static_cast<size_t>(y) * chromaWidth + x] =
+                static_cast<unsigned char>(std::clamp(u + 0.5f, 0.0f, 255.0f));
+            red[static_cast<size_t>(y) * chromaWidth + x] =
+                static_cast<unsigned char>(std::clamp(v + 0.5f, 0.0f, 255.0f));
+        }
+    }
+    return (data);
+}
+
+/*
+    the render loop never waits for the encoder, false if the frame is dropped.
+    an offline renderer waits for a free place in the queue instead
+*/
+bool FrameEncoder::push(s_capturedFrame &&frame, bool wait)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (wait)
+            queueFreed.wait(lock, [this]() { return (stopping || error || frames.size() < CAPTURE_QUEUE_SIZE); });
+        if (stopping || error || frames.size() >= CAPTURE_QUEUE_SIZE)
+        {
+            nbDropped++;
+            return (false);
+        }
+        frames.push_back(std::move(frame));
+    }
+    wakeUp.notify_one();
+    return (true);
+}
+
+/*
+    waits for the frames already pushed, then throws the error of the encoder if it stopped on one
+*/
+void FrameEncoder::finish()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    if (thread.joinable())
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void FrameEncoder::encoderLoop()
+{
+    while (true)
+    {
+        s_capturedFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this]() { return (stopping || !frames.empty()); });
+            if (frames.empty())
+                return;
+            frame = std::move(frames.front());
+            frames.pop_front();
+        }
+        queueFreed.notify_all();
+        try
+        {
+            write(frame);
+        }
+        catch (...)
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            nbDropped += frames.size() + 1;
+            frames.clear();
+            queueFreed.notify_all();
+            return;
+        }
+    }
+}
+
+void FrameEncoder::write(const s_capturedFrame &frame)
+{
+    if (format == PPM_SEQUENCE)
+    {
+        const std::vector<unsigned char> file = encodePPM(frame);
+        const std::string framePath = getFramePath(path, nbWritten);
+        std::ofstream output(framePath, std::ios::binary);
+        if (!output.is_open())
+            throw(Exception("WRITE", "OPEN_FAILED", framePath));
+        output.write(reinterpret_cast<const char *>(file.data()), file.size());
+        if (!output.good())
+            throw(Exception("WRITE", "WRITE_FAILED", framePath));
+    }
+    else
+    {
+        if (!stream.is_open())
+        {
+            stream.open(path, std::ios::binary);
+            if (!stream.is_open())
+                throw(Exception("WRITE", "OPEN_FAILED", path));
+            streamWidth = frame.width;
+            streamHeight = frame.height;
+            stream << getY4MHeader(streamWidth, streamHeight, fps);
+        }
+        if (frame.width != streamWidth || frame.height != streamHeight)
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            nbDropped++;
+            return;
+        }
+        const std::vector<unsigned char> data = encodeY4MFrame(frame);
+        stream.write(reinterpret_cast<const char *>(data.data()), data.size());
+        if (!stream.good())
+            throw(Exception("WRITE", "WRITE_FAILED", path));
+    }
+    const std::lock_guard<std::mutex> lock(mutex);
+    nbWritten++;
+}
+
+e_captureFormat FrameEncoder::getFormat() const
+{
+    return (format);
+}
+
+size_t FrameEncoder::getNbWritten()
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    return (nbWritten);
+}
+
+size_t FrameEncoder::getNbDropped()
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    return (nbDropped);
+}
+
+FrameEncoder::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                   const std::string &path)
+{
+    this->errorMessage = "FRAME_ENCODER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + path + "\n|";
+}
+
+const char *FrameEncoder::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
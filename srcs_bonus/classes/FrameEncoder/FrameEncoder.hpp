@@ -0,0 +1,87 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define CAPTURE_QUEUE_SIZE 8 // frames waiting for the encoder, a frame captured while the queue is full is dropped
+
+typedef enum captureFormat
+{
+    PPM_SEQUENCE, // one binary PPM (P6) per frame: prefix_00000.ppm, prefix_00001.ppm...
+    Y4M_STREAM    // a single raw YUV 4:2:0 video, readable by ffmpeg and most players
+} e_captureFormat;
+
+// the pixels of a frame as read by OpenGL: RGBA, the bottom row first
+typedef struct capturedFrame
+{
+    int width;
+    int height;
+    std::vector<unsigned char> pixels;
+} s_capturedFrame;
+
+/**
+ * writes the captured frames from a background thread, so the render loop never waits for the disk.
+ * the frames are encoded in the order they are pushed, a frame is dropped instead of blocking
+ * the render loop when the encoder is late. a video keeps the size of its first frame,
+ * the frames of another size (after a resize of the window) are dropped.
+ * an error of the encoder stops it, it's thrown again by finish
+ */
+class FrameEncoder
+{
+  private:
+    FrameEncoder() = delete;
+    FrameEncoder(const FrameEncoder &copy) = delete;
+    FrameEncoder &operator=(const FrameEncoder &copy) = delete;
+
+    std::string path;
+    e_captureFormat format;
+    int fps;
+    std::deque<s_capturedFrame> frames;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable queueFreed;
+    bool stopping;
+    std::exception_ptr error;
+    size_t nbWritten;
+    size_t nbDropped;
+    std::ofstream stream; // the video, only used by the encoder thread
+    int streamWidth;
+    int streamHeight;
+    std::thread thread;
+
+    void encoderLoop();
+    void write(const s_capturedFrame &frame);
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &path);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    FrameEncoder(const std::string &path, int fps);
+    ~FrameEncoder();
+
+    static e_captureFormat getFormat(const std::string &path);
+    static std::string getFramePath(const std::string &prefix, size_t index);
+    static std::vector<unsigned char> encodePPM(const s_capturedFrame &frame);
+    static std::string getY4MHeader(int width, int height, int fps);
+    static std::vector<unsigned char> encodeY4MFrame(const s_capturedFrame &frame);
+
+    bool push(s_capturedFrame &&frame, bool wait = false);
+    void finish();
+
+    e_captureFormat getFormat() const;
+    size_t getNbWritten();
+    size_t getNbDropped();
+};
\ No newline at end of file
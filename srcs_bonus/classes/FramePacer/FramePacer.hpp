@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+
+#define DEFAULT_FIXED_FPS 60
+#define SPIN_DURATION 0.002 // the end of a wait is spent spinning, a sleep can be late by ~1ms
+
+typedef enum frameMode
+{
+    VSYNC_MODE,
+    UNCAPPED_MODE,
+    FIXED_FPS_MODE
+} e_frameMode;
+
+/**
+ * decides when the next frame starts.
+ * with vsync the swap of the buffers already waits for the screen,
+ * with a fixed frame rate the pacer sleeps until the next frame.
+ * in idle mode a frame without change isn't rendered, the window waits for the next event
+ */
+class FramePacer
+{
+  private:
+    e_frameMode mode;
+    double frameDuration;
+    bool idleMode;
+    double nextFrame;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, double value);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    FramePacer();
+    FramePacer(e_frameMode mode, double fps, bool idleMode);
+    FramePacer(const FramePacer &copy);
+    FramePacer &operator=(const FramePacer &copy);
+    ~FramePacer();
+
+    e_frameMode getMode() const;
+    std::string getModeName() const;
+    double getFPS() const;
+    bool isIdleMode() const;
+    bool isVsync() const;
+    bool canWaitEvents(bool changed, bool inputHeld) const;
+
+    void setMode(e_frameMode mode);
+    void setFPS(double fps);
+    void setIdleMode(bool idleMode);
+    void nextMode();
+
+    void waitNextFrame(bool rendered);
+    static double getTime();
+    static void sleepUntil(double time);
+};
\ No newline at end of file
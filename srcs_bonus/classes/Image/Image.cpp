@@ -0,0 +1,257 @@
+#include "Image.hpp"
+#include "../Utils/Utils.hpp"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <vector>
+
+Image::Image(const std::string &path)
+{
+    width = 0;
+    height = 0;
+    valueMax = 0;
+    channels = 0;
+    pixels = nullptr;
+    loadImage(path);
+}
+
+Image::Image(const Image &copy)
+{
+    *this = copy;
+}
+
+Image &Image::operator=(const Image &copy)
+{
+    if (&copy != this)
+    {
+        file.reset();
+        format = copy.getFormat();
+        width = copy.getWidth();
+        height = copy.getHeight();
+        valueMax = 255;
+        channels = copy.getChannels();
+        data = std::make_unique<unsigned char[]>(copy.getSize());
+        std::copy(copy.getPixels(), copy.getPixels() + copy.getSize(), data.get());
+        pixels = data.get();
+    }
+    return (*this);
+}
+
+Image::~Image()
+{
+}
+
+/*
+    a PNM file is a magic number (P3, P5 or P6), the width, the height and the max value of a sample,
+    separated by spaces and comments, followed by the pixels:
+    - P3: ascii values separated by spaces
+    - P5/P6: raw bytes (1 byte per sample if the max value is < 256, 2 bytes big endian otherwise),
+      just after a single space
+*/
+void Image::loadImage(const std::string &path)
+{
+    file = std::make_unique<MappedFile>(path);
+
+    const unsigned char *begin = file->getData();
+    const unsigned char *end = begin + file->getSize();
+    const unsigned char *cursor = readHeader(begin, end);
+
+    if (format == ASCII_RGB)
+        readAsciiPixels(cursor, end);
+    else
+        readBinaryPixels(cursor, end);
+
+    // the mapped file is only needed when the pixels point into it
+    if (data != nullptr)
+        file.reset();
+}
+
+const unsigned char *Image::readHeader(const unsigned char *cursor, const unsigned char *end)
+{
+    unsigned int value;
+
+    if (end - cursor < 2 || cursor[0] != 'P' || (cursor[1] != '3' && cursor[1] != '5' && cursor[1] != '6'))
+        throw(Exception("READ_HEADER", "INVALID_MAGIC_NUMBER", *file, cursor));
+    format = (cursor[1] == '3') ? ASCII_RGB : (cursor[1] == '5') ? BINARY_GRAY : BINARY_RGB;
+    channels = (format == BINARY_GRAY) ? 1 : 3;
+    cursor += 2;
+    if (cursor != end && !isSpace(*cursor) && *cursor != '#')
+        throw(Exception("READ_HEADER", "INVALID_MAGIC_NUMBER", *file, cursor));
+
+    cursor = readNumber(cursor, end, value);
+    if (value == 0 || value > INT_MAX / 4)
+        throw(Exception("READ_HEADER", "INVALID_WIDTH", *file, cursor));
+    width = value;
+    cursor = readNumber(cursor, end, value);
+    if (value == 0 || value > INT_MAX / 4)
+        throw(Exception("READ_HEADER", "INVALID_HEIGHT", *file, cursor));
+    height = value;
+    cursor = readNumber(cursor, end, value);
+    if (value == 0 || value > 65535)
+        throw(Exception("READ_HEADER", "INVALID_VALUE_MAX", *file, cursor));
+    valueMax = value;
+    return (cursor);
+}
+
+/*
+    each sample takes at least 2 bytes (a separator and a digit),
+    so a header bigger than the file is rejected before the pixels are allocated
+*/
+void Image::readAsciiPixels(const unsigned char *cursor, const unsigned char *end)
+{
+    const size_t size = getSize();
+    unsigned int value;
+
+    if (static_cast<size_t>(end - cursor) / 2 < size)
+        throw(Exception("READ_ASCII_PIXELS", "MISSING_PIXELS", *file, cursor));
+
+    std::vector<unsigned char> scale(valueMax + 1);
+    for (unsigned int i = 0; i <= valueMax; i++)
+        scale[i] = (i * 255 + valueMax / 2) / valueMax;
+
+    data = std::make_unique<unsigned char[]>(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        cursor = readNumber(cursor, end, value);
+        if (value > valueMax)
+            throw(Exception("READ_ASCII_PIXELS", "INVALID_VALUE", *file, cursor));
+        data[i] = scale[value];
+    }
+    if (skipSpaces(cursor, end) != end)
+        throw(Exception("READ_ASCII_PIXELS", "TOO_MANY_VALUES", *file, cursor));
+    pixels = data.get();
+}
+
+void Image::readBinaryPixels(const unsigned char *cursor, const unsigned char *end)
+{
+    const size_t bytesPerSample = (valueMax > 255) ? 2 : 1;
+
+    if (cursor == end || !isSpace(*cursor))
+        throw(Exception("READ_BINARY_PIXELS", "MISSING_SEPARATOR", *file, cursor));
+    cursor++;
+    if (static_cast<size_t>(end - cursor) < getSize() * bytesPerSample)
+        throw(Exception("READ_BINARY_PIXELS", "MISSING_PIXELS", *file, cursor));
+
+    if (valueMax == 255)
+        pixels = cursor;
+    else
+        scalePixels(cursor, bytesPerSample);
+}
+
+void Image::scalePixels(const unsigned char *cursor, size_t bytesPerSample)
+{
+    const size_t size = getSize();
+
+    std::vector<unsigned char> scale(valueMax + 1);
+    for (unsigned int i = 0; i <= valueMax; i++)
+        scale[i] = (i * 255 + valueMax / 2) / valueMax;
+
+    data = std::make_unique<unsigned char[]>(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        unsigned int value = cursor[i * bytesPerSample];
+        if (bytesPerSample == 2)
+            value = (value << 8) | cursor[i * bytesPerSample + 1];
+        if (value > valueMax)
+            throw(Exception("SCALE_PIXELS", "INVALID_VALUE", *file, cursor + i * bytesPerSample));
+        data[i] = scale[value];
+    }
+    pixels = data.get();
+}
+
+bool Image::isSpace(unsigned char c)
+{
+    return (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+}
+
+const unsigned char *Image::skipSpaces(const unsigned char *cursor, const unsigned char *end)
+{
+    while (cursor != end)
+    {
+        if (*cursor == '#')
+        {
+            while (cursor != end && *cursor != '\n')
+                cursor++;
+        }
+        else if (isSpace(*cursor))
+        {
+            const std::string_view text(reinterpret_cast<const char *>(cursor), end - cursor);
+            cursor += Utils::skipSeparators(text, 0);
+        }
+        else
+            break;
+    }
+    return (cursor);
+}
+
+const unsigned char *Image::readNumber(const unsigned char *cursor, const unsigned char *end, unsigned int &value)
+{
+    cursor = skipSpaces(cursor, end);
+    if (cursor == end || *cursor < '0' || *cursor > '9')
+        throw(Exception("READ_NUMBER", "INVALID_NUMBER", *file, cursor));
+
+    const std::from_chars_result result =
+        std::from_chars(reinterpret_cast<const char *>(cursor), reinterpret_cast<const char *>(end), value);
+    if (result.ec != std::errc())
+        throw(Exception("READ_NUMBER", "NUMBER_TOO_BIG", *file, cursor));
+    cursor = reinterpret_cast<const unsigned char *>(result.ptr);
+    if (cursor != end && !isSpace(*cursor) && *cursor != '#')
+        throw(Exception("READ_NUMBER", "INVALID_NUMBER", *file, cursor));
+    return (cursor);
+}
+
+e_imageFormat Image::getFormat() const
+{
+    return (format);
+}
+
+int Image::getWidth() const
+{
+    return (width);
+}
+
+int Image::getHeight() const
+{
+    return (height);
+}
+
+unsigned int Image::getChannels() const
+{
+    return (channels);
+}
+
+size_t Image::getSize() const
+{
+    return (static_cast<size_t>(width) * height * channels);
+}
+
+const unsigned char *Image::getPixels() const
+{
+    return (pixels);
+}
+
+/*
+    the line is only looked for when an error happens,
+    so the pixels don't need to be read line by line
+*/
+Image::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                            const MappedFile &file, const unsigned char *position)
+{
+    const unsigned char *begin = file.getData();
+    const unsigned char *end = begin + file.getSize();
+    const unsigned int lineIndex = std::count(begin, position, '\n') + 1;
+    const unsigned char *lineBegin = position;
+    while (lineBegin != begin && lineBegin[-1] != '\n')
+        lineBegin--;
+    const unsigned char *lineEnd = (end - lineBegin > 80) ? lineBegin + 80 : end;
+    lineEnd = std::find(lineBegin, lineEnd, '\n');
+
+    this->errorMessage = "IMAGE::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + file.getPath() + ":" + std::to_string(lineIndex) + ": ";
+    this->errorMessage += std::string(lineBegin, lineEnd) + "\n|";
+}
+
+const char *Image::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
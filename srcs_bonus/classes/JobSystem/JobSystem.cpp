@@ -0,0 +1,251 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+
+thread_local const JobSystem *JobSystem::currentSystem = nullptr;
+thread_local size_t JobSystem::currentQueue = 0;
+
+JobSystem::Group::Group() : nbPending(0)
+{
+}
+
+JobSystem::Graph::Graph()
+{
+}
+
+/*
+    the dependencies are jobs already added, so a graph can't have a cycle
+*/
+size_t JobSystem::Graph::add(const std::function<void()> &task, const std::vector<size_t> &dependencies)
+{
+    const size_t index = nodes.size();
+
+    for (size_t i = 0; i < dependencies.size(); i++)
+    {
+        if (dependencies[i] >= index)
+            throw(Exception("ADD", "INVALID_DEPENDENCY", std::to_string(dependencies[i]) + " in a graph of " +
+                                                             std::to_string(index) + " jobs"));
+    }
+    s_node &node = nodes.emplace_back();
+    node.task = task;
+    node.nbDependencies = dependencies.size();
+    for (size_t i = 0; i < dependencies.size(); i++)
+        nodes[dependencies[i]].dependents.push_back(index);
+    return (index);
+}
+
+size_t JobSystem::Graph::getSize() const
+{
+    return (nodes.size());
+}
+
+/*
+    the calling thread also runs jobs while it waits, the pool has one thread less than the cores
+*/
+JobSystem::JobSystem(size_t nbWorkers) : nbQueued(0), stopping(false)
+{
+    for (size_t i = 0; i <= nbWorkers; i++)
+        queues.push_back(std::make_unique<s_queue>());
+    for (size_t i = 1; i <= nbWorkers; i++)
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        const std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+JobSystem &JobSystem::getShared()
+{
+    static JobSystem shared(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+    return (shared);
+}
+
+size_t JobSystem::getNbThreads() const
+{
+    return (workers.size() + 1);
+}
+
+void JobSystem::run(Group &group, const std::function<void()> &task)
+{
+    s_queue &queue = *queues[getQueueIndex()];
+
+    group.nbPending++;
+    {
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back({task, &group});
+    }
+    nbQueued++;
+    // taken and released so a worker can't miss the job between its check and its sleep
+    {
+        const std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_one();
+}
+
+void JobSystem::wait(Group &group)
+{
+    while (group.nbPending.load() != 0)
+    {
+        if (!runOneJob())
+            std::this_thread::yield();
+    }
+    if (group.exception)
+    {
+        std::exception_ptr exception = group.exception;
+        group.exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+/*
+    the jobs without dependency start first, a job starts the dependents it was the last to wait for.
+    the dependents of a job that throws never start
+*/
+void JobSystem::run(Graph &graph)
+{
+    Group group;
+
+    for (size_t i = 0; i < graph.nodes.size(); i++)
+        graph.nodes[i].nbWaited = graph.nodes[i].nbDependencies;
+    for (size_t i = 0; i < graph.nodes.size(); i++)
+    {
+        if (graph.nodes[i].nbDependencies == 0)
+            run(group, [this, &graph, i, &group]() { runNode(graph, i, group); });
+    }
+    wait(group);
+}
+
+/*
+    the loop is cut in ranges of at least grainSize indices, the calling thread takes its share while it waits
+*/
+void JobSystem::parallelFor(size_t size, size_t grainSize, const std::function<void(size_t, size_t)> &task)
+{
+    const size_t nbChunks =
+        std::min(size / std::max(grainSize, static_cast<size_t>(1)), getNbThreads() * JOB_CHUNKS_PER_THREAD);
+
+    if (nbChunks <= 1)
+    {
+        if (size != 0)
+            task(0, size);
+        return;
+    }
+    Group group;
+    for (size_t i = 0; i < nbChunks; i++)
+        run(group, [&task, size, nbChunks, i]() { task(size * i / nbChunks, size * (i + 1) / nbChunks); });
+    wait(group);
+}
+
+void JobSystem::workerLoop(size_t queueIndex)
+{
+    currentSystem = this;
+    currentQueue = queueIndex;
+    while (true)
+    {
+        if (runOneJob())
+            continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return (stopping || nbQueued.load() != 0); });
+        if (stopping && nbQueued.load() == 0)
+            return;
+    }
+}
+
+/*
+    a thread of another job system (or outside any) uses the shared deque 0
+*/
+size_t JobSystem::getQueueIndex() const
+{
+    return ((currentSystem == this) ? currentQueue : 0);
+}
+
+/*
+    the newest job of its own deque, or the oldest job of the next deque that has one
+*/
+bool JobSystem::popJob(s_job &job)
+{
+    const size_t own = getQueueIndex();
+
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        s_queue &queue = *queues[(own + i) % queues.size()];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+        if (i == 0)
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        }
+        else
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+        nbQueued--;
+        return (true);
+    }
+    return (false);
+}
+
+bool JobSystem::runOneJob()
+{
+    s_job job;
+
+    if (nbQueued.load() == 0 || !popJob(job))
+        return (false);
+    execute(job);
+    return (true);
+}
+
+/*
+    the exception is kept for the thread waiting for the group, the job is done anyway
+*/
+void JobSystem::execute(s_job &job)
+{
+    try
+    {
+        job.task();
+    }
+    catch (...)
+    {
+        const std::lock_guard<std::mutex> lock(job.group->exceptionMutex);
+        if (!job.group->exception)
+            job.group->exception = std::current_exception();
+    }
+    job.group->nbPending--;
+}
+
+/*
+    the dependents are started before this job is counted as done, so the group never reaches 0 too early
+*/
+void JobSystem::runNode(Graph &graph, size_t index, Group &group)
+{
+    Graph::s_node &node = graph.nodes[index];
+
+    node.task();
+    for (size_t i = 0; i < node.dependents.size(); i++)
+    {
+        const size_t dependent = node.dependents[i];
+        if (--graph.nodes[dependent].nbWaited == 0)
+            run(group, [this, &graph, dependent, &group]() { runNode(graph, dependent, group); });
+    }
+}
+
+JobSystem::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                const std::string &context)
+{
+    this->errorMessage = "JOB_SYSTEM::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + context + "\n|";
+}
+
+const char *JobSystem::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define JOB_CHUNKS_PER_THREAD 4 // a parallel loop is cut in more jobs than threads, so the fast threads steal the rest
+
+/**
+ * pool of worker threads, each with its own deque of jobs.
+ * a thread pushes and pops its jobs at the back of its deque (the last job pushed is still in the cache),
+ * a thread without jobs steals the oldest job at the front of another deque.
+ * a thread waiting for jobs runs other jobs in the meantime,
+ * so a job can start jobs and wait for them without blocking a worker.
+ * the threads outside the pool (the main thread) share the deque 0
+ */
+class JobSystem
+{
+  public:
+    // jobs waited together, the first exception thrown by one of them is thrown again by wait
+    class Group
+    {
+      private:
+        Group(const Group &copy) = delete;
+        Group &operator=(const Group &copy) = delete;
+
+        std::atomic<size_t> nbPending;
+        std::mutex exceptionMutex;
+        std::exception_ptr exception;
+
+        friend class JobSystem;
+
+      public:
+        Group();
+    };
+
+    // jobs that start once the jobs they depend on are done, a job only depends on jobs added before it
+    class Graph
+    {
+      private:
+        Graph(const Graph &copy) = delete;
+        Graph &operator=(const Graph &copy) = delete;
+
+        typedef struct node
+        {
+            std::function<void()> task;
+            std::vector<size_t> dependents;
+            size_t nbDependencies;
+            std::atomic<size_t> nbWaited; // dependencies not done yet during a run
+        } s_node;
+
+        std::deque<s_node> nodes;
+
+        friend class JobSystem;
+
+      public:
+        Graph();
+
+        size_t add(const std::function<void()> &task, const std::vector<size_t> &dependencies = {});
+        size_t getSize() const;
+    };
+
+  private:
+    JobSystem() = delete;
+    JobSystem(const JobSystem &copy) = delete;
+    JobSystem &operator=(const JobSystem &copy) = delete;
+
+    typedef struct job
+    {
+        std::function<void()> task;
+        Group *group;
+    } s_job;
+
+    typedef struct queue
+    {
+        std::mutex mutex;
+        std::deque<s_job> jobs;
+    } s_queue;
+
+    std::vector<std::unique_ptr<s_queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nbQueued;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    bool stopping;
+
+    static thread_local const JobSystem *currentSystem;
+    static thread_local size_t currentQueue;
+
+    void workerLoop(size_t queueIndex);
+    size_t getQueueIndex() const;
+    bool popJob(s_job &job);
+    bool runOneJob();
+    void execute(s_job &job);
+    void runNode(Graph &graph, size_t index, Group &group);
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &context);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    JobSystem(size_t nbWorkers);
+    ~JobSystem();
+
+    static JobSystem &getShared();
+
+    size_t getNbThreads() const;
+
+    void run(Group &group, const std::function<void()> &task);
+    void wait(Group &group);
+    void run(Graph &graph);
+    void parallelFor(size_t size, size_t grainSize, const std::function<void(size_t, size_t)> &task);
+};
\ No newline at end of file
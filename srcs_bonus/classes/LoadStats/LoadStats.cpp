@@ -0,0 +1,247 @@
+#include "LoadStats.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+
+bool LoadStats::enabled = false;
+std::mutex LoadStats::mutex;
+std::map<std::string, size_t, std::less<>> LoadStats::symbols;
+std::array<size_t, NB_LOAD_COUNTERS> LoadStats::counters = {};
+std::array<s_stageStats, NB_LOAD_STAGES> LoadStats::stages = {};
+thread_local std::array<s_stageStats, NB_LOAD_STAGES> LoadStats::spans = {};
+thread_local std::array<size_t, NB_LOAD_COUNTERS> LoadStats::pendingCounters = {};
+const std::array<const char *, NB_LOAD_STAGES> LoadStats::stageNames = {
+    "readFile",        "parse",  "combineVertices", "triangulate", "generateFacesColor",
+    "generateNormals", "upload", "compileShaders"};
+const std::array<const char *, NB_LOAD_COUNTERS> LoadStats::counterNames = {
+    "uniqueVertices", "dedupHits", "uniqueColoredVertices", "coloredDedupHits",
+    "earsClipped",    "triangles", "bytesUploaded",         "programCacheHits",
+    "textureContainers"};
+
+LoadStats::Stage::Stage(e_loadStage stage)
+{
+    this->stage = stage;
+    start = (enabled) ? getTime() : 0;
+}
+
+LoadStats::Stage::~Stage()
+{
+    end();
+}
+
+void LoadStats::Stage::end()
+{
+    if (start == 0)
+        return;
+    const std::lock_guard<std::mutex> lock(mutex);
+    stages[stage].calls++;
+    stages[stage].wallTime += getTime() - start;
+    stages[stage].peakRSS = getPeakRSS();
+    mergeCounters();
+    start = 0;
+}
+
+LoadStats::Span::Span(e_loadStage stage)
+{
+    this->stage = stage;
+    start = (enabled) ? getTime() : 0;
+}
+
+LoadStats::Span::~Span()
+{
+    if (start == 0)
+        return;
+    spans[stage].calls++;
+    spans[stage].wallTime += getTime() - start;
+}
+
+double LoadStats::getTime()
+{
+    return (std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/*
+    the counters added up by this thread are moved to the stats, the mutex must be locked
+*/
+void LoadStats::mergeCounters()
+{
+    for (size_t i = 0; i < NB_LOAD_COUNTERS; i++)
+        counters[i] += pendingCounters[i];
+    pendingCounters.fill(0);
+}
+
+bool LoadStats::isEnabled()
+{
+    return (enabled);
+}
+
+void LoadStats::setEnabled(bool enabled)
+{
+    LoadStats::enabled = enabled;
+}
+
+void LoadStats::reset()
+{
+    symbols.clear();
+    counters.fill(0);
+    stages.fill({0, 0, 0});
+    spans.fill({0, 0, 0});
+    pendingCounters.fill(0);
+}
+
+void LoadStats::countSymbol(std::string_view symbol)
+{
+    if (!enabled || symbol.empty())
+        return;
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto it = symbols.find(symbol);
+    if (it == symbols.end())
+        it = symbols.emplace(symbol, 0).first;
+    it->second++;
+}
+
+void LoadStats::add(e_loadCounter counter, size_t value)
+{
+    if (!enabled)
+        return;
+    pendingCounters[counter] += value;
+}
+
+/*
+    the spans of the stage measured by this thread become a single call, its counters are merged
+*/
+void LoadStats::flush(e_loadStage stage)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    mergeCounters();
+    if (spans[stage].calls == 0)
+        return;
+    stages[stage].calls++;
+    stages[stage].wallTime += spans[stage].wallTime;
+    stages[stage].peakRSS = getPeakRSS();
+    spans[stage] = {0, 0, 0};
+}
+
+size_t LoadStats::getSymbolCount(const std::string &symbol)
+{
+    auto it = symbols.find(symbol);
+    if (it == symbols.end())
+        return (0);
+    return (it->second);
+}
+
+size_t LoadStats::getCounter(e_loadCounter counter)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    mergeCounters();
+    return (counters[counter]);
+}
+
+s_stageStats LoadStats::getStage(e_loadStage stage)
+{
+    return (stages[stage]);
+}
+
+/*
+    ru_maxrss is in kilobytes on Linux
+*/
+long LoadStats::getPeakRSS()
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return (0);
+    return (usage.ru_maxrss);
+}
+
+std::string LoadStats::toText()
+{
+    std::ostringstream text;
+    const std::lock_guard<std::mutex> lock(mutex);
+    mergeCounters();
+
+    text << "load stats:" << std::endl;
+    for (size_t i = 0; i < NB_LOAD_STAGES; i++)
+    {
+        text << "  " << stageNames[i] << ": " << stages[i].wallTime * 1000 << " ms, " << stages[i].calls
+             << " calls, peak RSS " << stages[i].peakRSS << " KB" << std::endl;
+    }
+    for (size_t i = 0; i < NB_LOAD_COUNTERS; i++)
+        text << "  " << counterNames[i] << ": " << counters[i] << std::endl;
+    for (auto it = symbols.begin(); it != symbols.end(); it++)
+        text << "  lines \"" << it->first << "\": " << it->second << std::endl;
+    return (text.str());
+}
+
+/*
+    the symbols come from the file, the characters that can't be in a JSON string are escaped
+*/
+std::string LoadStats::toJSON()
+{
+    std::ostringstream json;
+    const std::lock_guard<std::mutex> lock(mutex);
+    mergeCounters();
+
+    json << "{\"stages\":{";
+    for (size_t i = 0; i < NB_LOAD_STAGES; i++)
+    {
+        json << ((i == 0) ? "" : ",") << "\"" << stageNames[i] << "\":{\"wallTimeMs\":" << stages[i].wallTime * 1000
+             << ",\"calls\":" << stages[i].calls << ",\"peakRSSKB\":" << stages[i].peakRSS << "}";
+    }
+    json << "},\"counters\":{";
+    for (size_t i = 0; i < NB_LOAD_COUNTERS; i++)
+        json << ((i == 0) ? "" : ",") << "\"" << counterNames[i] << "\":" << counters[i];
+    json << "},\"lines\":{";
+    for (auto it = symbols.begin(); it != symbols.end(); it++)
+    {
+        json << ((it == symbols.begin()) ? "" : ",") << "\"";
+        for (size_t i = 0; i < it->first.size(); i++)
+        {
+            const unsigned char c = it->first[i];
+            if (c == '"' || c == '\\')
+                json << '\\' << c;
+            else if (c < 0x20)
+                json << "\\u00" << "0123456789abcdef"[c >> 4] << "0123456789abcdef"[c & 0xf];
+            else
+                json << c;
+        }
+        json << "\":" << it->second;
+    }
+    json << "}}" << std::endl;
+    return (json.str());
+}
+
+void LoadStats::report()
+{
+    const char *output = std::getenv(LOAD_STATS_ENV);
+
+    if (!enabled || output == NULL)
+        return;
+    const std::string path = output;
+    if (path.size() < 5 || path.compare(path.size() - 5, 5, ".json") != 0)
+    {
+        std::cout << toText();
+        return;
+    }
+    std::ofstream file(path);
+    if (!file.is_open())
+        throw(Exception("REPORT", "OPEN_FAILED", path + ": " + strerror(errno)));
+    file << toJSON();
+}
+
+LoadStats::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                const std::string &path)
+{
+    this->errorMessage = "LOAD_STATS::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + path + "\n|";
+}
+
+const char *LoadStats::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
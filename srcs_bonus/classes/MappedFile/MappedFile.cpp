@@ -0,0 +1,74 @@
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &path)
+{
+    struct stat fileInfo;
+    int fd;
+
+    this->path = path;
+    data = nullptr;
+    size = 0;
+
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw(Exception("MAP_FILE", "OPEN_FAILED", path));
+    if (fstat(fd, &fileInfo) == -1)
+    {
+        Exception error("MAP_FILE", "STAT_FAILED", path);
+        close(fd);
+        throw(error);
+    }
+    size = fileInfo.st_size;
+    if (size > 0)
+    {
+        void *address = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            Exception error("MAP_FILE", "MMAP_FAILED", path);
+            close(fd);
+            throw(error);
+        }
+        madvise(address, size, MADV_SEQUENTIAL);
+        data = static_cast<const unsigned char *>(address);
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+        munmap(const_cast<unsigned char *>(data), size);
+}
+
+std::string MappedFile::getPath() const
+{
+    return (path);
+}
+
+const unsigned char *MappedFile::getData() const
+{
+    return (data);
+}
+
+size_t MappedFile::getSize() const
+{
+    return (size);
+}
+
+MappedFile::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                 const std::string &path)
+{
+    this->errorMessage = "MAPPED_FILE::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + path + ": " + std::strerror(errno) + "\n|";
+}
+
+const char *MappedFile::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * read-only view of a whole file mapped in memory.
+ * the pages are loaded by the kernel when they are read,
+ * so nothing is copied before the data is used
+ */
+class MappedFile
+{
+  private:
+    MappedFile() = delete;
+    MappedFile(const MappedFile &copy) = delete;
+    MappedFile &operator=(const MappedFile &copy) = delete;
+
+    std::string path;
+    const unsigned char *data;
+    size_t size;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &path);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    MappedFile(const std::string &path);
+    ~MappedFile();
+
+    std::string getPath() const;
+    const unsigned char *getData() const;
+    size_t getSize() const;
+};
@@ -17,6 +17,8 @@ Material::Material(const MaterialData &materialData)
     specularExponent = materialData.getSpecularExponent();
     opacity = materialData.getOpacity();
     illum = materialData.getIllum();
+    for (size_t i = 0; i < 3; i++)
+        textureMaps[i] = materialData.getTextureMap(i);
 }
 
 Material::Material(const Material &copy)
@@ -37,6 +39,8 @@ Material &Material::operator=(const Material &copy)
         specularExponent = copy.getSpecularExponent();
         opacity = copy.getOpacity();
         illum = copy.getIllum();
+        for (size_t i = 0; i < 3; i++)
+            textureMaps[i] = copy.getTextureMap(i);
     }
     return (*this);
 }
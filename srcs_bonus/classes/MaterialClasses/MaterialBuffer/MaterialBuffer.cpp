@@ -0,0 +1,99 @@
+#include "MaterialBuffer.hpp"
+#include "../../../../libs/glad/glad.h"
+#include "../../ObjectClasses/ObjectData/ObjectData.hpp"
+#include "../MaterialRegistry/MaterialRegistry.hpp"
+
+/*
+    NO_MATERIAL is the default material.
+    a material without texture map uses the first layer, the default texture
+*/
+MaterialBuffer::MaterialBuffer(const std::vector<unsigned int> &materialIDs, const TextureArray &textures)
+{
+    std::vector<s_materialBlock> blocks;
+
+    for (size_t i = 0; i < materialIDs.size(); i++)
+    {
+        if (indices.find(materialIDs[i]) != indices.end())
+            continue;
+        const Material material =
+            (materialIDs[i] == NO_MATERIAL) ? Material() : MaterialRegistry::getMaterial(materialIDs[i]);
+        const std::string textureMap = getTextureMap(material);
+
+        indices[materialIDs[i]] = blocks.size();
+        blocks.push_back(packMaterial(material, textureMap.empty() ? 0 : textures.getLayer(textureMap)));
+    }
+    if (blocks.size() > MAX_MATERIALS)
+        throw(Exception("MATERIAL_BUFFER", "TOO_MANY_MATERIALS", std::to_string(blocks.size())));
+    if (blocks.empty())
+        blocks.push_back(packMaterial(Material(), 0));
+
+    buffer = BufferHandle::create();
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer.get());
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(s_materialBlock) * MAX_MATERIALS, NULL, GL_STATIC_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(s_materialBlock) * blocks.size(), blocks.data());
+    glBindBufferBase(GL_UNIFORM_BUFFER, MATERIAL_BINDING, buffer.get());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/*
+    the diffuse map is used first, the ambiant map otherwise.
+    empty if the material has no map
+*/
+std::string MaterialBuffer::getTextureMap(const Material &material)
+{
+    if (!material.getTextureMap(DIFFUSE_COLOR).empty())
+        return (material.getTextureMap(DIFFUSE_COLOR));
+    return (material.getTextureMap(AMBIANT_COLOR));
+}
+
+s_materialBlock MaterialBuffer::packMaterial(const Material &material, int textureLayer)
+{
+    s_materialBlock block;
+    float *colors[3];
+
+    colors[AMBIANT_COLOR] = block.ambiantColor;
+    colors[SPECULAR_COLOR] = block.specularColor;
+    colors[DIFFUSE_COLOR] = block.diffuseColor;
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        const std::array<float, 3> color = material.getColor(i);
+        for (size_t j = 0; j < 3; j++)
+            colors[i][j] = color[j];
+        colors[i][3] = 1;
+    }
+    block.parameters[0] = material.getSpecularExponent();
+    block.parameters[1] = material.getOpacity();
+    block.parameters[2] = textureLayer;
+    block.parameters[3] = 0;
+    return (block);
+}
+
+unsigned int MaterialBuffer::getID() const
+{
+    return (buffer.get());
+}
+
+size_t MaterialBuffer::getNbMaterials() const
+{
+    return (indices.size());
+}
+
+int MaterialBuffer::getIndex(unsigned int materialID) const
+{
+    auto it = indices.find(materialID);
+    if (it == indices.end())
+        throw(Exception("GET_INDEX", "UNKNOWN_MATERIAL", std::to_string(materialID)));
+    return (it->second);
+}
+
+MaterialBuffer::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                     const std::string &context)
+{
+    this->errorMessage = "MATERIAL_BUFFER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + context + "\n|";
+}
+
+const char *MaterialBuffer::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../../GLHandle/GLHandle.hpp"
+#include "../../TextureArray/TextureArray.hpp"
+#include "../Material/Material.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+#define MAX_MATERIALS 256
+#define MATERIAL_BINDING 0
+
+// a material as the shader reads it, in the std140 layout
+typedef struct materialBlock
+{
+    float ambiantColor[4];
+    float diffuseColor[4];
+    float specularColor[4];
+    float parameters[4]; // specular exponent, opacity, texture layer, unused
+} s_materialBlock;
+
+/**
+ * the parameters of every material used by a scene, in a single uniform buffer.
+ * the buffer is uploaded once, a draw call only selects its material
+ * with an index instead of sending each parameter again.
+ * the buffer can be moved but not copied
+ */
+class MaterialBuffer
+{
+  private:
+    MaterialBuffer() = delete;
+    MaterialBuffer(const MaterialBuffer &copy) = delete;
+    MaterialBuffer &operator=(const MaterialBuffer &copy) = delete;
+
+    BufferHandle buffer;
+    std::map<unsigned int, int> indices; // MaterialRegistry ID -> index in the buffer
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &context);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    MaterialBuffer(const std::vector<unsigned int> &materialIDs, const TextureArray &textures);
+    MaterialBuffer(MaterialBuffer &&move) = default;
+    MaterialBuffer &operator=(MaterialBuffer &&move) = default;
+
+    static std::string getTextureMap(const Material &material);
+    static s_materialBlock packMaterial(const Material &material, int textureLayer);
+
+    unsigned int getID() const;
+    size_t getNbMaterials() const;
+    int getIndex(unsigned int materialID) const;
+};
@@ -24,6 +24,8 @@ MaterialData &MaterialData::operator=(const MaterialData &copy)
         specularExponent = copy.getSpecularExponent();
         opacity = copy.getOpacity();
         illum = copy.getIllum();
+        for (size_t i = 0; i < 3; i++)
+            textureMaps[i] = copy.getTextureMap(i);
     }
     return (*this);
 }
@@ -63,6 +65,12 @@ unsigned int MaterialData::getIllum() const
 {
     return (illum);
 }
+std::string MaterialData::getTextureMap(unsigned int colorIndex) const
+{
+    if (colorIndex >= 3)
+        throw(Exception("GET_TEXTURE_MAP", "INVALID_INDEX", colorIndex));
+    return (textureMaps[colorIndex]);
+}
 
 void MaterialData::reset()
 {
@@ -76,6 +84,8 @@ void MaterialData::reset()
     refractionIndex = 0;
     opacity = 1;
     illum = 1;
+    for (size_t i = 0; i < 3; i++)
+        textureMaps[i] = "";
 }
 
 void MaterialData::setName(std::string name)
@@ -108,6 +118,12 @@ void MaterialData::setIllum(unsigned int illum)
 {
     this->illum = illum;
 }
+void MaterialData::setTextureMap(unsigned int colorIndex, const std::string &path)
+{
+    if (colorIndex >= 3)
+        throw(Exception("SET_TEXTURE_MAP", "INVALID_INDEX", colorIndex));
+    this->textureMaps[colorIndex] = path;
+}
 
 MaterialData::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
                                    unsigned int colorIndex)
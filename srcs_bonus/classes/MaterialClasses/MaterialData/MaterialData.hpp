@@ -25,6 +25,7 @@ class MaterialData
     float getRefractionIndex() const;
     float getOpacity() const;
     unsigned int getIllum() const;
+    std::string getTextureMap(unsigned int colorIndex) const;
 
     void reset();
     void setName(std::string name);
@@ -34,6 +35,7 @@ class MaterialData
     void setRefractionIndex(float refractionIndex);
     void setOpacity(float opacity);
     void setIllum(unsigned int illum);
+    void setTextureMap(unsigned int colorIndex, const std::string &path);
 
   protected:
     std::string name;
@@ -42,6 +44,7 @@ class MaterialData
     float refractionIndex;
     float opacity;
     unsigned int illum;
+    std::array<std::string, 3> textureMaps; // indexed like colors, empty if there is no map
 
   private:
     class Exception : public std::exception
@@ -6,7 +6,8 @@ MapMaterialParsingMethods MaterialParser::parsingMethods = {
     {"Ka", &MaterialParser::defineAmbiantColor},    {"Ks", &MaterialParser::defineSpecularColor},
     {"Kd", &MaterialParser::defineDiffuseColor},    {"Ns", &MaterialParser::defineSpecularExponent},
     {"Ni", &MaterialParser::defineRefractionIndex}, {"d", &MaterialParser::defineOpacity},
-    {"illum", &MaterialParser::defineIllum},
+    {"illum", &MaterialParser::defineIllum},        {"map_Ka", &MaterialParser::defineAmbiantMap},
+    {"map_Kd", &MaterialParser::defineDiffuseMap},
 };
 
 std::vector<Material> MaterialParser::parseMaterialFile(const std::string &path)
@@ -23,8 +24,10 @@ std::vector<Material> MaterialParser::parseMaterialFile(const std::string &path)
     unsigned int lineIndex = 1;
     while (std::getline(fileStream, line))
     {
-        line = line.substr(0, line.find("#"));
-        std::string symbol = line.substr(0, line.find(" "));
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        const std::string_view symbol = std::string_view(line).substr(0, Utils::findSeparator(line, 0));
         auto it = parsingMethods.find(symbol);
         if (symbol == "newmtl")
         {
@@ -52,29 +55,26 @@ std::vector<Material> MaterialParser::parseMaterialFile(const std::string &path)
 
 void MaterialParser::defineName(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_NAME", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    materialData.setName(words[1]);
+    materialData.setName(std::string(words[1]));
 }
 
 void MaterialParser::defineAmbiantColor(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 4)
         throw(Exception("DEFINE_AMBIANT_COLOR", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
     std::array<float, 3> ambiantColor;
     for (size_t i = 0; i < 3; i++)
     {
-        if (!Utils::isFloat(words[i + 1]))
+        if (!Utils::parseFloat(words[i + 1], ambiantColor[i]))
             throw(Exception("DEFINE_AMBIANT_COLOR", "INVALID_ARGUMENT", line, lineIndex));
-        ambiantColor[i] = std::stof(words[i + 1]);
         if (ambiantColor[i] < 0 || ambiantColor[i] > 1)
             throw(Exception("DEFINE_AMBIANT_COLOR", "INVALID_ARGUMENT", line, lineIndex));
     }
@@ -83,18 +83,16 @@ void MaterialParser::defineAmbiantColor(MaterialData &materialData, const std::s
 
 void MaterialParser::defineSpecularColor(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 4)
         throw(Exception("DEFINE_SPECULAR_COLOR", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
     std::array<float, 3> specularColor;
     for (size_t i = 0; i < 3; i++)
     {
-        if (!Utils::isFloat(words[i + 1]))
+        if (!Utils::parseFloat(words[i + 1], specularColor[i]))
             throw(Exception("DEFINE_SPECULAR_COLOR", "INVALID_ARGUMENT", line, lineIndex));
-        specularColor[i] = std::stof(words[i + 1]);
         if (specularColor[i] < 0 || specularColor[i] > 1)
             throw(Exception("DEFINE_SPECULAR_COLOR", "INVALID_ARGUMENT", line, lineIndex));
     }
@@ -103,18 +101,16 @@ void MaterialParser::defineSpecularColor(MaterialData &materialData, const std::
 
 void MaterialParser::defineDiffuseColor(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 4)
         throw(Exception("DEFINE_DIFFUSE_COLOR", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
     std::array<float, 3> diffuseColor;
     for (size_t i = 0; i < 3; i++)
     {
-        if (!Utils::isFloat(words[i + 1]))
+        if (!Utils::parseFloat(words[i + 1], diffuseColor[i]))
             throw(Exception("DEFINE_DIFFUSE_COLOR", "INVALID_ARGUMENT", line, lineIndex));
-        diffuseColor[i] = std::stof(words[i + 1]);
         if (diffuseColor[i] < 0 || diffuseColor[i] > 1)
             throw(Exception("DEFINE_DIFFUSE_COLOR", "INVALID_ARGUMENT", line, lineIndex));
     }
@@ -123,15 +119,14 @@ void MaterialParser::defineDiffuseColor(MaterialData &materialData, const std::s
 
 void MaterialParser::defineSpecularExponent(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_SPECULAR_EXPONENT", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    if (!Utils::isFloat(words[1]))
+    float specularExponent;
+    if (!Utils::parseFloat(words[1], specularExponent))
         throw(Exception("DEFINE_SPECULAR_EXPONENT", "INVALID_ARGUMENT", line, lineIndex));
-    float specularExponent = std::stof(words[1]);
     if (specularExponent < 0 || specularExponent > 1000)
         throw(Exception("DEFINE_SPECULAR_EXPONENT", "INVALID_ARGUMENT", line, lineIndex));
     materialData.setSpecularExponent(specularExponent);
@@ -139,15 +134,14 @@ void MaterialParser::defineSpecularExponent(MaterialData &materialData, const st
 
 void MaterialParser::defineRefractionIndex(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_REFRACTION_INDEX", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    if (!Utils::isFloat(words[1]))
+    float refractionIndex;
+    if (!Utils::parseFloat(words[1], refractionIndex))
         throw(Exception("DEFINE_REFRACTION_INDEX", "INVALID_ARGUMENT", line, lineIndex));
-    float refractionIndex = std::stof(words[1]);
     if (refractionIndex < 0 || refractionIndex > 10)
         throw(Exception("DEFINE_REFRACTION_INDEX", "INVALID_ARGUMENT", line, lineIndex));
     materialData.setRefractionIndex(refractionIndex);
@@ -155,15 +149,14 @@ void MaterialParser::defineRefractionIndex(MaterialData &materialData, const std
 
 void MaterialParser::defineOpacity(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_OPACITY", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    if (!Utils::isFloat(words[1]))
+    float opacity;
+    if (!Utils::parseFloat(words[1], opacity))
         throw(Exception("DEFINE_OPACITY", "INVALID_ARGUMENT", line, lineIndex));
-    float opacity = std::stof(words[1]);
     if (opacity < 0 || opacity > 1)
         throw(Exception("DEFINE_OPACITY", "INVALID_ARGUMENT", line, lineIndex));
     materialData.setOpacity(opacity);
@@ -171,20 +164,47 @@ void MaterialParser::defineOpacity(MaterialData &materialData, const std::string
 
 void MaterialParser::defineIllum(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_ILLUM", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    if (!Utils::isInt(words[1]))
+    long illum;
+    if (!Utils::parseInt(words[1], illum))
         throw(Exception("DEFINE_ILLUM", "INVALID_ARGUMENT", line, lineIndex));
-    int illum = std::stoi(words[1]);
     if (illum < 0 || illum > 10)
         throw(Exception("DEFINE_ILLUM", "INVALID_ARGUMENT", line, lineIndex));
     materialData.setIllum(illum);
 }
 
+void MaterialParser::defineAmbiantMap(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
+{
+    defineTextureMap(materialData, AMBIANT_COLOR, "DEFINE_AMBIANT_MAP", line, lineIndex);
+}
+
+void MaterialParser::defineDiffuseMap(MaterialData &materialData, const std::string &line, unsigned int lineIndex)
+{
+    defineTextureMap(materialData, DIFFUSE_COLOR, "DEFINE_DIFFUSE_MAP", line, lineIndex);
+}
+
+/*
+    the options of a texture map (-o, -s, -bm...) aren't supported,
+    only the path of the image or of its texture container is accepted
+*/
+void MaterialParser::defineTextureMap(MaterialData &materialData, e_colors colorIndex,
+                                      const std::string &functionName, const std::string &line, unsigned int lineIndex)
+{
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line);
+
+    if (words.size() != 2)
+        throw(Exception(functionName, "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
+
+    if (!Utils::checkExtension(words[1], ".ppm") && !Utils::checkExtension(words[1], ".pgm") &&
+        !Utils::checkExtension(words[1], ".stx"))
+        throw(Exception(functionName, "INVALID_EXTENSION", line, lineIndex));
+    materialData.setTextureMap(colorIndex, std::string(words[1]));
+}
+
 MaterialParser::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
                                      const std::string &line, unsigned int lineIndex)
 {
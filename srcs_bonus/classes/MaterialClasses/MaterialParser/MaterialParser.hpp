@@ -6,7 +6,8 @@
 #include <string>
 #include <vector>
 
-typedef std::map<std::string, void (*)(MaterialData &, const std::string &, unsigned int)> MapMaterialParsingMethods;
+typedef std::map<std::string, void (*)(MaterialData &, const std::string &, unsigned int), std::less<>>
+    MapMaterialParsingMethods;
 
 class MaterialParser
 {
@@ -20,6 +21,10 @@ class MaterialParser
     static void defineRefractionIndex(MaterialData &materialData, const std::string &line, unsigned int lineIndex);
     static void defineOpacity(MaterialData &materialData, const std::string &line, unsigned int lineIndex);
     static void defineIllum(MaterialData &materialData, const std::string &line, unsigned int lineIndex);
+    static void defineAmbiantMap(MaterialData &materialData, const std::string &line, unsigned int lineIndex);
+    static void defineDiffuseMap(MaterialData &materialData, const std::string &line, unsigned int lineIndex);
+    static void defineTextureMap(MaterialData &materialData, e_colors colorIndex, const std::string &functionName,
+                                 const std::string &line, unsigned int lineIndex);
     static MapMaterialParsingMethods parsingMethods;
 
     class Exception : public std::exception
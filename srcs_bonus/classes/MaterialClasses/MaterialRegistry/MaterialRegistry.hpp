@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../Material/Material.hpp"
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * every material of the scene being loaded.
+ * a material file is parsed once per process, in the background, as soon as it is first declared,
+ * and its materials are found by name in constant time.
+ * each material name is interned: it gets an ID that doesn't change until a new scene starts,
+ * which ObjectParser does at the start of each object file
+ */
+class MaterialRegistry
+{
+  private:
+    MaterialRegistry() = delete;
+
+    static void registerPendingFiles();
+    static std::string normalizePath(const std::string &path);
+
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_future<std::vector<Material>>> files;
+    static std::vector<std::string> pendingFiles;
+    static std::unordered_map<std::string, unsigned int> materialIDs;
+    static std::vector<Material> materials;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &name);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    static void prefetch(const std::string &path);
+    static void waitAll();
+
+    static bool hasMaterial(const std::string &name);
+    static unsigned int getMaterialID(const std::string &name);
+    static Material getMaterial(unsigned int materialID);
+    static Material getMaterial(const std::string &name);
+    static size_t getNbMaterials();
+    static void resetScene();
+    static void clear();
+};
@@ -0,0 +1,388 @@
+#include "MeshStreamer.hpp"
+#include "../../Utils/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+MeshStreamer::MeshStreamer(const std::string &path)
+{
+    std::ifstream file;
+    std::unique_ptr<char[]> buffer = std::make_unique<char[]>(STREAM_BUFFER_SIZE);
+    char arenaBuffer[STREAM_ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource lineArena(arenaBuffer, sizeof(arenaBuffer));
+    size_t kept = 0;
+
+    this->path = path;
+    lineIndex = 1;
+    nbVertices = 0;
+    nbPositions = 0;
+    arena = &lineArena;
+    std::fill(positionSum, positionSum + 3, 0);
+    random.seed(time(NULL));
+    if (!Utils::checkExtension(path, ".obj"))
+        throw(Exception("MESH_STREAMER", "INVALID_EXTENSION", path, 0));
+    file.open(path, std::ios::binary);
+    if (!file.is_open())
+        throw(Exception("MESH_STREAMER", "OPEN_FAILED", path, 0));
+
+    // the end of the block is kept for the next one when it cuts a line
+    while (file)
+    {
+        file.read(buffer.get() + kept, STREAM_BUFFER_SIZE - kept);
+        const size_t size = kept + file.gcount();
+        size_t start = 0;
+        for (size_t end = start; end < size; end++)
+        {
+            if (buffer[end] != '\n')
+                continue;
+            parseLine(std::string_view(buffer.get() + start, end - start));
+            lineArena.release();
+            start = end + 1;
+        }
+        kept = size - start;
+        if (kept == STREAM_BUFFER_SIZE)
+            throw(Exception("MESH_STREAMER", "LINE_TOO_LONG", path, lineIndex));
+        std::memmove(buffer.get(), buffer.get() + start, kept);
+    }
+    if (file.bad())
+        throw(Exception("MESH_STREAMER", "READ_FAILED", path, lineIndex));
+    if (kept > 0)
+        parseLine(std::string_view(buffer.get(), kept));
+    arena = std::pmr::get_default_resource();
+    if (nbVertices == 0)
+        throw(Exception("MESH_STREAMER", "NO_FACE", path, 0));
+}
+
+MeshStreamer::~MeshStreamer()
+{
+}
+
+/*
+    the tokens of a line are allocated from the arena,
+    the names and the materials are read but not kept
+*/
+void MeshStreamer::parseLine(std::string_view line)
+{
+    line = line.substr(0, line.find('#'));
+    const std::string_view symbol = line.substr(0, Utils::findSeparator(line, 0));
+
+    if (symbol == "v")
+        defineVertex(line);
+    else if (symbol == "vt")
+        defineTextureVertex(line);
+    else if (symbol == "vn")
+        defineNormal(line);
+    else if (symbol == "f")
+        defineFace(line);
+    else if (symbol == "o")
+    {
+        // the indices of the faces are relative to the current object
+        positions.clear();
+        textureVertices.clear();
+        normals.clear();
+    }
+    else if (symbol != "s" && symbol != "mtllib" && symbol != "usemtl" && symbol.length() != 0)
+        throw(Exception("PARSE_LINE", "INVALID_SYMBOL", line, lineIndex));
+    lineIndex++;
+}
+
+void MeshStreamer::defineVertex(std::string_view line)
+{
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
+    float vertex[4] = {0, 0, 0, 1};
+
+    if (words.size() < 4 || words.size() > 5)
+        throw(Exception("DEFINE_VERTEX", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
+    for (size_t i = 1; i < words.size(); i++)
+    {
+        if (!Utils::parseFloat(words[i], vertex[i - 1]))
+            throw(Exception("DEFINE_VERTEX", "INVALID_ARGUMENT", line, lineIndex));
+    }
+    if (vertex[3] == 0)
+        throw(Exception("DEFINE_VERTEX", "INVALID_ARGUMENT", line, lineIndex));
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        vertex[i] = vertex[i] / vertex[3];
+        positionSum[i] += vertex[i];
+    }
+    nbPositions++;
+    positions.append(vertex, sizeof(vertex));
+}
+
+void MeshStreamer::defineTextureVertex(std::string_view line)
+{
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
+    float textureVertex[3] = {0, 0, 0};
+
+    if (words.size() < 3 || words.size() > 4)
+        throw(Exception("DEFINE_TEXTURE_VERTEX", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
+    for (size_t i = 1; i < words.size(); i++)
+    {
+        if (!Utils::parseFloat(words[i], textureVertex[i - 1]) || textureVertex[i - 1] < 0 ||
+            textureVertex[i - 1] > 1)
+            throw(Exception("DEFINE_TEXTURE_VERTEX", "INVALID_ARGUMENT", line, lineIndex));
+    }
+    textureVertices.append(textureVertex, sizeof(textureVertex));
+}
+
+void MeshStreamer::defineNormal(std::string_view line)
+{
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
+    float normal[3];
+
+    if (words.size() != 4)
+        throw(Exception("DEFINE_NORMAL", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
+    for (size_t i = 1; i < words.size(); i++)
+    {
+        if (!Utils::parseFloat(words[i], normal[i - 1]))
+            throw(Exception("DEFINE_NORMAL", "INVALID_ARGUMENT", line, lineIndex));
+    }
+    normals.append(normal, sizeof(normal));
+}
+
+/*
+    the polygon is cut in a fan around its first corner,
+    an ear clipping would need every corner of the object in memory.
+    a corner is "v", "v/vt", "v//vn" or "v/vt/vn", a missing index is UINT32_MAX
+*/
+void MeshStreamer::defineFace(std::string_view line)
+{
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
+    std::pmr::vector<uint32_t> corners(arena);
+
+    if (words.size() < 4)
+        throw(Exception("DEFINE_FACE", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
+    for (size_t i = 1; i < words.size(); i++)
+    {
+        const size_t slash = words[i].find('/');
+        const size_t secondSlash = (slash == std::string_view::npos) ? slash : words[i].find('/', slash + 1);
+        if (secondSlash != std::string_view::npos && words[i].find('/', secondSlash + 1) != std::string_view::npos)
+            throw(Exception("DEFINE_FACE", "INVALID_ARGUMENT", line, lineIndex));
+        const std::string_view vertex = words[i].substr(0, slash);
+        std::string_view textureVertex;
+        std::string_view normal;
+        if (slash != std::string_view::npos)
+            textureVertex = words[i].substr(slash + 1, secondSlash - slash - 1);
+        if (secondSlash != std::string_view::npos)
+            normal = words[i].substr(secondSlash + 1);
+        if ((secondSlash != std::string_view::npos && normal.empty()) ||
+            (slash != std::string_view::npos && secondSlash == std::string_view::npos && textureVertex.empty()))
+            throw(Exception("DEFINE_FACE", "INVALID_ARGUMENT", line, lineIndex));
+
+        corners.push_back(readIndex(vertex, positions.getSize() / (4 * sizeof(float)), line));
+        if (textureVertex.empty())
+            corners.push_back(UINT32_MAX);
+        else
+            corners.push_back(readIndex(textureVertex, textureVertices.getSize() / (3 * sizeof(float)), line));
+        if (normal.empty())
+            corners.push_back(UINT32_MAX);
+        else
+            corners.push_back(readIndex(normal, normals.getSize() / (3 * sizeof(float)), line));
+    }
+
+    const size_t nbCorners = corners.size() / 3;
+    if (nbVertices + nbCorners > UINT32_MAX || getNbIndices() + (nbCorners - 2) * 3 > UINT32_MAX)
+        throw(Exception("DEFINE_FACE", "MESH_TOO_BIG", line, lineIndex));
+    addFace(corners, static_cast<float>(random() % 10000) / 10000);
+}
+
+/*
+    a negative index counts from the last vertex defined
+*/
+uint32_t MeshStreamer::readIndex(std::string_view index, size_t count, std::string_view line) const
+{
+    long vertexIndex;
+
+    if (!Utils::parseInt(index, vertexIndex))
+        throw(Exception("DEFINE_FACE", "INVALID_ARGUMENT", line, lineIndex));
+    if (vertexIndex < -static_cast<long>(count) || vertexIndex > static_cast<long>(count) || vertexIndex == 0)
+        throw(Exception("DEFINE_FACE", "INVALID_VERTEX_INDEX", line, lineIndex));
+    if (vertexIndex < 0)
+        vertexIndex = count + 1 + vertexIndex;
+    return (vertexIndex - 1);
+}
+
+/*
+    the vertices are not shared between the faces since each face has its own color,
+    inside a face a corner (same position, texture and normal indices) is stored once and shared by the fan.
+    the spilled data is read again on every call because an append can move it
+*/
+void MeshStreamer::addFace(const std::pmr::vector<uint32_t> &corners, float color)
+{
+    const size_t nbCorners = corners.size() / 3;
+    const float *positionData = reinterpret_cast<const float *>(positions.getData());
+    std::pmr::vector<uint32_t> cornerVertices(nbCorners, 0, arena);
+    float faceNormal[3];
+
+    getFaceNormal(corners, faceNormal);
+    for (size_t i = 0; i < nbCorners; i++)
+    {
+        const uint32_t *corner = &corners[i * 3];
+        size_t same = 0;
+        while (same < i && !std::equal(corner, corner + 3, &corners[same * 3]))
+            same++;
+        if (same < i)
+        {
+            cornerVertices[i] = cornerVertices[same];
+            continue;
+        }
+
+        float vertex[MESH_CACHE_VERTEX_SIZE] = {};
+        std::copy(positionData + corner[0] * 4, positionData + corner[0] * 4 + 4, vertex);
+        if (corner[1] != UINT32_MAX)
+        {
+            const float *texture = reinterpret_cast<const float *>(textureVertices.getData()) + corner[1] * 3;
+            std::copy(texture, texture + 3, vertex + 4);
+        }
+        std::fill(vertex + 7, vertex + 10, color);
+        if (corner[2] != UINT32_MAX)
+        {
+            const float *normal = reinterpret_cast<const float *>(normals.getData()) + corner[2] * 3;
+            std::copy(normal, normal + 3, vertex + 10);
+        }
+        else
+            std::copy(faceNormal, faceNormal + 3, vertex + 10);
+        vertices.append(vertex, sizeof(vertex));
+        cornerVertices[i] = nbVertices++;
+    }
+    for (size_t i = 1; i + 1 < nbCorners; i++)
+    {
+        const uint32_t triangle[3] = {cornerVertices[0], cornerVertices[i], cornerVertices[i + 1]};
+        indices.append(triangle, sizeof(triangle));
+    }
+}
+
+/*
+    the normal of the polygon (Newell's method), the one of its plane when it is flat,
+    so every triangle of the fan gives the same normal to a corner without one
+*/
+void MeshStreamer::getFaceNormal(const std::pmr::vector<uint32_t> &corners, float *faceNormal) const
+{
+    const size_t nbCorners = corners.size() / 3;
+    const float *positionData = reinterpret_cast<const float *>(positions.getData());
+
+    std::fill(faceNormal, faceNormal + 3, 0);
+    for (size_t i = 0; i < nbCorners; i++)
+    {
+        const float *current = positionData + corners[i * 3] * 4;
+        const float *next = positionData + corners[(i + 1) % nbCorners * 3] * 4;
+        faceNormal[0] += (current[1] - next[1]) * (current[2] + next[2]);
+        faceNormal[1] += (current[2] - next[2]) * (current[0] + next[0]);
+        faceNormal[2] += (current[0] - next[0]) * (current[1] + next[1]);
+    }
+    const float length =
+        std::sqrt(faceNormal[0] * faceNormal[0] + faceNormal[1] * faceNormal[1] + faceNormal[2] * faceNormal[2]);
+    for (size_t i = 0; i < 3 && length > 0; i++)
+        faceNormal[i] /= length;
+}
+
+/*
+    the vertices are centered while they are copied, a block at a time
+*/
+void MeshStreamer::save(const std::string &path) const
+{
+    const size_t blockSize = STREAM_BUFFER_SIZE / sizeof(float) / MESH_CACHE_VERTEX_SIZE * MESH_CACHE_VERTEX_SIZE;
+    const float *source = reinterpret_cast<const float *>(vertices.getData());
+    const size_t nbFloats = static_cast<size_t>(nbVertices) * MESH_CACHE_VERTEX_SIZE;
+    std::vector<unsigned char> header;
+    std::vector<float> block;
+    float center[3];
+    std::ofstream output;
+
+    for (size_t i = 0; i < 3; i++)
+        center[i] = (nbPositions > 0) ? positionSum[i] / nbPositions : 0;
+    header.insert(header.end(), {'S', 'M', 'C', '1'});
+    writeUint(header, MESH_CACHE_VERTEX_SIZE);
+    writeUint(header, nbVertices);
+    writeUint(header, getNbIndices());
+
+    output.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    output.open(path, std::ios::binary);
+    output.write(reinterpret_cast<const char *>(header.data()), header.size());
+    for (size_t i = 0; i < nbFloats; i += blockSize)
+    {
+        block.assign(source + i, source + std::min(nbFloats, i + blockSize));
+        for (size_t j = 0; j < block.size(); j += MESH_CACHE_VERTEX_SIZE)
+        {
+            for (size_t k = 0; k < 3; k++)
+                block[j + k] -= center[k];
+        }
+        output.write(reinterpret_cast<const char *>(block.data()), block.size() * sizeof(float));
+    }
+    output.write(reinterpret_cast<const char *>(indices.getData()), indices.getSize());
+    output.close();
+}
+
+uint32_t MeshStreamer::getNbVertices() const
+{
+    return (nbVertices);
+}
+
+uint32_t MeshStreamer::getNbIndices() const
+{
+    return (indices.getSize() / sizeof(uint32_t));
+}
+
+/*
+    the buffers point into the mapped file, they stay valid while a copy of the file is alive.
+    every index is checked so the GPU never reads outside of the vertices
+*/
+s_meshBuffers MeshStreamer::loadCache(const std::string &path)
+{
+    s_meshBuffers buffers;
+
+    buffers.file = std::make_shared<const MappedFile>(path);
+    const unsigned char *data = buffers.file->getData();
+    const size_t size = buffers.file->getSize();
+    if (size < MESH_CACHE_HEADER_SIZE || std::memcmp(data, "SMC1", 4) != 0)
+        throw(Exception("LOAD_CACHE", "INVALID_MAGIC_NUMBER", path, 0));
+    if (readUint(data + 4) != MESH_CACHE_VERTEX_SIZE)
+        throw(Exception("LOAD_CACHE", "INVALID_VERTEX_SIZE", path, 0));
+    buffers.nbVertices = readUint(data + 8);
+    buffers.nbIndices = readUint(data + 12);
+    if (buffers.nbIndices == 0 || buffers.nbIndices % 3 != 0 ||
+        size != MESH_CACHE_HEADER_SIZE + static_cast<size_t>(buffers.nbVertices) * MESH_CACHE_VERTEX_SIZE * 4 +
+                    static_cast<size_t>(buffers.nbIndices) * 4)
+        throw(Exception("LOAD_CACHE", "INVALID_SIZE", path, 0));
+
+    buffers.vertices = reinterpret_cast<const float *>(data + MESH_CACHE_HEADER_SIZE);
+    buffers.indices = reinterpret_cast<const uint32_t *>(buffers.vertices +
+                                                         static_cast<size_t>(buffers.nbVertices) *
+                                                             MESH_CACHE_VERTEX_SIZE);
+    for (uint32_t i = 0; i < buffers.nbIndices; i++)
+    {
+        if (buffers.indices[i] >= buffers.nbVertices)
+            throw(Exception("LOAD_CACHE", "INVALID_INDEX", path, 0));
+    }
+    return (buffers);
+}
+
+uint32_t MeshStreamer::readUint(const unsigned char *data)
+{
+    return (data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24));
+}
+
+void MeshStreamer::writeUint(std::vector<unsigned char> &buffer, uint32_t value)
+{
+    for (size_t i = 0; i < 4; i++)
+        buffer.push_back((value >> (i * 8)) & 0xFF);
+}
+
+MeshStreamer::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                   std::string_view context, unsigned int lineIndex)
+{
+    this->errorMessage = "MESH_STREAMER::" + functionName + "::" + errorMessage;
+    if (lineIndex == 0)
+        this->errorMessage += "\n|\n| " + std::string(context) + "\n|";
+    else
+        this->errorMessage += "\n|\n| " + std::to_string(lineIndex) + ": " + std::string(context) + "\n|";
+}
+
+const char *MeshStreamer::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../../MappedFile/MappedFile.hpp"
+#include "../../SpillFile/SpillFile.hpp"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define MESH_CACHE_EXTENSION ".smc"
+#define MESH_CACHE_VERTEX_SIZE 13 // floats per vertex: position (4), texture (3), color (3), normal (3)
+#define MESH_CACHE_HEADER_SIZE 16
+#define STREAM_BUFFER_SIZE 1048576 // the bytes of the file read at once, so the longest line accepted
+#define STREAM_ARENA_SIZE 16384 // the tokens of a line usually fit, a longer line spills to the heap
+
+// the geometry of a mesh cache, laid out for the GPU
+typedef struct meshBuffers
+{
+    std::shared_ptr<const MappedFile> file;
+    const float *vertices;
+    uint32_t nbVertices;
+    const uint32_t *indices;
+    uint32_t nbIndices;
+} s_meshBuffers;
+
+/**
+ * converts an object file to a mesh cache (.smc) with a bounded memory, whatever the size of the file.
+ * the file is read by blocks, the positions and texture coordinates are spilled into temporary mapped files
+ * where the faces read them, the triangles are spilled as vertices and indices, then copied into the cache.
+ * the faces are triangulated as fans and get a random gray, the corners of a face are stored once
+ * and shared by its triangles. the names and materials are ignored:
+ * the cache is a single mesh centered on the mean of its positions.
+ * the corners without normal get the normal of their face,
+ * the smoothing groups would need every corner of a position and are ignored.
+ *
+ * layout (little endian):
+ * "SMC1" | vertex size | number of vertices | number of indices
+ * then the vertices (floats) and the indices (unsigned ints)
+ */
+class MeshStreamer
+{
+  private:
+    MeshStreamer() = delete;
+    MeshStreamer(const MeshStreamer &copy) = delete;
+    MeshStreamer &operator=(const MeshStreamer &copy) = delete;
+
+    void parseLine(std::string_view line);
+    void defineVertex(std::string_view line);
+    void defineTextureVertex(std::string_view line);
+    void defineNormal(std::string_view line);
+    void defineFace(std::string_view line);
+    uint32_t readIndex(std::string_view index, size_t count, std::string_view line) const;
+    void addFace(const std::pmr::vector<uint32_t> &corners, float color);
+    void getFaceNormal(const std::pmr::vector<uint32_t> &corners, float *faceNormal) const;
+    static uint32_t readUint(const unsigned char *data);
+    static void writeUint(std::vector<unsigned char> &buffer, uint32_t value);
+
+    std::string path;
+    unsigned int lineIndex;
+    std::pmr::memory_resource *arena;
+    SpillFile positions;
+    SpillFile textureVertices;
+    SpillFile normals;
+    SpillFile vertices;
+    SpillFile indices;
+    uint32_t nbVertices;
+    double positionSum[3];
+    uint64_t nbPositions;
+    std::minstd_rand random; // rand shares its state between the threads, each streamer has its own generator
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, std::string_view context,
+                  unsigned int lineIndex);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    MeshStreamer(const std::string &path);
+    ~MeshStreamer();
+
+    void save(const std::string &path) const;
+    uint32_t getNbVertices() const;
+    uint32_t getNbIndices() const;
+
+    static s_meshBuffers loadCache(const std::string &path);
+};
\ No newline at end of file
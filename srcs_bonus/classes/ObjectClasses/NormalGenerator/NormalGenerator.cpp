@@ -0,0 +1,241 @@
+#include "NormalGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/*
+    a normal is missing when it's (0, 0, 0), the given normals are kept.
+    the flags are read before anything is written, so a corner never sees a normal generated by another one.
+    without a number of threads, it depends on the cores and the size of the mesh
+*/
+void NormalGenerator::generate(float *vertices, const s_vertexLayout &layout, const uint32_t *indices,
+                               size_t nbTriangles, const uint32_t *smoothingGroups, size_t nbThreads)
+{
+    if (nbThreads == 0)
+        nbThreads = getNbThreads(nbTriangles);
+    std::vector<float> faceNormals(nbTriangles * 3);
+    std::vector<unsigned char> missing(nbTriangles * 3);
+    std::vector<size_t> counts(nbThreads * nbThreads, 0);
+    std::vector<size_t> offsets(nbThreads * nbThreads);
+    std::vector<size_t> partitionStarts(nbThreads + 1, 0);
+    auto firstTriangle = [&](size_t thread) { return (nbTriangles * thread / nbThreads); };
+
+    // the face normals, then the number of smooth corners each thread gives to each partition
+    parallelFor(nbThreads, [&](size_t thread) {
+        computeFaceNormals(vertices, layout, indices, firstTriangle(thread), firstTriangle(thread + 1),
+                           faceNormals.data());
+        for (size_t corner = firstTriangle(thread) * 3; corner < firstTriangle(thread + 1) * 3; corner++)
+        {
+            const float *vertex = vertices + static_cast<size_t>(indices[corner]) * layout.size;
+            const float *normal = vertex + layout.normalOffset;
+            missing[corner] = (normal[0] == 0 && normal[1] == 0 && normal[2] == 0);
+            if (missing[corner] && smoothingGroups[corner / 3] != 0)
+                counts[thread * nbThreads + getPartition(vertex, smoothingGroups[corner / 3], nbThreads)]++;
+        }
+    });
+    for (size_t partition = 0; partition < nbThreads; partition++)
+    {
+        partitionStarts[partition + 1] = partitionStarts[partition];
+        for (size_t thread = 0; thread < nbThreads; thread++)
+        {
+            offsets[thread * nbThreads + partition] = partitionStarts[partition + 1];
+            partitionStarts[partition + 1] += counts[thread * nbThreads + partition];
+        }
+    }
+
+    // the flat corners get the normal of their face, the smooth ones are sorted by partition
+    std::vector<uint32_t> corners(partitionStarts[nbThreads]);
+    parallelFor(nbThreads, [&](size_t thread) {
+        for (size_t corner = firstTriangle(thread) * 3; corner < firstTriangle(thread + 1) * 3; corner++)
+        {
+            if (!missing[corner])
+                continue;
+            float *vertex = vertices + static_cast<size_t>(indices[corner]) * layout.size;
+            if (smoothingGroups[corner / 3] == 0)
+            {
+                std::copy(&faceNormals[corner / 3 * 3], &faceNormals[corner / 3 * 3] + 3,
+                          vertex + layout.normalOffset);
+                normalize(vertex + layout.normalOffset);
+                continue;
+            }
+            const size_t partition = getPartition(vertex, smoothingGroups[corner / 3], nbThreads);
+            corners[offsets[thread * nbThreads + partition]++] = corner;
+        }
+    });
+
+    parallelFor(nbThreads, [&](size_t partition) {
+        sumPartition(vertices, layout, indices, smoothingGroups, faceNormals.data(),
+                     corners.data() + partitionStarts[partition],
+                     partitionStarts[partition + 1] - partitionStarts[partition]);
+    });
+}
+
+size_t NormalGenerator::getNbThreads(size_t nbTriangles)
+{
+    const size_t nbThreads = JobSystem::getShared().getNbThreads();
+
+    return (std::max(static_cast<size_t>(1), std::min(nbThreads, nbTriangles / NORMAL_MIN_TRIANGLES_PER_THREAD)));
+}
+
+/*
+    the loop has no branch and reads the corners in order, so it can be vectorized by the compiler.
+    the cross product isn't normalized: its length is twice the area of the face
+*/
+void NormalGenerator::computeFaceNormals(const float *vertices, const s_vertexLayout &layout,
+                                         const uint32_t *indices, size_t firstTriangle, size_t lastTriangle,
+                                         float *faceNormals)
+{
+    for (size_t i = firstTriangle; i < lastTriangle; i++)
+    {
+        const float *a = vertices + static_cast<size_t>(indices[i * 3]) * layout.size;
+        const float *b = vertices + static_cast<size_t>(indices[i * 3 + 1]) * layout.size;
+        const float *c = vertices + static_cast<size_t>(indices[i * 3 + 2]) * layout.size;
+        const float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+
+        faceNormals[i * 3] = ab[1] * ac[2] - ab[2] * ac[1];
+        faceNormals[i * 3 + 1] = ab[2] * ac[0] - ab[0] * ac[2];
+        faceNormals[i * 3 + 2] = ab[0] * ac[1] - ab[1] * ac[0];
+    }
+}
+
+/*
+    the corners of a partition are summed in an open addressing table, one slot per position and group.
+    the key and the sum of a slot are stored together, in the order the positions are met.
+    the corners sharing a vertex are usually close in the mesh, a small cache of the last vertex indices
+    finds their sum without searching the table.
+    a position is usually shared by several faces, the table starts with a slot for a third of the corners
+*/
+void NormalGenerator::sumPartition(float *vertices, const s_vertexLayout &layout, const uint32_t *indices,
+                                   const uint32_t *smoothingGroups, const float *faceNormals,
+                                   const uint32_t *corners, size_t nbCorners)
+{
+    size_t tableSize = NORMAL_MIN_TABLE_SIZE;
+    while (tableSize < nbCorners / 3)
+        tableSize *= 2;
+    std::vector<uint32_t> table(tableSize, UINT32_MAX);
+    std::vector<s_cachedVertex> cache(NORMAL_VERTEX_CACHE_SIZE, s_cachedVertex{UINT32_MAX, 0, 0});
+    std::vector<s_smoothSum> sums;
+    std::vector<uint32_t> cornerSums(nbCorners);
+
+    for (size_t i = 0; i < nbCorners; i++)
+    {
+        const uint32_t triangle = corners[i] / 3;
+        const uint32_t index = indices[corners[i]];
+        s_cachedVertex &cached = cache[index & (NORMAL_VERTEX_CACHE_SIZE - 1)];
+        if (cached.index != index || cached.group != smoothingGroups[triangle])
+            cached = {index, smoothingGroups[triangle],
+                      findSum(table, sums, getKey(vertices + static_cast<size_t>(index) * layout.size,
+                                                  smoothingGroups[triangle]))};
+        cornerSums[i] = cached.sum;
+        for (size_t j = 0; j < 3; j++)
+            sums[cornerSums[i]].sum[j] += faceNormals[triangle * 3 + j];
+    }
+    for (size_t i = 0; i < sums.size(); i++)
+        normalize(sums[i].sum);
+    for (size_t i = 0; i < nbCorners; i++)
+    {
+        float *normal = vertices + static_cast<size_t>(indices[corners[i]]) * layout.size + layout.normalOffset;
+        std::copy(sums[cornerSums[i]].sum, sums[cornerSums[i]].sum + 3, normal);
+    }
+}
+
+/*
+    returns the index of the sum of a key, added if it's new
+*/
+uint32_t NormalGenerator::findSum(std::vector<uint32_t> &table, std::vector<s_smoothSum> &sums,
+                                  const s_smoothKey &key)
+{
+    size_t slot = hashKey(key) & (table.size() - 1);
+
+    while (table[slot] != UINT32_MAX && !sameKey(sums[table[slot]].key, key))
+        slot = (slot + 1) & (table.size() - 1);
+    if (table[slot] != UINT32_MAX)
+        return (table[slot]);
+    table[slot] = sums.size();
+    sums.push_back(s_smoothSum{key, {0, 0, 0}});
+    if (sums.size() * 2 > table.size())
+        growTable(table, sums);
+    return (sums.size() - 1);
+}
+
+/*
+    the table is kept at most half full, so a search stops quickly
+*/
+void NormalGenerator::growTable(std::vector<uint32_t> &table, const std::vector<s_smoothSum> &sums)
+{
+    table.assign(table.size() * 2, UINT32_MAX);
+    for (size_t i = 0; i < sums.size(); i++)
+    {
+        size_t slot = hashKey(sums[i].key) & (table.size() - 1);
+        while (table[slot] != UINT32_MAX)
+            slot = (slot + 1) & (table.size() - 1);
+        table[slot] = i;
+    }
+}
+
+/*
+    -0 and 0 are the same position, 0 is added to turn -0 into 0
+*/
+NormalGenerator::s_smoothKey NormalGenerator::getKey(const float *vertex, uint32_t group)
+{
+    s_smoothKey key;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        const float coordinate = vertex[i] + 0.0f;
+        std::memcpy(&key.position[i], &coordinate, sizeof(float));
+    }
+    key.group = group;
+    return (key);
+}
+
+uint64_t NormalGenerator::hashKey(const s_smoothKey &key)
+{
+    uint64_t hash = key.group * 0x9e3779b97f4a7c15;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        hash = (hash ^ key.position[i]) * 0xff51afd7ed558ccd;
+        hash ^= hash >> 32;
+    }
+    return (hash);
+}
+
+/*
+    the table of a partition uses the low bits of the hash, the partition uses the high ones
+*/
+size_t NormalGenerator::getPartition(const float *vertex, uint32_t group, size_t nbPartitions)
+{
+    return ((hashKey(getKey(vertex, group)) >> 40) % nbPartitions);
+}
+
+bool NormalGenerator::sameKey(const s_smoothKey &a, const s_smoothKey &b)
+{
+    return (a.position[0] == b.position[0] && a.position[1] == b.position[1] && a.position[2] == b.position[2] &&
+            a.group == b.group);
+}
+
+/*
+    a degenerate face has no direction, its normal stays (0, 0, 0)
+*/
+void NormalGenerator::normalize(float *normal)
+{
+    const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+    if (length == 0)
+        return;
+    for (size_t i = 0; i < 3; i++)
+        normal[i] /= length;
+}
+
+/*
+    each task is a job of the shared pool, one task at a time so a slow one doesn't hold the others
+*/
+void NormalGenerator::parallelFor(size_t nbTasks, const std::function<void(size_t)> &task)
+{
+    JobSystem::getShared().parallelFor(nbTasks, 1, [&task](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            task(i);
+    });
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../../JobSystem/JobSystem.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#define NORMAL_MIN_TRIANGLES_PER_THREAD 16384 // below this a thread costs more than it saves
+#define NORMAL_MIN_TABLE_SIZE 1024            // slots of the table of a partition before it grows
+#define NORMAL_VERTEX_CACHE_SIZE 8192         // recently summed vertex indices, a power of 2
+
+// the layout of the vertices the normals are written in
+typedef struct vertexLayout
+{
+    size_t size;         // floats per vertex
+    size_t normalOffset; // index of the normal in a vertex
+} s_vertexLayout;
+
+/**
+ * generates the missing normals of a triangle mesh from its final vertex and index buffers.
+ * a corner whose normal is (0, 0, 0) gets a normal:
+ * in the smoothing group 0 it's the normal of its face,
+ * otherwise it's the sum of the normals of the faces of the same group around the same position,
+ * each face weighted by its area (the length of its cross product), then normalized.
+ * the corners are split between the threads by the hash of their position and group,
+ * so each thread sums its own positions without any lock. the threads are the jobs of the shared pool.
+ * a vertex must not be shared by faces that get different normals (see ObjectData::splitVerticesByNormal)
+ */
+class NormalGenerator
+{
+  private:
+    NormalGenerator() = delete;
+
+    typedef struct smoothKey
+    {
+        uint32_t position[3]; // the bits of the coordinates
+        uint32_t group;
+    } s_smoothKey;
+
+    typedef struct smoothSum
+    {
+        s_smoothKey key;
+        float sum[3];
+    } s_smoothSum;
+
+    typedef struct cachedVertex
+    {
+        uint32_t index;
+        uint32_t group;
+        uint32_t sum;
+    } s_cachedVertex;
+
+    static s_smoothKey getKey(const float *vertex, uint32_t group);
+    static uint64_t hashKey(const s_smoothKey &key);
+    static size_t getPartition(const float *vertex, uint32_t group, size_t nbPartitions);
+    static bool sameKey(const s_smoothKey &a, const s_smoothKey &b);
+    static void normalize(float *normal);
+    static void parallelFor(size_t nbTasks, const std::function<void(size_t)> &task);
+
+    static void computeFaceNormals(const float *vertices, const s_vertexLayout &layout, const uint32_t *indices,
+                                   size_t firstTriangle, size_t lastTriangle, float *faceNormals);
+    static void sumPartition(float *vertices, const s_vertexLayout &layout, const uint32_t *indices,
+                             const uint32_t *smoothingGroups, const float *faceNormals, const uint32_t *corners,
+                             size_t nbCorners);
+    static uint32_t findSum(std::vector<uint32_t> &table, std::vector<s_smoothSum> &sums, const s_smoothKey &key);
+    static void growTable(std::vector<uint32_t> &table, const std::vector<s_smoothSum> &sums);
+
+  public:
+    static void generate(float *vertices, const s_vertexLayout &layout, const uint32_t *indices, size_t nbTriangles,
+                         const uint32_t *smoothingGroups, size_t nbThreads = 0);
+    static size_t getNbThreads(size_t nbTriangles);
+};
\ No newline at end of file
@@ -1,94 +1,143 @@
 #include "Object.hpp"
 #include "../../../../libs/glad/glad.h"
+#include "../../LoadStats/LoadStats.hpp"
 
-Object::Object(const ObjectData &data)
+static_assert(sizeof(s_instance) == InstanceLayout::size * sizeof(float), "the instances are uploaded as they are");
+static_assert(MESH_CACHE_VERTEX_SIZE == VERTEX_SIZE, "a mesh cache is uploaded as it is");
+
+/*
+    the vectors of the data are moved into the object, nothing is copied
+*/
+Object::Object(ObjectData &&data) : ObjectData(std::move(data))
 {
-    name = data.getName();
-    vertices = data.getVertices();
-    textureVertices = data.getTextureVertices();
-    combinedVertices = data.getCombinedVertices();
-    faces = data.getFaces();
-    smoothShading = data.getSmoothShading();
-    material = data.getMaterial();
-    VAOInit = false;
+    instances.push_back({{0, 0, 0}, {1, 1, 1}});
 }
 
-Object::Object(const Object &copy)
+bool Object::isVAOInit() const
 {
-    *this = copy;
+    return (VAO.get() != 0);
+}
+unsigned int Object::getVAO() const
+{
+    return (VAO.get());
 }
 
-Object &Object::operator=(const Object &copy)
+std::vector<s_instance> Object::getInstances() const
 {
-    if (&copy != this)
-    {
-        vertices = copy.getVertices();
-        textureVertices = copy.getTextureVertices();
-        combinedVertices = copy.getCombinedVertices();
-        faces = copy.getFaces();
-        name = copy.getName();
-        smoothShading = copy.getSmoothShading();
-        material = copy.getMaterial();
-        VAOInit = false;
-    }
-    return (*this);
+    return (instances);
 }
 
-Object::~Object()
+/*
+    the vertices and the indices initVAO uploads, for a renderer without OpenGL.
+    the object must be prepared before
+*/
+void Object::getGeometry(std::vector<float> &vertices, std::vector<unsigned int> &indices) const
 {
-    if (VAOInit)
+    if (meshBuffers)
     {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-        glDeleteBuffers(1, &EBO);
+        vertices.assign(meshBuffers->vertices, meshBuffers->vertices + meshBuffers->nbVertices * VERTEX_SIZE);
+        indices.assign(meshBuffers->indices, meshBuffers->indices + meshBuffers->nbIndices);
+        return;
     }
+    std::unique_ptr<float[]> verticesArray = getCombinedVerticesIntoArray();
+    std::unique_ptr<unsigned int[]> facesArray = getFacesIntoArray();
+
+    generateNormals(verticesArray.get(), facesArray.get());
+    vertices.assign(verticesArray.get(), verticesArray.get() + combinedVertices.size() * VERTEX_SIZE);
+    indices.assign(facesArray.get(), facesArray.get() + faces.size() * 3);
 }
 
-bool Object::isVAOInit() const
+void Object::setInstances(const std::vector<s_instance> &instances)
 {
-    return (VAOInit);
+    this->instances = instances;
 }
-unsigned int Object::getVAO() const
+
+void Object::addInstance(const s_instance &instance)
 {
-    return (VAO);
+    instances.push_back(instance);
 }
 
-void Object::initVAO()
+/*
+    a mesh cache is already triangulated, colored and centered,
+    it's drawn with a single command without material
+*/
+void Object::setMeshBuffers(const s_meshBuffers &meshBuffers)
 {
+    this->meshBuffers = meshBuffers;
+    subMeshes = {{NO_MATERIAL, 0, meshBuffers.nbIndices / 3}};
+}
+
+/*
+    the work done on the CPU before the upload, it touches nothing but the object
+    so the objects can be prepared on several threads
+*/
+void Object::prepare()
+{
+    if (meshBuffers)
+        return;
     GenerateFacesColor();
+    splitVerticesByNormal();
     centerObject();
+    groupFacesByMaterial();
+}
 
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
+/*
+    the geometry is uploaded once for every instance,
+    the attributes of the instances advance once per instance instead of once per vertex.
+    the object must be prepared before
+*/
+void Object::initVAO()
+{
+    const LoadStats::Stage stage(UPLOAD_STAGE);
 
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    VAO = VertexArrayHandle::create();
+    VBO = BufferHandle::create();
+    EBO = BufferHandle::create();
+    instanceVBO = BufferHandle::create();
 
-    std::unique_ptr<float[]> verticesArray = getCombinedVerticesIntoArray();
-    std::unique_ptr<unsigned int[]> facesArray = getFacesIntoArray();
+    glBindVertexArray(VAO.get());
+    glBindBuffer(GL_ARRAY_BUFFER, VBO.get());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO.get());
+
+    if (meshBuffers)
+    {
+        // the pages of the mapped file are read by the driver, nothing is copied before
+        const size_t verticesSize = sizeof(float) * meshBuffers->nbVertices * VERTEX_SIZE;
+        const size_t indicesSize = sizeof(uint32_t) * meshBuffers->nbIndices;
+        glBufferData(GL_ARRAY_BUFFER, verticesSize, meshBuffers->vertices, GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, meshBuffers->indices, GL_STATIC_DRAW);
+        LoadStats::add(BYTES_UPLOADED, verticesSize + indicesSize);
+    }
+    else
+    {
+        std::unique_ptr<float[]> verticesArray = getCombinedVerticesIntoArray();
+        std::unique_ptr<unsigned int[]> facesArray = getFacesIntoArray();
+        const size_t verticesSize = sizeof(float) * combinedVertices.size() * VERTEX_SIZE;
+        const size_t indicesSize = sizeof(unsigned int) * faces.size() * 3;
+
+        generateNormals(verticesArray.get(), facesArray.get());
+        glBufferData(GL_ARRAY_BUFFER, verticesSize, &verticesArray[0], GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, &facesArray[0], GL_STATIC_DRAW);
+        LoadStats::add(BYTES_UPLOADED, verticesSize + indicesSize);
+    }
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * combinedVertices.size() * 10, &verticesArray[0], GL_STATIC_DRAW);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * faces.size() * 3, &facesArray[0], GL_STATIC_DRAW);
+    ObjectVertexLayout::setAttributes();
 
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void *)(4 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 10 * sizeof(float), (void *)(7 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO.get());
+    glBufferData(GL_ARRAY_BUFFER, sizeof(s_instance) * instances.size(), instances.data(), GL_STATIC_DRAW);
+    LoadStats::add(BYTES_UPLOADED, sizeof(s_instance) * instances.size());
+    InstanceLayout::setAttributes(1);
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    VAOInit = true;
 }
 
 std::ostream &operator<<(std::ostream &os, const Object &instance)
 {
     os << "name: " << instance.getName() << std::endl;
-    os << "smooth shading: " << instance.getSmoothShading() << std::endl;
+    os << "smoothing group: " << instance.getSmoothingGroup() << std::endl;
+    os << "instances: " << instance.getInstances().size() << std::endl;
     std::vector<Vertex> objectVertices = instance.getCombinedVertices();
     os << "vertices: " << std::endl;
     for (size_t i = 0; i < objectVertices.size(); i++)
@@ -1,28 +1,56 @@
 #pragma once
 
+#include "../../GLHandle/GLHandle.hpp"
+#include "../MeshStreamer/MeshStreamer.hpp"
 #include "../ObjectData/ObjectData.hpp"
 #include <iostream>
+#include <optional>
+
+// a copy of the object in the scene
+typedef struct instance
+{
+    float translation[3];
+    float color[3]; // multiplied with the colors of the faces
+} s_instance;
+
+inline constexpr char TRANSLATION_INPUT[] = "aTranslation";
+inline constexpr char INSTANCE_COLOR_INPUT[] = "aInstanceColor";
+
+typedef VertexLayout<VertexAttribute<TRANSLATION_LOCATION, 3, TRANSLATION_INPUT>,
+                     VertexAttribute<INSTANCE_COLOR_LOCATION, 3, INSTANCE_COLOR_INPUT>>
+    InstanceLayout;
 
 // possibility to create a sub class named "OpenGLObject" containing VAO
+// an object owns its buffers, it can be moved but not copied
 class Object : public ObjectData
 {
   private:
     Object() = delete;
+    Object(const Object &copy) = delete;
+    Object &operator=(const Object &copy) = delete;
 
-    bool VAOInit;
-    unsigned int VAO;
-    unsigned int VBO;
-    unsigned int EBO;
+    VertexArrayHandle VAO;
+    BufferHandle VBO;
+    BufferHandle EBO;
+    BufferHandle instanceVBO;
+    std::vector<s_instance> instances;
+    std::optional<s_meshBuffers> meshBuffers; // the geometry of a mesh cache, uploaded as it is
 
   public:
-    Object(const ObjectData &data);
-    Object(const Object &copy);
-    Object &operator=(const Object &copy);
-    ~Object();
+    Object(ObjectData &&data);
+    Object(Object &&move) = default;
+    Object &operator=(Object &&move) = default;
 
     bool isVAOInit() const;
     unsigned int getVAO() const;
+    std::vector<s_instance> getInstances() const;
+    void getGeometry(std::vector<float> &vertices, std::vector<unsigned int> &indices) const;
+
+    void setInstances(const std::vector<s_instance> &instances);
+    void addInstance(const s_instance &instance);
+    void setMeshBuffers(const s_meshBuffers &meshBuffers);
 
+    void prepare();
     void initVAO();
 };
 
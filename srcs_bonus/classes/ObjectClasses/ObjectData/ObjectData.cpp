@@ -1,6 +1,14 @@
 #include "ObjectData.hpp"
+#include "../../LoadStats/LoadStats.hpp"
+#include "../NormalGenerator/NormalGenerator.hpp"
 #include <algorithm>
+#include <array>
 #include <climits>
+#include <cmath>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <random>
 
 ObjectData::ObjectData()
 {
@@ -55,6 +63,11 @@ std::unique_ptr<float[]> ObjectData::getTexturesVerticesIntoArray() const
     return (array);
 }
 
+std::vector<Vertex> ObjectData::getNormals() const
+{
+    return (normals);
+}
+
 std::vector<Vertex> ObjectData::getCombinedVertices() const
 {
     return (combinedVertices);
@@ -62,19 +75,51 @@ std::vector<Vertex> ObjectData::getCombinedVertices() const
 
 std::unique_ptr<float[]> ObjectData::getCombinedVerticesIntoArray() const
 {
-    const size_t combinedVertexSize = 10;
-    size_t j;
-    std::unique_ptr<float[]> array;
+    return (ObjectVertexLayout::pack(combinedVertices));
+}
 
-    j = 0;
-    array = std::make_unique<float[]>(combinedVertices.size() * combinedVertexSize);
-    for (size_t i = 0; i < combinedVertices.size(); i++)
-    {
-        for (size_t k = 0; k < combinedVertexSize; k++)
-            array[j + k] = combinedVertices[i][k];
-        j += combinedVertexSize;
-    }
-    return (array);
+/*
+    the accessors of a single element don't copy the whole vector,
+    the parser reads the data of the object being built with them
+*/
+const Vertex &ObjectData::getVertex(size_t index) const
+{
+    return (vertices[index]);
+}
+
+const Vertex &ObjectData::getTextureVertex(size_t index) const
+{
+    return (textureVertices[index]);
+}
+
+const Vertex &ObjectData::getNormal(size_t index) const
+{
+    return (normals[index]);
+}
+
+const Vertex &ObjectData::getCombinedVertex(size_t index) const
+{
+    return (combinedVertices[index]);
+}
+
+size_t ObjectData::getNbVertices() const
+{
+    return (vertices.size());
+}
+
+size_t ObjectData::getNbTextureVertices() const
+{
+    return (textureVertices.size());
+}
+
+size_t ObjectData::getNbNormals() const
+{
+    return (normals.size());
+}
+
+size_t ObjectData::getNbCombinedVertices() const
+{
+    return (combinedVertices.size());
 }
 
 std::unique_ptr<unsigned int[]> ObjectData::getFacesIntoArray() const
@@ -108,18 +153,120 @@ std::string ObjectData::getName() const
         return ("");
 }
 
-Material ObjectData::getMaterial() const
+std::vector<s_subMesh> ObjectData::getSubMeshes() const
 {
-    if (material.has_value())
-        return (material.value());
-    else
+    return (subMeshes);
+}
+
+unsigned int ObjectData::getCurrentMaterialID() const
+{
+    if (subMeshes.empty())
+        return (NO_MATERIAL);
+    return (subMeshes.back().materialID);
+}
+std::array<float, 3> ObjectData::getCenter() const
+{
+    std::array<float, 3> center = {0, 0, 0};
+
+    if (combinedVertices.empty())
+        return (center);
+    for (size_t i = 0; i < combinedVertices.size(); i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+            center[j] += combinedVertices[i][j];
+    }
+    for (size_t j = 0; j < 3; j++)
+        center[j] /= combinedVertices.size();
+    return (center);
+}
+
+/*
+    everything that defines the geometry, with the positions relative to the center:
+    2 copies of the same part at different places have the same key
+*/
+std::vector<long long> ObjectData::getGeometryKey() const
+{
+    const std::array<float, 3> center = getCenter();
+    std::vector<long long> key;
+
+    key.reserve(combinedVertices.size() * 10 + faces.size() * 4 + subMeshes.size() * 3 + 2);
+    key.push_back(combinedVertices.size());
+    for (size_t i = 0; i < combinedVertices.size(); i++)
+    {
+        for (size_t j = 0; j < combinedVertices[i].size(); j++)
+        {
+            const float value = (j < 3) ? combinedVertices[i][j] - center[j] : combinedVertices[i][j];
+            key.push_back(std::llround(value * GEOMETRY_PRECISION));
+        }
+    }
+    key.push_back(faces.size());
+    for (size_t i = 0; i < faces.size(); i++)
+        key.insert(key.end(), faces[i].begin(), faces[i].end());
+    key.insert(key.end(), smoothingGroups.begin(), smoothingGroups.end());
+    for (size_t i = 0; i < subMeshes.size(); i++)
     {
-        return (Material());
+        key.push_back(subMeshes[i].materialID);
+        key.push_back(subMeshes[i].firstFace);
+        key.push_back(subMeshes[i].nbFaces);
     }
+    return (key);
+}
+
+size_t ObjectData::getGeometryHash() const
+{
+    return (hashGeometryKey(getGeometryKey()));
+}
+
+size_t ObjectData::hashGeometryKey(const std::vector<long long> &key)
+{
+    size_t hash = key.size();
+
+    for (size_t i = 0; i < key.size(); i++)
+        hash ^= std::hash<long long>()(key[i]) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    return (hash);
+}
+
+/*
+    the same comparison as the geometry keys, without building them
+*/
+bool ObjectData::hasSameGeometry(const ObjectData &other) const
+{
+    if (combinedVertices.size() != other.combinedVertices.size() || faces != other.faces ||
+        smoothingGroups != other.smoothingGroups || subMeshes.size() != other.subMeshes.size())
+        return (false);
+    for (size_t i = 0; i < subMeshes.size(); i++)
+    {
+        if (subMeshes[i].materialID != other.subMeshes[i].materialID ||
+            subMeshes[i].firstFace != other.subMeshes[i].firstFace ||
+            subMeshes[i].nbFaces != other.subMeshes[i].nbFaces)
+            return (false);
+    }
+    const std::array<float, 3> center = getCenter();
+    const std::array<float, 3> otherCenter = other.getCenter();
+    for (size_t i = 0; i < combinedVertices.size(); i++)
+    {
+        if (combinedVertices[i].size() != other.combinedVertices[i].size())
+            return (false);
+        for (size_t j = 0; j < combinedVertices[i].size(); j++)
+        {
+            const float value = (j < 3) ? combinedVertices[i][j] - center[j] : combinedVertices[i][j];
+            const float otherValue =
+                (j < 3) ? other.combinedVertices[i][j] - otherCenter[j] : other.combinedVertices[i][j];
+            if (std::llround(value * GEOMETRY_PRECISION) != std::llround(otherValue * GEOMETRY_PRECISION))
+                return (false);
+        }
+    }
+    return (true);
+}
+
+unsigned int ObjectData::getSmoothingGroup() const
+{
+    return (smoothingGroup);
 }
-bool ObjectData::getSmoothShading() const
+
+std::vector<unsigned int> ObjectData::getSmoothingGroups() const
 {
-    return (smoothShading);
+    return (smoothingGroups);
 }
 
 void ObjectData::reset()
@@ -127,10 +274,12 @@ void ObjectData::reset()
     name.reset();
     vertices.clear();
     textureVertices.clear();
+    normals.clear();
     combinedVertices.clear();
     faces.clear();
-    smoothShading = false;
-    material.reset();
+    smoothingGroup = 0;
+    smoothingGroups.clear();
+    subMeshes.clear();
 }
 
 void ObjectData::setName(const std::string &name)
@@ -155,16 +304,26 @@ void ObjectData::setCombinedVertices(const std::vector<Vertex> &vertices)
 void ObjectData::setFaces(const std::vector<Face> &faces)
 {
     this->faces = faces;
+    smoothingGroups.assign(faces.size(), smoothingGroup);
+    subMeshes.clear();
+    subMeshes.push_back({NO_MATERIAL, 0, faces.size()});
 }
 
-void ObjectData::setSmoothShading(bool smoothShading)
+void ObjectData::setSmoothingGroup(unsigned int smoothingGroup)
 {
-    this->smoothShading = smoothShading;
+    this->smoothingGroup = smoothingGroup;
 }
 
-void ObjectData::setMaterial(const Material &material)
+/*
+    the next faces use this material.
+    a material used before any face replaces the previous one
+*/
+void ObjectData::useMaterial(unsigned int materialID)
 {
-    this->material = material;
+    if (!subMeshes.empty() && subMeshes.back().nbFaces == 0)
+        subMeshes.back().materialID = materialID;
+    else
+        subMeshes.push_back({materialID, faces.size(), 0});
 }
 
 void ObjectData::addVertex(const Vertex &vertex)
@@ -177,6 +336,11 @@ void ObjectData::addTextureVertex(const Vertex &vertex)
     textureVertices.push_back(vertex);
 }
 
+void ObjectData::addNormal(const Vertex &normal)
+{
+    normals.push_back(normal);
+}
+
 void ObjectData::addCombinedVertex(const Vertex &vertex)
 {
     combinedVertices.push_back(vertex);
@@ -184,19 +348,26 @@ void ObjectData::addCombinedVertex(const Vertex &vertex)
 
 void ObjectData::addFace(const Face &face)
 {
+    if (subMeshes.empty())
+        subMeshes.push_back({NO_MATERIAL, faces.size(), 0});
     faces.push_back(face);
+    smoothingGroups.push_back(smoothingGroup);
+    subMeshes.back().nbFaces++;
 }
 
 void ObjectData::GenerateFacesColor()
 {
-    srand(time(NULL));
+    const LoadStats::Stage stage(GENERATE_COLORS_STAGE);
+
+    // rand shares its state between the threads, each object has its own generator
+    std::minstd_rand random(time(NULL));
     vertices = combinedVertices;
     combinedVertices.clear();
 
     std::vector<Face> newFaces;
     for (size_t i = 0; i < faces.size(); i++)
     {
-        float randomColor = static_cast<float>(rand() % 10000) / 10000;
+        float randomColor = static_cast<float>(random() % 10000) / 10000;
         Face newFace;
 
         for (int j = 0; j < 3; j++)
@@ -206,21 +377,30 @@ void ObjectData::GenerateFacesColor()
     faces = newFaces;
 }
 
+/*
+    the colored corner is built on the stack, it is copied to the heap only if no combined vertex is the same
+*/
 int ObjectData::CombineVertexWithColor(size_t vertexIndex, float color)
 {
-    Vertex combinedVertex;
+    std::array<float, 13> combinedVertex;
 
     for (size_t j = 0; j < 7; j++)
-        combinedVertex.push_back((vertices[vertexIndex][j]));
+        combinedVertex[j] = vertices[vertexIndex][j];
     for (size_t j = 0; j < 3; j++)
-        combinedVertex.push_back(color);
+        combinedVertex[7 + j] = color;
+    for (size_t j = 7; j < 10; j++)
+        combinedVertex[3 + j] = vertices[vertexIndex][j];
 
-    auto it = std::find(combinedVertices.begin(), combinedVertices.end(), combinedVertex);
+    auto it = std::find_if(combinedVertices.begin(), combinedVertices.end(), [&combinedVertex](const Vertex &vertex) {
+        return (std::equal(combinedVertex.begin(), combinedVertex.end(), vertex.begin(), vertex.end()));
+    });
     if (it == combinedVertices.end())
     {
-        combinedVertices.push_back(combinedVertex);
+        combinedVertices.emplace_back(combinedVertex.begin(), combinedVertex.end());
+        LoadStats::add(UNIQUE_COLORED_VERTICES);
         return (combinedVertices.size() - 1);
     }
+    LoadStats::add(COLORED_DEDUP_HITS);
     return (std::distance(combinedVertices.begin(), it));
 }
 
@@ -236,3 +416,88 @@ void ObjectData::centerObject()
             combinedVertices[i][j] -= center;
     }
 }
+
+/*
+    a vertex without normal gets the normal of its face (group 0) or of its smoothing group.
+    the normals are generated in the vertex buffer, so a vertex shared by faces that don't get the same normal
+    is copied: a copy per flat face and a copy per smoothing group.
+    each vertex then receives a single normal, written by a single partition of the generator
+*/
+void ObjectData::splitVerticesByNormal()
+{
+    std::vector<long long> owners(combinedVertices.size(), LLONG_MIN);
+    std::map<std::pair<int, long long>, int> copies;
+
+    for (size_t i = 0; i < faces.size(); i++)
+    {
+        // a smoothing group owns its vertices, a flat face owns its own
+        const long long owner = (smoothingGroups[i] != 0) ? static_cast<long long>(smoothingGroups[i])
+                                                          : -static_cast<long long>(i) - 1;
+        for (size_t j = 0; j < faces[i].size(); j++)
+        {
+            const int index = faces[i][j];
+            const Vertex &vertex = combinedVertices[index];
+            if (vertex[vertex.size() - 3] != 0 || vertex[vertex.size() - 2] != 0 || vertex[vertex.size() - 1] != 0)
+                continue;
+            if (owners[index] == LLONG_MIN)
+                owners[index] = owner;
+            if (owners[index] == owner)
+                continue;
+            auto it = copies.find({index, owner});
+            if (it == copies.end())
+            {
+                const Vertex copy = vertex;
+                combinedVertices.push_back(copy);
+                owners.push_back(owner);
+                it = copies.emplace(std::make_pair(index, owner), combinedVertices.size() - 1).first;
+            }
+            faces[i][j] = it->second;
+        }
+    }
+}
+
+/*
+    the faces are reordered so each material has a single range of faces,
+    the object is then drawn with one call per material
+*/
+void ObjectData::groupFacesByMaterial()
+{
+    std::vector<s_subMesh> sortedSubMeshes = subMeshes;
+    std::vector<s_subMesh> groupedSubMeshes;
+    std::vector<Face> groupedFaces;
+    std::vector<unsigned int> groupedSmoothingGroups;
+
+    std::stable_sort(sortedSubMeshes.begin(), sortedSubMeshes.end(),
+                     [](const s_subMesh &a, const s_subMesh &b) { return (a.materialID < b.materialID); });
+    groupedFaces.reserve(faces.size());
+    groupedSmoothingGroups.reserve(faces.size());
+    for (size_t i = 0; i < sortedSubMeshes.size(); i++)
+    {
+        if (sortedSubMeshes[i].nbFaces == 0)
+            continue;
+        if (groupedSubMeshes.empty() || groupedSubMeshes.back().materialID != sortedSubMeshes[i].materialID)
+            groupedSubMeshes.push_back({sortedSubMeshes[i].materialID, groupedFaces.size(), 0});
+        groupedFaces.insert(groupedFaces.end(), faces.begin() + sortedSubMeshes[i].firstFace,
+                            faces.begin() + sortedSubMeshes[i].firstFace + sortedSubMeshes[i].nbFaces);
+        groupedSmoothingGroups.insert(groupedSmoothingGroups.end(),
+                                      smoothingGroups.begin() + sortedSubMeshes[i].firstFace,
+                                      smoothingGroups.begin() + sortedSubMeshes[i].firstFace +
+                                          sortedSubMeshes[i].nbFaces);
+        groupedSubMeshes.back().nbFaces += sortedSubMeshes[i].nbFaces;
+    }
+    faces = groupedFaces;
+    smoothingGroups = groupedSmoothingGroups;
+    subMeshes = groupedSubMeshes;
+}
+
+/*
+    the normals are generated from the arrays uploaded to the GPU,
+    the faces without normal in the file get the normal of their face or of their smoothing group
+*/
+void ObjectData::generateNormals(float *verticesArray, const unsigned int *facesArray) const
+{
+    const LoadStats::Stage stage(GENERATE_NORMALS_STAGE);
+
+    NormalGenerator::generate(verticesArray, {VERTEX_SIZE, VERTEX_NORMAL_OFFSET}, facesArray, faces.size(),
+                              smoothingGroups.data());
+}
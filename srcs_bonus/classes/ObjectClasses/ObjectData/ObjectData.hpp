@@ -1,34 +1,90 @@
 #pragma once
 
 #include "../../MaterialClasses/Material/Material.hpp"
+#include "../../VertexLayout/VertexLayout.hpp"
+#include <array>
+#include <climits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+#define NO_MATERIAL UINT_MAX
+#define GEOMETRY_PRECISION 10000 // coordinates closer than 1 / GEOMETRY_PRECISION are the same
+#define VERTEX_SIZE ObjectVertexLayout::size
+#define VERTEX_NORMAL_OFFSET ObjectVertexLayout::getOffset(NORMAL_LOCATION)
+
 typedef std::vector<float> Vertex;
 typedef std::vector<int> Face;
 
+// the locations of the inputs of the vertex shader
+typedef enum attributeLocation
+{
+    POSITION_LOCATION,
+    TEXTURE_LOCATION,
+    COLOR_LOCATION,
+    TRANSLATION_LOCATION,
+    INSTANCE_COLOR_LOCATION,
+    NORMAL_LOCATION
+} e_attributeLocation;
+
+inline constexpr char POSITION_INPUT[] = "aPos";
+inline constexpr char TEXTURE_INPUT[] = "aTexCoord";
+inline constexpr char COLOR_INPUT[] = "aColor";
+inline constexpr char NORMAL_INPUT[] = "aNormal";
+
+// a combined vertex: position (4), texture (3), color (3), normal (3)
+typedef VertexLayout<VertexAttribute<POSITION_LOCATION, 4, POSITION_INPUT>,
+                     VertexAttribute<TEXTURE_LOCATION, 3, TEXTURE_INPUT>,
+                     VertexAttribute<COLOR_LOCATION, 3, COLOR_INPUT>, VertexAttribute<NORMAL_LOCATION, 3, NORMAL_INPUT>>
+    ObjectVertexLayout;
+
+// faces [firstFace, firstFace + nbFaces[ use the same material
+typedef struct subMesh
+{
+    unsigned int materialID; // ID in the MaterialRegistry
+    size_t firstFace;
+    size_t nbFaces;
+} s_subMesh;
+
 class ObjectData
 {
   public:
     ObjectData();
     ObjectData(const ObjectData &copy);
     ObjectData &operator=(const ObjectData &copy);
+    ObjectData(ObjectData &&move) = default;
+    ObjectData &operator=(ObjectData &&move) = default;
     ~ObjectData();
 
     std::string getName() const;
     std::vector<Vertex> getVertices() const;
     std::unique_ptr<float[]> getVerticesIntoArray() const;
     std::vector<Vertex> getTextureVertices() const;
+    std::vector<Vertex> getNormals() const;
     std::unique_ptr<float[]> getTexturesVerticesIntoArray() const;
     std::vector<Vertex> getCombinedVertices() const;
     std::unique_ptr<float[]> getCombinedVerticesIntoArray() const;
+    const Vertex &getVertex(size_t index) const;
+    const Vertex &getTextureVertex(size_t index) const;
+    const Vertex &getNormal(size_t index) const;
+    const Vertex &getCombinedVertex(size_t index) const;
+    size_t getNbVertices() const;
+    size_t getNbTextureVertices() const;
+    size_t getNbNormals() const;
+    size_t getNbCombinedVertices() const;
     std::vector<Face> getFaces() const;
     std::unique_ptr<unsigned int[]> getFacesIntoArray() const;
-    bool getSmoothShading() const;
+    unsigned int getSmoothingGroup() const;
+    std::vector<unsigned int> getSmoothingGroups() const;
     unsigned int getVAO() const;
-    Material getMaterial() const;
+    std::vector<s_subMesh> getSubMeshes() const;
+    unsigned int getCurrentMaterialID() const;
+    std::array<float, 3> getCenter() const;
+    std::vector<long long> getGeometryKey() const;
+    size_t getGeometryHash() const;
+    bool hasSameGeometry(const ObjectData &other) const;
+    static size_t hashGeometryKey(const std::vector<long long> &key);
 
     void reset();
     void setName(const std::string &name);
@@ -36,11 +92,12 @@ class ObjectData
     void setTexturesVertices(const std::vector<Vertex> &vertices);
     void setCombinedVertices(const std::vector<Vertex> &vertices);
     void setFaces(const std::vector<Face> &faces);
-    void setSmoothShading(bool smoothShading);
-    void setMaterial(const Material &material);
+    void setSmoothingGroup(unsigned int smoothingGroup);
+    void useMaterial(unsigned int materialID);
 
     void addVertex(const Vertex &vertex);
     void addTextureVertex(const Vertex &vertex);
+    void addNormal(const Vertex &normal);
     void addCombinedVertex(const Vertex &vertex);
     void addFace(const Face &face);
 
@@ -48,13 +105,18 @@ class ObjectData
     int CombineVertexWithColor(size_t vertexIndex, float color);
 
     void centerObject();
+    void splitVerticesByNormal();
+    void groupFacesByMaterial();
+    void generateNormals(float *verticesArray, const unsigned int *facesArray) const;
 
   protected:
     std::optional<std::string> name;
     std::vector<Vertex> vertices;
     std::vector<Vertex> textureVertices;
+    std::vector<Vertex> normals;
     std::vector<Vertex> combinedVertices;
     std::vector<Face> faces;
-    bool smoothShading;
-    std::optional<Material> material;
+    unsigned int smoothingGroup;             // the group of the next faces, 0 for flat faces
+    std::vector<unsigned int> smoothingGroups; // the group of each face
+    std::vector<s_subMesh> subMeshes;
 };
\ No newline at end of file
@@ -1,81 +1,195 @@
 #include "ObjectParser.hpp"
-#include "../../MaterialClasses/MaterialParser/MaterialParser.hpp"
+#include "../../MaterialClasses/MaterialRegistry/MaterialRegistry.hpp"
+#include "../../LoadStats/LoadStats.hpp"
 #include "../../Utils/Utils.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <ctime>
+#include <fstream>
+#include <random>
 #include <string>
+#include <utility>
 #include <vector>
 MapObjectParsingMethods ObjectParser::parsingMethods = {
-    {"v", &ObjectParser::defineVertex},    {"vt", &ObjectParser::defineTextureVertex},
-    {"f", &ObjectParser::defineFace},      {"s", &ObjectParser::defineSmoothShading},
-    {"mtllib", &ObjectParser::saveNewMTL}, {"usemtl", &ObjectParser::defineMTL}};
-
-std::vector<Material> ObjectParser::materials;
-
+    {"v", &ObjectParser::defineVertex},        {"vt", &ObjectParser::defineTextureVertex},
+    {"vn", &ObjectParser::defineNormal},       {"f", &ObjectParser::defineFace},
+    {"s", &ObjectParser::defineSmoothShading}, {"mtllib", &ObjectParser::saveNewMTL},
+    {"usemtl", &ObjectParser::defineMTL}};
+thread_local std::pmr::memory_resource *ObjectParser::arena = std::pmr::get_default_resource();
+
+/*
+    a scene only knows the materials of its own files,
+    the ones of a scene parsed before are forgotten (their files stay parsed)
+*/
 std::vector<Object> ObjectParser::parseObjectFile(const std::string &path)
 {
+    MaterialRegistry::resetScene();
+    if (Utils::checkExtension(path, MESH_CACHE_EXTENSION))
+    {
+        std::vector<Object> objects;
+        objects.emplace_back(ObjectData()).setMeshBuffers(MeshStreamer::loadCache(path));
+        return (objects);
+    }
     if (!Utils::checkExtension(path, ".obj"))
         throw(Exception("PARSE_OBJECT_FILE", "INVALID_EXTENSION", path, 0));
 
     ObjectData objectData;
     std::vector<Object> objects;
-    std::stringstream fileStream = Utils::readFile(path);
-    fileStream = Utils::readFile(path);
+    std::ifstream file;
+    LoadStats::Stage readStage(READ_FILE_STAGE);
+    // the file is read a line at a time, its size doesn't matter
+    file.exceptions(std::ifstream::badbit);
+    file.open(path);
+    if (!file.is_open())
+        throw(Exception("PARSE_OBJECT_FILE", "OPEN_FAILED", path, 0));
+    readStage.end();
+    LoadStats::Stage parseStage(PARSE_STAGE);
+    char arenaBuffer[PARSER_ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource lineArena(arenaBuffer, sizeof(arenaBuffer));
     std::string line;
     unsigned int lineIndex = 1;
-    while (std::getline(fileStream, line))
+    arena = &lineArena;
+    while (std::getline(file, line))
     {
-        line = line.substr(0, line.find("#"));
-        std::string symbol = line.substr(0, line.find(" "));
-        auto it = parsingMethods.find(symbol);
-        if (symbol == "o")
+        try
         {
-            if (objectData.getFaces().size() > 0)
-            {
-                Object newObject(objectData);
-                objects.push_back(newObject);
-            }
-            objectData.reset();
-            defineName(objectData, line, lineIndex);
+            parseLine(objectData, objects, line, lineIndex);
         }
-        else if (it != parsingMethods.end())
-            (it->second)(objectData, line, lineIndex);
-        else if (symbol.length() != 0)
-            throw(Exception("PARSE_OBJECT_FILE", "INVALID_SYMBOL", line, lineIndex));
+        catch (...)
+        {
+            arena = std::pmr::get_default_resource();
+            LoadStats::flush(COMBINE_VERTICES_STAGE);
+            LoadStats::flush(TRIANGULATE_STAGE);
+            throw;
+        }
+        // the temporary data of the line is freed at once, the next line reuses the buffer
+        lineArena.release();
         lineIndex++;
     }
+    arena = std::pmr::get_default_resource();
+    // the faces are measured in spans, the stages are recorded once per file
+    LoadStats::flush(COMBINE_VERTICES_STAGE);
+    LoadStats::flush(TRIANGULATE_STAGE);
     if (objectData.getFaces().size() > 0)
+        objects.emplace_back(std::move(objectData));
+    parseStage.end();
+    MaterialRegistry::waitAll();
+    return (mergeInstances(std::move(objects)));
+}
+
+/*
+    the temporary data of a line is allocated from the arena,
+    only what is kept in the object data uses the heap
+*/
+void ObjectParser::parseLine(ObjectData &objectData, std::vector<Object> &objects, std::string &line,
+                             unsigned int lineIndex)
+{
+    const size_t comment = line.find('#');
+    if (comment != std::string::npos)
+        line.erase(comment);
+    const std::string_view symbol = std::string_view(line).substr(0, Utils::findSeparator(line, 0));
+    LoadStats::countSymbol(symbol);
+    auto it = parsingMethods.find(symbol);
+    if (symbol == "o")
     {
-        Object newObject(objectData);
-        objects.push_back(newObject);
+        // the current material stays in use for the next object, it's read before the data is moved
+        unsigned int materialID = objectData.getCurrentMaterialID();
+        if (objectData.getFaces().size() > 0)
+            objects.emplace_back(std::move(objectData));
+        objectData.reset();
+        if (materialID != NO_MATERIAL)
+            objectData.useMaterial(materialID);
+        defineName(objectData, line, lineIndex);
+    }
+    else if (it != parsingMethods.end())
+        (it->second)(objectData, line, lineIndex);
+    else if (symbol.length() != 0)
+        throw(Exception("PARSE_OBJECT_FILE", "INVALID_SYMBOL", line, lineIndex));
+}
+
+/*
+    the average of every vertex of the scene
+*/
+std::array<float, 3> ObjectParser::sceneCenter(const std::vector<Object> &objects)
+{
+    std::array<float, 3> center = {0, 0, 0};
+    size_t nbVertices = 0;
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const std::array<float, 3> objectCenter = objects[i].getCenter();
+        const size_t objectVertices = objects[i].getNbCombinedVertices();
+        for (size_t j = 0; j < 3; j++)
+            center[j] += objectCenter[j] * objectVertices;
+        nbVertices += objectVertices;
+    }
+    for (size_t j = 0; j < 3 && nbVertices > 0; j++)
+        center[j] /= nbVertices;
+    return (center);
+}
+
+/*
+    the objects with the same geometry become the instances of a single object.
+    an instance is placed where its object was, relatively to the center of the scene,
+    the copies get a random tint to stay distinguishable.
+    the unique objects are moved into the result, their geometry isn't copied:
+    only the hash of a key is kept, an object is compared to the unique objects with the same hash
+*/
+std::vector<Object> ObjectParser::mergeInstances(std::vector<Object> &&objects)
+{
+    const std::array<float, 3> center = sceneCenter(objects);
+    std::unordered_map<size_t, std::vector<size_t>> uniqueObjects;
+    std::vector<Object> mergedObjects;
+    // rand shares its state between the threads, the tints have their own generator
+    std::minstd_rand random(time(NULL));
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const std::array<float, 3> objectCenter = objects[i].getCenter();
+        s_instance instance = {{objectCenter[0] - center[0], objectCenter[1] - center[1], objectCenter[2] - center[2]},
+                               {1, 1, 1}};
+        std::vector<size_t> &candidates = uniqueObjects[ObjectData::hashGeometryKey(objects[i].getGeometryKey())];
+
+        auto it = std::find_if(candidates.begin(), candidates.end(),
+                               [&](size_t index) { return (mergedObjects[index].hasSameGeometry(objects[i])); });
+        if (it != candidates.end())
+        {
+            for (size_t j = 0; j < 3; j++)
+                instance.color[j] = 0.5f + static_cast<float>(random() % 10000) / 20000;
+            mergedObjects[*it].addInstance(instance);
+            continue;
+        }
+        candidates.push_back(mergedObjects.size());
+        mergedObjects.push_back(std::move(objects[i]));
+        mergedObjects.back().setInstances({instance});
     }
-    return (objects);
+    return (mergedObjects);
 }
 
 void ObjectParser::defineName(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_NAME", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
-    objectData.setName(words[1]);
+    objectData.setName(std::string(words[1]));
 }
 
 void ObjectParser::defineVertex(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
     Vertex vertex;
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() < 4 || words.size() > 5)
         throw(Exception("DEFINE_VERTEX", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
     for (size_t i = 1; i < words.size(); i++)
     {
-        if (!Utils::isFloat(words[i]))
+        float value;
+        if (!Utils::parseFloat(words[i], value))
             throw(Exception("DEFINE_VERTEX", "INVALID_ARGUMENT", line, lineIndex));
-        vertex.push_back(std::stof(words[i]));
+        vertex.push_back(value);
     }
     if (words.size() == 4)
         vertex.push_back(1.0f);
@@ -92,18 +206,15 @@ void ObjectParser::defineVertex(ObjectData &objectData, const std::string &line,
 void ObjectParser::defineTextureVertex(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
     Vertex textureVertex;
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() < 3 || words.size() > 4)
         throw(Exception("DEFINE_VERTEX_TEXTURE", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
     for (size_t i = 1; i < words.size(); i++)
     {
-        if (!Utils::isFloat(words[i]))
-            throw(Exception("DEFINE_VERTEX_TEXTURE", "INVALID_ARGUMENT", line, lineIndex));
-        float value = std::stof(words[i]);
-        if (value < 0 || value > 1)
+        float value;
+        if (!Utils::parseFloat(words[i], value) || value < 0 || value > 1)
             throw(Exception("DEFINE_VERTEX_TEXTURE", "INVALID_ARGUMENT", line, lineIndex));
         textureVertex.push_back(value);
     }
@@ -113,10 +224,38 @@ void ObjectParser::defineTextureVertex(ObjectData &objectData, const std::string
     objectData.addTextureVertex(textureVertex);
 }
 
+/*
+    the normal is normalized here, a null normal is generated from the faces like a missing one
+*/
+void ObjectParser::defineNormal(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
+{
+    Vertex normal;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
+
+    if (words.size() != 4)
+        throw(Exception("DEFINE_NORMAL", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
+
+    for (size_t i = 1; i < words.size(); i++)
+    {
+        float value;
+        if (!Utils::parseFloat(words[i], value))
+            throw(Exception("DEFINE_NORMAL", "INVALID_ARGUMENT", line, lineIndex));
+        normal.push_back(value);
+    }
+    const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    for (size_t i = 0; i < 3 && length > 0; i++)
+        normal[i] /= length;
+
+    objectData.addNormal(normal);
+}
+
+/*
+    a corner is "v/vt" or "v/vt/vn"
+*/
 void ObjectParser::defineFace(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
     Face face;
-    std::vector<std::string> words = Utils::splitLine(line, " ");
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
     if (words.size() < 4)
         throw(Exception("DEFINE_FACE", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
@@ -128,40 +267,48 @@ void ObjectParser::defineFace(ObjectData &objectData, const std::string &line, u
             if (words[i][j] == '/')
                 nbBackSlash++;
         }
-        if (nbBackSlash != 1)
+        if (nbBackSlash != 1 && nbBackSlash != 2)
             throw(Exception("DEFINE_FACE", "INVALID_ARGUMENT", line, lineIndex));
 
-        std::vector<std::string> vertices = Utils::splitLine(words[i], "/");
-        if (vertices.size() != 2)
+        const std::pmr::vector<std::string_view> vertices = Utils::splitLine(words[i], '/', arena);
+        if (vertices.size() != static_cast<size_t>(nbBackSlash) + 1)
             throw(Exception("DEFINE_FACE", "INVALID_ARGUMENT", line, lineIndex));
 
         size_t vertexIndex = CalculateVertexIndex(objectData, vertices[0], CLASSIC, line, lineIndex);
         size_t textureVertexIndex = CalculateVertexIndex(objectData, vertices[1], TEXTURE, line, lineIndex);
-        face.push_back(CombineVertices(objectData, vertexIndex, textureVertexIndex));
+        size_t normalIndex = 0;
+        if (vertices.size() == 3)
+            normalIndex = CalculateVertexIndex(objectData, vertices[2], NORMAL, line, lineIndex);
+        face.push_back(CombineVertices(objectData, vertexIndex, textureVertexIndex, normalIndex));
     }
     triangulate(objectData, face);
 }
 
-size_t ObjectParser::CalculateVertexIndex(ObjectData &objectData, const std::string &vertex, e_vertexType vertexType,
+size_t ObjectParser::CalculateVertexIndex(ObjectData &objectData, std::string_view vertex, e_vertexType vertexType,
                                           const std::string &line, unsigned int lineIndex)
 {
-    int nbVertices;
+    long nbVertices;
     std::string errorMessage;
 
     if (vertexType == CLASSIC)
     {
-        nbVertices = objectData.getVertices().size();
+        nbVertices = objectData.getNbVertices();
         errorMessage = "INVALID_VERTEX_INDEX";
     }
-    else
+    else if (vertexType == TEXTURE)
     {
-        nbVertices = objectData.getTextureVertices().size();
+        nbVertices = objectData.getNbTextureVertices();
         errorMessage = "INVALID_TEXTURE_VERTEX_INDEX";
     }
+    else
+    {
+        nbVertices = objectData.getNbNormals();
+        errorMessage = "INVALID_NORMAL_INDEX";
+    }
 
-    if (!Utils::isInt(vertex))
+    long vertexIndex;
+    if (!Utils::parseInt(vertex, vertexIndex))
         throw(Exception("DEFINE_FACE", "INVALID_ARGUMENT", line, lineIndex));
-    int vertexIndex = std::stoi(vertex);
     if (vertexIndex < -nbVertices || vertexIndex > nbVertices || vertexIndex == 0)
         throw(Exception("DEFINE_FACE", errorMessage, line, lineIndex));
 
@@ -171,38 +318,55 @@ size_t ObjectParser::CalculateVertexIndex(ObjectData &objectData, const std::str
     return (vertexIndex);
 }
 
-size_t ObjectParser::CombineVertices(ObjectData &objectData, size_t vertexIndex, size_t textureVertexIndex)
+/*
+    a corner without normal gets (0, 0, 0), its normal is generated once the faces are known.
+    the corner is built on the stack, it is copied to the heap only if no combined vertex is the same
+*/
+size_t ObjectParser::CombineVertices(ObjectData &objectData, size_t vertexIndex, size_t textureVertexIndex,
+                                     size_t normalIndex)
 {
-    Vertex vertex = objectData.getVertices()[vertexIndex - 1];
-    Vertex textureVertex = objectData.getTextureVertices()[textureVertexIndex - 1];
-    Vertex combinedVertex;
+    const LoadStats::Span span(COMBINE_VERTICES_STAGE);
+    const Vertex &vertex = objectData.getVertex(vertexIndex - 1);
+    const Vertex &textureVertex = objectData.getTextureVertex(textureVertexIndex - 1);
+    std::array<float, 10> combinedVertex;
 
     for (size_t i = 0; i < 4; i++)
-        combinedVertex.push_back((vertex[i]));
+        combinedVertex[i] = vertex[i];
+    for (size_t i = 0; i < 3; i++)
+        combinedVertex[4 + i] = textureVertex[i];
     for (size_t i = 0; i < 3; i++)
-        combinedVertex.push_back((textureVertex[i]));
+        combinedVertex[7 + i] = (normalIndex == 0) ? 0 : objectData.getNormal(normalIndex - 1)[i];
 
-    std::vector<Vertex> combinedVertices = objectData.getCombinedVertices();
-    auto it = std::find(combinedVertices.begin(), combinedVertices.end(), combinedVertex);
-    if (it == combinedVertices.end())
-        objectData.addCombinedVertex(combinedVertex);
-    return (std::distance(combinedVertices.begin(), it));
+    for (size_t i = 0; i < objectData.getNbCombinedVertices(); i++)
+    {
+        const Vertex &storedVertex = objectData.getCombinedVertex(i);
+        if (std::equal(combinedVertex.begin(), combinedVertex.end(), storedVertex.begin(), storedVertex.end()))
+        {
+            LoadStats::add(DEDUP_HITS);
+            return (i);
+        }
+    }
+    objectData.addCombinedVertex(Vertex(combinedVertex.begin(), combinedVertex.end()));
+    LoadStats::add(UNIQUE_VERTICES);
+    return (objectData.getNbCombinedVertices() - 1);
 }
 
 void ObjectParser::triangulate(ObjectData &objectData, Face &face)
 {
+    const LoadStats::Span span(TRIANGULATE_STAGE);
+
     while (face.size() > 3)
     {
         for (size_t i = 1; i < face.size() - 1; i++)
         {
-            Vertex a = objectData.getCombinedVertices()[face[i]];
-            Vertex b = objectData.getCombinedVertices()[face[i - 1]];
-            Vertex c = objectData.getCombinedVertices()[face[i + 1]];
+            const Vertex &a = objectData.getCombinedVertex(face[i]);
+            const Vertex &b = objectData.getCombinedVertex(face[i - 1]);
+            const Vertex &c = objectData.getCombinedVertex(face[i + 1]);
 
             bool isEar = true;
-            for (size_t j = 0; j < objectData.getCombinedVertices().size(); j++)
+            for (size_t j = 0; j < objectData.getNbCombinedVertices(); j++)
             {
-                Vertex p = objectData.getCombinedVertices()[j];
+                const Vertex &p = objectData.getCombinedVertex(j);
                 if (p == a || p == b || p == c)
                     continue;
                 if (insideTriangle(p, a, b, c))
@@ -227,11 +391,14 @@ void ObjectParser::triangulate(ObjectData &objectData, Face &face)
                     }
                 }
                 objectData.addFace(newFace);
+                LoadStats::add(EARS_CLIPPED);
+                LoadStats::add(TRIANGLES);
                 break;
             }
         }
     }
     objectData.addFace(face);
+    LoadStats::add(TRIANGLES);
 }
 
 bool ObjectParser::insideTriangle(const Vertex &p, const Vertex &a, const Vertex &b, const Vertex &c)
@@ -249,15 +416,8 @@ bool ObjectParser::insideTriangle(const Vertex &p, const Vertex &a, const Vertex
 
 float ObjectParser::triangleArea(const Vertex &a, const Vertex &b, const Vertex &c)
 {
-    Vertex AB;
-    AB.push_back(b[0] - a[0]);
-    AB.push_back(b[1] - a[1]);
-    AB.push_back(b[2] - a[2]);
-
-    Vertex AC;
-    AC.push_back(c[0] - a[0]);
-    AC.push_back(c[1] - a[1]);
-    AC.push_back(c[2] - a[2]);
+    const std::array<float, 3> AB = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const std::array<float, 3> AC = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
 
     float dotProduct = AB[0] * AC[0] + AB[1] * AC[1] + AB[2] * AC[2];
     float magnitudeAB = sqrt(pow(AB[0], 2) + pow(AB[1], 2) + pow(AB[2], 2));
@@ -268,52 +428,54 @@ float ObjectParser::triangleArea(const Vertex &a, const Vertex &b, const Vertex
     return (area);
 }
 
+/*
+    "off" and 0 make the next faces flat,
+    "on" and the other numbers start a group of faces that share the normals of their common positions
+*/
 void ObjectParser::defineSmoothShading(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
+    long group;
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_SMOOTH_SHADING", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    if (words[1] == "on" || words[1] == "1")
-        objectData.setSmoothShading(true);
-    else if (words[1] == "off" || words[1] == "0")
-        objectData.setSmoothShading(false);
+    if (words[1] == "on")
+        objectData.setSmoothingGroup(1);
+    else if (words[1] == "off")
+        objectData.setSmoothingGroup(0);
+    else if (Utils::parseInt(words[1], group) && group >= 0 && group <= UINT_MAX)
+        objectData.setSmoothingGroup(group);
     else
         throw(Exception("DEFINE_SMOOTH_SHADING", "INVALID_ARGUMENT", line, lineIndex));
 }
 
+/*
+    the material file is parsed in the background,
+    it is only waited for when one of its materials is used
+*/
 void ObjectParser::saveNewMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
     (void)objectData;
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("CREATE_NEW_MTL", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    std::vector<Material> newMaterials = MaterialParser::parseMaterialFile(words[1]);
-    materials.insert(materials.end(), newMaterials.begin(), newMaterials.end());
+    MaterialRegistry::prefetch(std::string(words[1]));
 }
 
 void ObjectParser::defineMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex)
 {
-    std::vector<std::string> words;
+    const std::pmr::vector<std::string_view> words = Utils::splitLine(line, arena);
 
-    words = Utils::splitLine(line, " ");
     if (words.size() != 2)
         throw(Exception("DEFINE_MTL", "INVALID_NUMBER_OF_ARGUMENTS", line, lineIndex));
 
-    for (size_t i = 0; i < materials.size(); i++)
-    {
-        if (materials[i].getName() == words[1])
-        {
-            objectData.setMaterial(materials[i]);
-            return;
-        }
-    }
-    throw(Exception("DEFINE_MTL", "INVALID_ARGUMENT", line, lineIndex));
+    const std::string name(words[1]);
+    if (!MaterialRegistry::hasMaterial(name))
+        throw(Exception("DEFINE_MTL", "INVALID_ARGUMENT", line, lineIndex));
+    objectData.useMaterial(MaterialRegistry::getMaterialID(name));
 }
 
 ObjectParser::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
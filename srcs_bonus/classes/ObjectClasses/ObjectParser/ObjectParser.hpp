@@ -4,38 +4,51 @@
 #include "../Object/Object.hpp"
 #include "../ObjectData/ObjectData.hpp"
 #include <map>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 typedef enum vertexType
 {
     CLASSIC,
-    TEXTURE
+    TEXTURE,
+    NORMAL
 } e_vertexType;
 
-typedef std::map<std::string, void (*)(ObjectData &, const std::string &, unsigned int)> MapObjectParsingMethods;
+#define PARSER_ARENA_SIZE 16384 // the temporary data of a line usually fits, a longer line spills to the heap
+
+typedef std::map<std::string, void (*)(ObjectData &, const std::string &, unsigned int), std::less<>>
+    MapObjectParsingMethods;
 
 class ObjectParser
 {
   private:
-    static size_t CalculateVertexIndex(ObjectData &objectData, const std::string &vertex, e_vertexType vertexType,
+    static size_t CalculateVertexIndex(ObjectData &objectData, std::string_view vertex, e_vertexType vertexType,
                                        const std::string &line, unsigned int lineIndex);
-    static size_t CombineVertices(ObjectData &objectData, size_t vertexIndex, size_t textureVertexIndex);
+    static size_t CombineVertices(ObjectData &objectData, size_t vertexIndex, size_t textureVertexIndex,
+                                  size_t normalIndex);
 
     static float triangleArea(const Vertex &a, const Vertex &b, const Vertex &c);
     static bool insideTriangle(const Vertex &p, const Vertex &a, const Vertex &b, const Vertex &c);
     static void triangulate(ObjectData &objectData, Face &face);
 
+    static std::array<float, 3> sceneCenter(const std::vector<Object> &objects);
+    static std::vector<Object> mergeInstances(std::vector<Object> &&objects);
+
+    static void parseLine(ObjectData &objectData, std::vector<Object> &objects, std::string &line,
+                          unsigned int lineIndex);
     static void defineName(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
 
     static void defineVertex(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static void defineTextureVertex(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
+    static void defineNormal(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static void defineFace(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static void defineSmoothShading(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static void saveNewMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static void defineMTL(ObjectData &objectData, const std::string &line, unsigned int lineIndex);
     static MapObjectParsingMethods parsingMethods;
-
-    static std::vector<Material> materials;
+    static thread_local std::pmr::memory_resource *arena; // per thread, files can be parsed at the same time
 
     class Exception : public std::exception
     {
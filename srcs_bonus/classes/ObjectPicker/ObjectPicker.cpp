@@ -0,0 +1,182 @@
+#include "ObjectPicker.hpp"
+#include <algorithm>
+#include <cstring>
+
+ObjectPicker::ObjectPicker(const std::string &vertexPath, const std::string &fragmentPath,
+                           const std::string &vertexInputs)
+    : shader(vertexPath, fragmentPath, vertexInputs)
+{
+    allocatedSize = {0, 0};
+    fence = NULL;
+}
+
+ObjectPicker::~ObjectPicker()
+{
+    if (fence != NULL)
+        glDeleteSync(fence);
+}
+
+/*
+    the pixel holds the index of the object + 1, 0 is the background
+*/
+s_pickResult ObjectPicker::decode(const unsigned int pixel[4])
+{
+    if (pixel[0] == 0)
+        return (s_pickResult{false, 0, 0, 0});
+    return (s_pickResult{true, pixel[0] - 1, pixel[1], pixel[2]});
+}
+
+/*
+    the sub meshes are sorted by their first face
+*/
+size_t ObjectPicker::findSubMesh(const std::vector<s_subMesh> &subMeshes, size_t face)
+{
+    const auto next =
+        std::upper_bound(subMeshes.begin(), subMeshes.end(), face,
+                         [](size_t value, const s_subMesh &subMesh) { return (value < subMesh.firstFace); });
+
+    if (next == subMeshes.begin())
+        throw(Exception("FIND_SUB_MESH", "INVALID_FACE", std::to_string(face)));
+    const size_t index = next - subMeshes.begin() - 1;
+    if (face >= subMeshes[index].firstFace + subMeshes[index].nbFaces)
+        throw(Exception("FIND_SUB_MESH", "INVALID_FACE", std::to_string(face)));
+    return (index);
+}
+
+bool ObjectPicker::isPending() const
+{
+    return (fence != NULL);
+}
+
+/*
+    the framebuffer follows the size of the window, the picked pixel is in its coordinates
+*/
+void ObjectPicker::allocate(const std::array<int, 2> &size)
+{
+    if (framebuffer.get() != 0 && size == allocatedSize)
+        return;
+    if (framebuffer.get() == 0)
+    {
+        framebuffer = FramebufferHandle::create();
+        idBuffer = RenderbufferHandle::create();
+        depthBuffer = RenderbufferHandle::create();
+        pixelBuffer = BufferHandle::create();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer.get());
+        glBufferData(GL_PIXEL_PACK_BUFFER, 4 * sizeof(unsigned int), NULL, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, idBuffer.get());
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA32UI, size[0], size[1]);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer.get());
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size[0], size[1]);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.get());
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, idBuffer.get());
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer.get());
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw(Exception("ALLOCATE", "INCOMPLETE_FRAMEBUFFER",
+                        std::to_string(size[0]) + " * " + std::to_string(size[1]) + ", status " +
+                            std::to_string(status)));
+    allocatedSize = size;
+}
+
+/*
+    a single draw per object from its first index, so gl_PrimitiveID is the index of the face.
+    it starts again for each instance
+*/
+void ObjectPicker::drawObjects(const std::vector<Object> &objects)
+{
+    const int objectLocation = glGetUniformLocation(shader.getID(), "objectID");
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const std::vector<s_subMesh> subMeshes = objects[i].getSubMeshes();
+        if (subMeshes.empty() || !objects[i].isVAOInit())
+            continue;
+        const size_t nbFaces = subMeshes.back().firstFace + subMeshes.back().nbFaces;
+        glUniform1ui(objectLocation, i + 1);
+        glBindVertexArray(objects[i].getVAO());
+        glDrawElementsInstanced(GL_TRIANGLES, nbFaces * 3, GL_UNSIGNED_INT, NULL, objects[i].getInstances().size());
+    }
+    glBindVertexArray(0);
+}
+
+/*
+    called after the frame is rendered, with the rotation and the camera of the frame.
+    (x, y) is a pixel of the window, from its bottom left corner.
+    the state changed here (framebuffer, viewport, scissor) is restored for the next frame
+*/
+void ObjectPicker::pick(const std::vector<Object> &objects, const Matrix &rotation, const Camera &camera,
+                        const std::array<int, 2> &windowSize, int x, int y)
+{
+    const unsigned int background[4] = {0, 0, 0, 0};
+
+    if (fence != NULL || x < 0 || y < 0 || x >= windowSize[0] || y >= windowSize[1])
+        return;
+    allocate(windowSize);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.get());
+    glViewport(0, 0, windowSize[0], windowSize[1]);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, y, 1, 1);
+    glClearBufferuiv(GL_COLOR, 0, background);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    shader.use();
+    shader.setMat4("rotation", rotation);
+    shader.setMat4("projection", camera.getProjection());
+    shader.setMat4("view", camera.getView());
+    drawObjects(objects);
+    glDisable(GL_SCISSOR_TEST);
+
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer.get());
+    glReadPixels(x, y, 1, 1, GL_RGBA_INTEGER, GL_UNSIGNED_INT, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowSize[0], windowSize[1]);
+}
+
+/*
+    false while the GPU hasn't drawn the pick, the buffer is only mapped once it's ready.
+    a pick that can't be read is lost
+*/
+bool ObjectPicker::getResult(s_pickResult &result)
+{
+    unsigned int pixel[4];
+
+    if (fence == NULL)
+        return (false);
+    const GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+        return (false);
+    glDeleteSync(fence);
+    fence = NULL;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer.get());
+    const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(pixel), GL_MAP_READ_BIT);
+    if (data == NULL)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return (false);
+    }
+    std::memcpy(pixel, data, sizeof(pixel));
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    result = decode(pixel);
+    return (true);
+}
+
+ObjectPicker::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                   const std::string &context)
+{
+    this->errorMessage = "OBJECT_PICKER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + context + "\n|";
+}
+
+const char *ObjectPicker::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
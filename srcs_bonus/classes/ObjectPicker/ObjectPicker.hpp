@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../Camera/Camera.hpp"
+#include "../GLHandle/GLHandle.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../ObjectClasses/Object/Object.hpp"
+#include "../Shader/Shader.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+// what is drawn at the picked pixel
+typedef struct pickResult
+{
+    bool hit;            // false on the background
+    unsigned int object; // index in the objects of the scene
+    unsigned int instance;
+    unsigned int face; // index of the triangle in the object, as in its sub meshes
+} s_pickResult;
+
+/**
+ * finds the object and the triangle drawn at a pixel of the window without waiting for the GPU.
+ * on request the scene is drawn again in an integer framebuffer, each fragment writes the index of its object,
+ * its instance and its triangle. a scissor of a single pixel keeps the pass as cheap as its vertices.
+ * the pixel is copied to a pixel buffer object and fenced, it's read a frame or two later once the fence is signaled
+ */
+class ObjectPicker
+{
+  private:
+    ObjectPicker() = delete;
+    ObjectPicker(const ObjectPicker &copy) = delete;
+    ObjectPicker &operator=(const ObjectPicker &copy) = delete;
+
+    Shader shader;
+    FramebufferHandle framebuffer;
+    RenderbufferHandle idBuffer;
+    RenderbufferHandle depthBuffer;
+    std::array<int, 2> allocatedSize;
+    BufferHandle pixelBuffer;
+    GLsync fence; // NULL when no pick is waiting
+
+    void allocate(const std::array<int, 2> &size);
+    void drawObjects(const std::vector<Object> &objects);
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &context);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    ObjectPicker(const std::string &vertexPath, const std::string &fragmentPath, const std::string &vertexInputs);
+    ~ObjectPicker();
+
+    static s_pickResult decode(const unsigned int pixel[4]);
+    static size_t findSubMesh(const std::vector<s_subMesh> &subMeshes, size_t face);
+
+    bool isPending() const;
+
+    void pick(const std::vector<Object> &objects, const Matrix &rotation, const Camera &camera,
+              const std::array<int, 2> &windowSize, int x, int y);
+    bool getResult(s_pickResult &result);
+};
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "ProgramCache.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+bool ProgramCache::supported = false;
+PFNGLGETPROGRAMBINARYPROC ProgramCache::getProgramBinary = NULL;
+PFNGLPROGRAMBINARYPROC ProgramCache::programBinary = NULL;
+PFNGLPROGRAMPARAMETERIPROC ProgramCache::programParameteri = NULL;
+
+/*
+    called once the context is current, with the loader given to glad.
+    the cache stays disabled if the driver can't give back any binary format
+*/
+void ProgramCache::loadFunctions(GLADloadproc load)
+{
+    GLint major;
+    GLint minor;
+    GLint nbExtensions;
+    GLint nbFormats = 0;
+    bool extension = false;
+
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    glGetIntegerv(GL_NUM_EXTENSIONS, &nbExtensions);
+    for (GLint i = 0; i < nbExtensions && !extension; i++)
+    {
+        const char *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+        extension = (name != NULL && std::strcmp(name, "GL_ARB_get_program_binary") == 0);
+    }
+    supported = false;
+    if (!extension && (major < 4 || (major == 4 && minor < 1)))
+        return;
+    getProgramBinary = reinterpret_cast<PFNGLGETPROGRAMBINARYPROC>(load("glGetProgramBinary"));
+    programBinary = reinterpret_cast<PFNGLPROGRAMBINARYPROC>(load("glProgramBinary"));
+    programParameteri = reinterpret_cast<PFNGLPROGRAMPARAMETERIPROC>(load("glProgramParameteri"));
+    if (getProgramBinary == NULL || programBinary == NULL || programParameteri == NULL)
+        return;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nbFormats);
+    supported = (nbFormats > 0);
+}
+
+bool ProgramCache::isSupported()
+{
+    return (supported);
+}
+
+std::string ProgramCache::getDriver()
+{
+    const GLenum names[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    std::string driver;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        const char *name = reinterpret_cast<const char *>(glGetString(names[i]));
+        driver += std::string((name != NULL) ? name : "") + "\n";
+    }
+    return (driver);
+}
+
+/*
+    FNV-1a over the sources and the driver, each part ends with a null byte
+    so moving text from one part to the next changes the key
+*/
+uint64_t ProgramCache::getKey(const std::string &vertexCode, const std::string &fragmentCode,
+                              const std::string &driver)
+{
+    const std::string *parts[3] = {&vertexCode, &fragmentCode, &driver};
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j <= parts[i]->size(); j++)
+        {
+            hash ^= static_cast<unsigned char>((j < parts[i]->size()) ? (*parts[i])[j] : '\0');
+            hash *= 1099511628211ULL;
+        }
+    }
+    return (hash);
+}
+
+std::string ProgramCache::getPath(uint64_t key)
+{
+    std::ostringstream path;
+
+    path << PROGRAM_CACHE_DIRECTORY << "/" << std::hex << key << PROGRAM_CACHE_EXTENSION;
+    return (path.str());
+}
+
+void ProgramCache::writeUint(std::vector<unsigned char> &buffer, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+        buffer.push_back((value >> (i * 8)) & 0xFF);
+}
+
+uint64_t ProgramCache::readUint(const unsigned char *data, size_t size)
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < size; i++)
+        value |= static_cast<uint64_t>(data[i]) << (i * 8);
+    return (value);
+}
+
+std::vector<unsigned char> ProgramCache::serialize(uint64_t key, const s_programBinary &binary)
+{
+    std::vector<unsigned char> file = {'S', 'P', 'B', '1'};
+
+    writeUint(file, key, 8);
+    writeUint(file, binary.format, 4);
+    writeUint(file, binary.data.size(), 4);
+    file.insert(file.end(), binary.data.begin(), binary.data.end());
+    return (file);
+}
+
+/*
+    false for a file of another version, of other sources or another driver, or cut short
+*/
+bool ProgramCache::parse(const std::vector<unsigned char> &file, uint64_t key, s_programBinary &binary)
+{
+    if (file.size() < PROGRAM_CACHE_HEADER_SIZE || std::memcmp(file.data(), "SPB1", 4) != 0)
+        return (false);
+    if (readUint(file.data() + 4, 8) != key)
+        return (false);
+    const size_t size = readUint(file.data() + 16, 4);
+    if (size == 0 || file.size() != PROGRAM_CACHE_HEADER_SIZE + size)
+        return (false);
+    binary.format = readUint(file.data() + 12, 4);
+    binary.data.assign(file.begin() + PROGRAM_CACHE_HEADER_SIZE, file.end());
+    return (true);
+}
+
+/*
+    before the link, some drivers only keep the binary of a program that asked for it
+*/
+void ProgramCache::prepare(GLuint program)
+{
+    if (supported)
+        programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+/*
+    the program is linked from the binary if the driver accepts it,
+    a rejected binary is removed so it is replaced by the next save
+*/
+bool ProgramCache::load(GLuint program, const std::string &vertexCode, const std::string &fragmentCode)
+{
+    s_programBinary binary;
+    GLint success = 0;
+
+    if (!supported)
+        return (false);
+    const uint64_t key = getKey(vertexCode, fragmentCode, getDriver());
+    const std::string path = getPath(key);
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open())
+        return (false);
+    const std::vector<unsigned char> file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    if (parse(file, key, binary))
+    {
+        programBinary(program, binary.format, binary.data.data(), binary.data.size());
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+    }
+    if (!success)
+    {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+    return (success);
+}
+
+/*
+    a cache that can't be written only slows down the next start, it isn't an error
+*/
+bool ProgramCache::save(GLuint program, const std::string &vertexCode, const std::string &fragmentCode)
+{
+    s_programBinary binary;
+    GLint length = 0;
+    GLsizei written = 0;
+    std::error_code error;
+
+    if (!supported)
+        return (false);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return (false);
+    binary.data.resize(length);
+    getProgramBinary(program, length, &written, &binary.format, binary.data.data());
+    if (written <= 0)
+        return (false);
+    binary.data.resize(written);
+
+    const uint64_t key = getKey(vertexCode, fragmentCode, getDriver());
+    const std::vector<unsigned char> file = serialize(key, binary);
+    std::filesystem::create_directories(PROGRAM_CACHE_DIRECTORY, error);
+    std::ofstream output(getPath(key), std::ios::binary);
+    if (error || !output.is_open())
+        return (false);
+    output.write(reinterpret_cast<const char *>(file.data()), file.size());
+    return (output.good());
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../../../libs/glad/glad.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// not part of the core profile, available with GL_ARB_get_program_binary or OpenGL 4.1
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+#define PROGRAM_CACHE_DIRECTORY ".scop_cache" // relative to the working directory, like the paths of the shaders
+#define PROGRAM_CACHE_EXTENSION ".spb"
+#define PROGRAM_CACHE_HEADER_SIZE 20 // magic number (4), key (8), binary format (4), binary size (4)
+
+typedef void(APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei *length,
+                                                  GLenum *binaryFormat, void *binary);
+typedef void(APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void *binary,
+                                               GLsizei length);
+typedef void(APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+// a linked program as returned by the driver
+typedef struct programBinary
+{
+    GLenum format;
+    std::vector<unsigned char> data;
+} s_programBinary;
+
+/**
+ * the linked programs saved on the disk, so the next start doesn't compile the shaders again.
+ * a binary is only valid for the driver that produced it: the key hashes the sources with the vendor,
+ * the renderer and the version of OpenGL, and the driver can still reject it after an update.
+ * a missing, foreign or rejected binary is never an error, the shaders are compiled instead.
+ * the functions aren't part of the core profile loaded by glad, they are loaded after it
+ */
+class ProgramCache
+{
+  private:
+    ProgramCache() = delete;
+
+    static bool supported;
+    static PFNGLGETPROGRAMBINARYPROC getProgramBinary;
+    static PFNGLPROGRAMBINARYPROC programBinary;
+    static PFNGLPROGRAMPARAMETERIPROC programParameteri;
+
+    static std::string getDriver();
+    static std::string getPath(uint64_t key);
+    static void writeUint(std::vector<unsigned char> &buffer, uint64_t value, size_t size);
+    static uint64_t readUint(const unsigned char *data, size_t size);
+
+  public:
+    static void loadFunctions(GLADloadproc load);
+    static bool isSupported();
+
+    static uint64_t getKey(const std::string &vertexCode, const std::string &fragmentCode, const std::string &driver);
+    static std::vector<unsigned char> serialize(uint64_t key, const s_programBinary &binary);
+    static bool parse(const std::vector<unsigned char> &file, uint64_t key, s_programBinary &binary);
+
+    static void prepare(GLuint program);
+    static bool load(GLuint program, const std::string &vertexCode, const std::string &fragmentCode);
+    static bool save(GLuint program, const std::string &vertexCode, const std::string &fragmentCode);
+};
\ No newline at end of file
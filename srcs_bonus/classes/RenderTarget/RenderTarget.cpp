@@ -0,0 +1,149 @@
+#include "RenderTarget.hpp"
+
+RenderTarget::RenderTarget()
+{
+    width = 0;
+    height = 0;
+    allocatedSize = {0, 0};
+    windowSize = {0, 0};
+    offscreen = false;
+    for (size_t i = 0; i < timedFrames.size(); i++)
+    {
+        timedFrames[i].scale = 1;
+        timedFrames[i].pending = false;
+    }
+    nextFrame = 0;
+    timing = false;
+}
+
+/*
+    the framebuffer has the size of the window, a lower resolution only uses its bottom left corner.
+    so a change of the resolution doesn't allocate anything, only a resize of the window does
+*/
+void RenderTarget::allocate(const std::array<int, 2> &size)
+{
+    if (framebuffer.get() != 0 && size == allocatedSize)
+        return;
+    if (framebuffer.get() == 0)
+    {
+        framebuffer = FramebufferHandle::create();
+        colorBuffer = RenderbufferHandle::create();
+        depthBuffer = RenderbufferHandle::create();
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer.get());
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size[0], size[1]);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer.get());
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size[0], size[1]);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.get());
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer.get());
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer.get());
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw(Exception("ALLOCATE", "INCOMPLETE_FRAMEBUFFER",
+                        std::to_string(size[0]) + " * " + std::to_string(size[1]) + ", status " +
+                            std::to_string(status)));
+    allocatedSize = size;
+}
+
+/*
+    the commands of the frame come after begin, the window is cleared by the caller.
+    a frame isn't measured if the results of the oldest measure haven't been read yet
+*/
+void RenderTarget::begin(const std::array<int, 2> &size, const std::array<int, 2> &windowSize)
+{
+    s_timedFrame &frame = timedFrames[nextFrame];
+
+    this->windowSize = windowSize;
+    width = size[0];
+    height = size[1];
+    offscreen = (size != windowSize);
+    timing = !frame.pending;
+    if (timing)
+    {
+        if (frame.start.get() == 0)
+        {
+            frame.start = QueryHandle::create();
+            frame.end = QueryHandle::create();
+        }
+        frame.scale = (windowSize[0] > 0) ? static_cast<float>(width) / windowSize[0] : 1;
+        glQueryCounter(frame.start.get(), GL_TIMESTAMP);
+    }
+    if (!offscreen)
+        return;
+    allocate(windowSize);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.get());
+    glViewport(0, 0, width, height);
+}
+
+/*
+    the image is stretched over the window with a linear filter
+*/
+void RenderTarget::end()
+{
+    if (offscreen)
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.get());
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, windowSize[0], windowSize[1], GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, windowSize[0], windowSize[1]);
+    }
+    if (timing)
+    {
+        glQueryCounter(timedFrames[nextFrame].end.get(), GL_TIMESTAMP);
+        timedFrames[nextFrame].pending = true;
+        nextFrame = (nextFrame + 1) % timedFrames.size();
+    }
+}
+
+/*
+    the GPU time of the oldest measured frame and the scale it was rendered at,
+    false if the GPU hasn't finished it yet
+*/
+bool RenderTarget::getFrameTime(double &frameTime, float &scale)
+{
+    for (size_t i = 0; i < timedFrames.size(); i++)
+    {
+        s_timedFrame &frame = timedFrames[(nextFrame + i) % timedFrames.size()];
+        if (!frame.pending)
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(frame.end.get(), GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return (false);
+        GLuint64 start;
+        GLuint64 end;
+        glGetQueryObjectui64v(frame.start.get(), GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(frame.end.get(), GL_QUERY_RESULT, &end);
+        frame.pending = false;
+        frameTime = static_cast<double>(end - start) / 1e9;
+        scale = frame.scale;
+        return (true);
+    }
+    return (false);
+}
+
+int RenderTarget::getWidth() const
+{
+    return (width);
+}
+
+int RenderTarget::getHeight() const
+{
+    return (height);
+}
+
+RenderTarget::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                   const std::string &context)
+{
+    this->errorMessage = "RENDER_TARGET::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + context + "\n|";
+}
+
+const char *RenderTarget::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
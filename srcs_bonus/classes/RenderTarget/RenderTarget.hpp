@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../GLHandle/GLHandle.hpp"
+#include <array>
+#include <string>
+
+#define RENDER_TARGET_TIMED_FRAMES 4 // frames measured at the same time, a result is read a few frames later
+
+/**
+ * where a frame is rendered: the window itself at its native resolution,
+ * or an offscreen framebuffer of a lower resolution that is stretched over the window at the end of the frame.
+ * the GPU time of each frame is measured with two timestamps, the results are read without waiting for the GPU.
+ * the timestamps can be taken while a timer of the profiler is running
+ */
+class RenderTarget
+{
+  private:
+    RenderTarget(const RenderTarget &copy) = delete;
+    RenderTarget &operator=(const RenderTarget &copy) = delete;
+
+    typedef struct timedFrame
+    {
+        QueryHandle start;
+        QueryHandle end;
+        float scale;
+        bool pending;
+    } s_timedFrame;
+
+    FramebufferHandle framebuffer;
+    RenderbufferHandle colorBuffer;
+    RenderbufferHandle depthBuffer;
+    std::array<int, 2> allocatedSize;
+    int width; // the part of the framebuffer used by the current frame
+    int height;
+    std::array<int, 2> windowSize;
+    bool offscreen; // the current frame is rendered in the framebuffer
+    std::array<s_timedFrame, RENDER_TARGET_TIMED_FRAMES> timedFrames;
+    size_t nextFrame;
+    bool timing; // the current frame is measured
+
+    void allocate(const std::array<int, 2> &size);
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &context);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    RenderTarget();
+    RenderTarget(RenderTarget &&move) = default;
+    RenderTarget &operator=(RenderTarget &&move) = default;
+
+    void begin(const std::array<int, 2> &size, const std::array<int, 2> &windowSize);
+    void end();
+    bool getFrameTime(double &frameTime, float &scale);
+
+    int getWidth() const;
+    int getHeight() const;
+};
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "ResolutionScaler.hpp"
+#include <algorithm>
+#include <cmath>
+
+ResolutionScaler::ResolutionScaler()
+{
+    enabled = true;
+    budget = DEFAULT_GPU_BUDGET;
+    scale = 1;
+    averageTime = 0;
+    moving = false;
+    lastMovement = 0;
+}
+
+ResolutionScaler::ResolutionScaler(double budget, bool enabled)
+{
+    this->enabled = enabled;
+    setBudget(budget);
+    scale = 1;
+    averageTime = 0;
+    moving = false;
+    lastMovement = 0;
+}
+
+ResolutionScaler::ResolutionScaler(const ResolutionScaler &copy)
+{
+    *this = copy;
+}
+
+ResolutionScaler &ResolutionScaler::operator=(const ResolutionScaler &copy)
+{
+    if (&copy != this)
+    {
+        enabled = copy.isEnabled();
+        budget = copy.getBudget();
+        scale = copy.getScale();
+        averageTime = copy.getAverageTime();
+        moving = copy.moving;
+        lastMovement = copy.lastMovement;
+    }
+    return (*this);
+}
+
+ResolutionScaler::~ResolutionScaler()
+{
+}
+
+bool ResolutionScaler::isEnabled() const
+{
+    return (enabled);
+}
+
+bool ResolutionScaler::isNative() const
+{
+    return (scale >= 1);
+}
+
+double ResolutionScaler::getBudget() const
+{
+    return (budget);
+}
+
+float ResolutionScaler::getScale() const
+{
+    return (scale);
+}
+
+double ResolutionScaler::getAverageTime() const
+{
+    return (averageTime);
+}
+
+/*
+    the size of the image rendered for a window of width * height pixels, at least 1 * 1
+*/
+std::array<int, 2> ResolutionScaler::getSize(int width, int height) const
+{
+    if (isNative())
+        return (std::array<int, 2>{width, height});
+    return (std::array<int, 2>{std::max(1, static_cast<int>(std::lround(width * scale))),
+                               std::max(1, static_cast<int>(std::lround(height * scale)))});
+}
+
+/*
+    the average frame time is kept for the new number of pixels
+*/
+void ResolutionScaler::setScale(float scale)
+{
+    averageTime *= (scale * scale) / (this->scale * this->scale);
+    this->scale = scale;
+}
+
+void ResolutionScaler::setEnabled(bool enabled)
+{
+    this->enabled = enabled;
+    if (!enabled)
+        setScale(1);
+}
+
+void ResolutionScaler::setBudget(double budget)
+{
+    if (budget <= 0)
+        throw(Exception("SET_BUDGET", "INVALID_BUDGET", budget));
+    this->budget = budget;
+}
+
+/*
+    called once per frame, the native resolution comes back once the view has been still for a moment,
+    a short pause between two movements of the mouse keeps the low resolution
+*/
+void ResolutionScaler::update(double time, bool moving)
+{
+    this->moving = moving;
+    if (moving)
+        lastMovement = time;
+    else if (time - lastMovement >= RESOLUTION_SETTLE_TIME)
+        setScale(1);
+}
+
+/*
+    the GPU time of a frame rendered at frameScale.
+    the measures arrive a few frames late, a frame rendered before the last change
+    is corrected by the change of its number of pixels, so it doesn't change the scale twice
+*/
+void ResolutionScaler::addFrameTime(double frameTime, float frameScale)
+{
+    if (frameTime <= 0 || frameScale <= 0)
+        return;
+    frameTime *= (scale * scale) / (frameScale * frameScale);
+    if (averageTime == 0)
+        averageTime = frameTime;
+    else
+        averageTime += (frameTime - averageTime) * RESOLUTION_SMOOTHING;
+    if (!enabled || !moving || std::fabs(averageTime - budget) <= budget * RESOLUTION_TOLERANCE)
+        return;
+
+    const float step = std::sqrt(static_cast<float>(budget / averageTime));
+    const float newScale = std::clamp(scale * std::clamp(step, 1 - RESOLUTION_MAX_STEP, 1 + RESOLUTION_MAX_STEP),
+                                      RESOLUTION_MIN_SCALE, 1.0f);
+
+    setScale(newScale);
+}
+
+ResolutionScaler::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                       double value)
+{
+    this->errorMessage = "RESOLUTION_SCALER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + std::to_string(value) + "\n|";
+}
+
+const char *ResolutionScaler::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
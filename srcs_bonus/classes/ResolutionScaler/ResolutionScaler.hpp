@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+#define DEFAULT_GPU_BUDGET 0.012     // seconds of GPU time per frame, under the 16.7ms of 60 fps
+#define RESOLUTION_MIN_SCALE 0.25f   // of the width and the height of the window
+#define RESOLUTION_MAX_STEP 0.1f     // the highest change of the scale for a single measure
+#define RESOLUTION_TOLERANCE 0.1     // the frame time can be 10% away from the budget without changing the scale
+#define RESOLUTION_SMOOTHING 0.25    // weight of the last measure in the average frame time
+#define RESOLUTION_SETTLE_TIME 0.25  // seconds without movement before going back to the native resolution
+
+/**
+ * chooses the resolution the scene is rendered at to hold a GPU frame time budget.
+ * the number of pixels follows the square of the scale, so the scale moves
+ * by the square root of the ratio between the budget and the average frame time.
+ * the resolution only drops while the view moves, a still image is rendered at the size of the window
+ */
+class ResolutionScaler
+{
+  private:
+    bool enabled;
+    double budget;       // seconds
+    float scale;         // 1 is the native resolution
+    double averageTime;  // seconds at the current scale, 0 before the first measure
+    bool moving;
+    double lastMovement; // seconds
+
+    void setScale(float scale);
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, double value);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    ResolutionScaler();
+    ResolutionScaler(double budget, bool enabled);
+    ResolutionScaler(const ResolutionScaler &copy);
+    ResolutionScaler &operator=(const ResolutionScaler &copy);
+    ~ResolutionScaler();
+
+    bool isEnabled() const;
+    bool isNative() const;
+    double getBudget() const;
+    float getScale() const;
+    double getAverageTime() const;
+    std::array<int, 2> getSize(int width, int height) const;
+
+    void setEnabled(bool enabled);
+    void setBudget(double budget);
+
+    void update(double time, bool moving);
+    void addFrameTime(double frameTime, float frameScale);
+};
\ No newline at end of file
@@ -1,39 +1,48 @@
 #include "Shader.hpp"
+#include "../LoadStats/LoadStats.hpp"
+#include "../ProgramCache/ProgramCache.hpp"
 #include "../Utils/Utils.hpp"
 
-Shader::Shader()
-{
-    ID = 0;
-}
-
-Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath)
-{
-
-    const std::string vertexCode = Utils::readFile(vertexPath).str();
-    const std::string fragmentCode = Utils::readFile(fragmentPath).str();
+/*
+    the inputs of the vertex shader are generated from the vertex layout of the objects.
+    the defines are seen by both stages, a variant of the same files only compiles the features it uses.
+    the program of a previous start is reused when the cache has it for the same sources and driver
+*/
+Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath, const std::string &vertexInputs,
+               const std::string &defines)
+{
+    const LoadStats::Stage stage(COMPILE_SHADERS_STAGE);
+    const std::string vertexCode =
+        insertAfterVersion(Utils::readFile(vertexPath).str(), defines + vertexInputs, vertexPath);
+    const std::string fragmentCode = insertAfterVersion(Utils::readFile(fragmentPath).str(), defines, fragmentPath);
+
+    program = ProgramHandle::create();
+    if (ProgramCache::load(program.get(), vertexCode, fragmentCode))
+    {
+        LoadStats::add(PROGRAM_CACHE_HITS);
+        return;
+    }
     const unsigned int vertex = compileShader(vertexCode.c_str(), GL_VERTEX_SHADER);
     const unsigned int fragment = compileShader(fragmentCode.c_str(), GL_FRAGMENT_SHADER);
     compileProgram(vertex, fragment);
+    ProgramCache::save(program.get(), vertexCode, fragmentCode);
 }
 
-Shader::Shader(const Shader &copy)
-{
-    *this = copy;
-}
-
-Shader &Shader::operator=(const Shader &copy)
+/*
+    nothing can come before the #version directive
+*/
+std::string Shader::insertAfterVersion(const std::string &code, const std::string &text, const std::string &path)
 {
-    if (&copy != this)
-    {
-        ID = copy.getID();
-    }
-    return (*this);
-}
+    const size_t version = code.find("#version");
 
-Shader::~Shader()
-{
-    if (ID != 0)
-        glDeleteProgram(ID);
+    if (text.empty())
+        return (code);
+    if (version == std::string::npos)
+        throw(Exception("INSERT_AFTER_VERSION", "NO_VERSION", path));
+    const size_t lineEnd = code.find('\n', version);
+    if (lineEnd == std::string::npos)
+        return (code + "\n" + text);
+    return (code.substr(0, lineEnd + 1) + text + code.substr(lineEnd + 1));
 }
 
 unsigned int Shader::compileShader(const char *shaderCode, const GLenum &shaderType)
@@ -62,18 +71,18 @@ void Shader::compileProgram(unsigned int vertex, unsigned int fragment)
     char infoLogChar[512];
     std::string infoLogString;
 
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
+    ProgramCache::prepare(program.get());
+    glAttachShader(program.get(), vertex);
+    glAttachShader(program.get(), fragment);
+    glLinkProgram(program.get());
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
 
-    glGetProgramiv(ID, GL_LINK_STATUS, &success);
+    glGetProgramiv(program.get(), GL_LINK_STATUS, &success);
     if (!success)
     {
-        glGetProgramInfoLog(ID, 512, NULL, infoLogChar);
+        glGetProgramInfoLog(program.get(), 512, NULL, infoLogChar);
         infoLogString = infoLogChar;
         throw(Exception("COMPILE_PROGRAM", "LINKAGE_FAILED", infoLogString));
     }
@@ -81,79 +90,91 @@ void Shader::compileProgram(unsigned int vertex, unsigned int fragment)
 
 void Shader::use() const
 {
-    glUseProgram(ID);
+    glUseProgram(program.get());
 }
 
 void Shader::setInt(const std::string &name, int value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1i(glGetUniformLocation(program.get(), name.c_str()), value);
 }
 
 void Shader::setFloat(const std::string &name, float value) const
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1f(glGetUniformLocation(program.get(), name.c_str()), value);
 }
 
 void Shader::setVec2(const std::string &name, const Matrix &vector) const
 {
     if (vector.getRows() != 2 || vector.getColumns() != 1)
         throw(Exception("SET_VEC2", "INVALID_SIZE", vector));
-    glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, vector.getData());
+    glUniform2fv(glGetUniformLocation(program.get(), name.c_str()), 1, vector.getData());
 }
 
 void Shader::setVec2(const std::string &name, float x, float y) const
 {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+    glUniform2f(glGetUniformLocation(program.get(), name.c_str()), x, y);
 }
 
 void Shader::setVec3(const std::string &name, const Matrix &vector) const
 {
     if (vector.getRows() != 3 || vector.getColumns() != 1)
         throw(Exception("SET_VEC3", "INVALID_SIZE", vector));
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, vector.getData());
+    glUniform3fv(glGetUniformLocation(program.get(), name.c_str()), 1, vector.getData());
 }
 
 void Shader::setVec3(const std::string &name, float x, float y, float z) const
 {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+    glUniform3f(glGetUniformLocation(program.get(), name.c_str()), x, y, z);
 }
 
 void Shader::setVec4(const std::string &name, const Matrix &vector) const
 {
     if (vector.getRows() != 4 || vector.getColumns() != 1)
         throw(Exception("SET_VEC4", "INVALID_SIZE", vector));
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, vector.getData());
+    glUniform4fv(glGetUniformLocation(program.get(), name.c_str()), 1, vector.getData());
 }
 
 void Shader::setVec4(const std::string &name, float x, float y, float z, float w) const
 {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+    glUniform4f(glGetUniformLocation(program.get(), name.c_str()), x, y, z, w);
 }
 
 void Shader::setMat2(const std::string &name, const Matrix &matrix) const
 {
     if (matrix.getRows() != 2 || matrix.getColumns() != 2)
         throw(Exception("SET_MAT2", "INVALID_SIZE", matrix));
-    glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, matrix.getData());
+    glUniformMatrix2fv(glGetUniformLocation(program.get(), name.c_str()), 1, GL_FALSE, matrix.getData());
 }
 
 void Shader::setMat3(const std::string &name, const Matrix &matrix) const
 {
     if (matrix.getRows() != 3 || matrix.getColumns() != 3)
         throw(Exception("SET_MAT3", "INVALID_SIZE", matrix));
-    glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, matrix.getData());
+    glUniformMatrix3fv(glGetUniformLocation(program.get(), name.c_str()), 1, GL_FALSE, matrix.getData());
 }
 
 void Shader::setMat4(const std::string &name, const Matrix &matrix) const
 {
     if (matrix.getRows() != 4 || matrix.getColumns() != 4)
         throw(Exception("SET_MAT4", "INVALID_SIZE", matrix));
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, matrix.getData());
+    glUniformMatrix4fv(glGetUniformLocation(program.get(), name.c_str()), 1, GL_FALSE, matrix.getData());
+}
+
+/*
+    the uniform block reads the buffer bound to this binding point,
+    a block unused by the shader is removed by the compiler and ignored here
+*/
+void Shader::setUniformBlock(const std::string &name, unsigned int binding) const
+{
+    const unsigned int blockIndex = glGetUniformBlockIndex(program.get(), name.c_str());
+
+    if (blockIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(program.get(), blockIndex, binding);
 }
 
 unsigned int Shader::getID() const
 {
-    return (ID);
+    return (program.get());
 }
 
 Shader::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
@@ -3,16 +3,21 @@
 #include <string>
 
 #include "../../../libs/glad/glad.h"
+#include "../GLHandle/GLHandle.hpp"
 #include "../Matrix/Matrix.hpp"
 
+// a shader owns its program, it can be moved but not copied
 class Shader
 {
   private:
-    unsigned int ID;
+    ProgramHandle program;
 
-    Shader();
+    Shader() = delete;
+    Shader(const Shader &copy) = delete;
+    Shader &operator=(const Shader &copy) = delete;
 
     const std::string readShaderFile(const std::string &shaderPath);
+    static std::string insertAfterVersion(const std::string &code, const std::string &text, const std::string &path);
     unsigned int compileShader(const char *shaderCode, const GLenum &shaderType);
     void compileProgram(unsigned int vertex, unsigned int fragment);
 
@@ -28,10 +33,10 @@ class Shader
     };
 
   public:
-    Shader(const std::string &vertexPath, const std::string &fragmentPath);
-    Shader(const Shader &copy);
-    Shader &operator=(const Shader &copy);
-    ~Shader();
+    Shader(const std::string &vertexPath, const std::string &fragmentPath, const std::string &vertexInputs = "",
+           const std::string &defines = "");
+    Shader(Shader &&move) = default;
+    Shader &operator=(Shader &&move) = default;
 
     void use() const;
 
@@ -46,6 +51,7 @@ class Shader
     void setMat2(const std::string &name, const Matrix &matrix) const;
     void setMat3(const std::string &name, const Matrix &matrix) const;
     void setMat4(const std::string &name, const Matrix &matrix) const;
+    void setUniformBlock(const std::string &name, unsigned int binding) const;
 
     unsigned int getID() const;
 };
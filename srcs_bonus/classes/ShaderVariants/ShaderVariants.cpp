@@ -0,0 +1,89 @@
+#include "ShaderVariants.hpp"
+
+/*
+    the location of the material index is looked up once, it is set for every material change of every frame
+*/
+ShaderVariants::ShaderVariants(const std::string &vertexPath, const std::string &fragmentPath,
+                               const std::string &vertexInputs)
+{
+    materialLocations.fill(-1);
+    for (unsigned int i = 0; i < NB_SHADER_VARIANTS; i++)
+    {
+        if (!isValid(i))
+            continue;
+        variants[i].emplace(vertexPath, fragmentPath, vertexInputs, getDefines(i));
+        materialLocations[i] = glGetUniformLocation(variants[i]->getID(), MATERIAL_INDEX_UNIFORM);
+    }
+}
+
+bool ShaderVariants::isValid(unsigned int features)
+{
+    return (features < NB_SHADER_VARIANTS && (features & (COLOR_FEATURE | TEXTURE_FEATURE)) != 0);
+}
+
+std::string ShaderVariants::getDefines(unsigned int features)
+{
+    std::string defines;
+
+    if (features & COLOR_FEATURE)
+        defines += "#define USE_COLOR\n";
+    if (features & TEXTURE_FEATURE)
+        defines += "#define USE_TEXTURE\n";
+    if (features & LIGHTING_FEATURE)
+        defines += "#define USE_LIGHTING\n";
+    return (defines);
+}
+
+/*
+    the texture is only sampled when the blend shows it, the color only when the texture doesn't hide it.
+    the lines of the wireframe are only colored, without texture nor light
+*/
+unsigned int ShaderVariants::selectFeatures(float mixValue, bool lighting, bool wireframe)
+{
+    unsigned int features = 0;
+
+    if (wireframe)
+        return (COLOR_FEATURE);
+    if (mixValue < 1)
+        features |= COLOR_FEATURE;
+    if (mixValue > 0)
+        features |= TEXTURE_FEATURE;
+    if (lighting)
+        features |= LIGHTING_FEATURE;
+    return (features);
+}
+
+const Shader &ShaderVariants::get(unsigned int features) const
+{
+    if (!isValid(features))
+        throw(Exception("GET", "INVALID_VARIANT", features));
+    return (*variants[features]);
+}
+
+int ShaderVariants::getMaterialLocation(unsigned int features) const
+{
+    if (!isValid(features))
+        throw(Exception("GET_MATERIAL_LOCATION", "INVALID_VARIANT", features));
+    return (materialLocations[features]);
+}
+
+void ShaderVariants::setUniformBlock(const std::string &name, unsigned int binding) const
+{
+    for (unsigned int i = 0; i < NB_SHADER_VARIANTS; i++)
+    {
+        if (variants[i])
+            variants[i]->setUniformBlock(name, binding);
+    }
+}
+
+ShaderVariants::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                     unsigned int features)
+{
+    this->errorMessage = "SHADER_VARIANTS::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| features: " + std::to_string(features) + "\n|";
+}
+
+const char *ShaderVariants::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
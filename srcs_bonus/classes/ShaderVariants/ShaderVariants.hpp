@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../Shader/Shader.hpp"
+#include <array>
+#include <optional>
+#include <string>
+
+#define MATERIAL_INDEX_UNIFORM "materialIndex" // selects the material of a draw command, looked up once per variant
+
+// what a variant of the shader computes, each feature is a #define of the shader files
+typedef enum shaderFeature
+{
+    COLOR_FEATURE = 1 << 0,    // USE_COLOR: the color of the vertices
+    TEXTURE_FEATURE = 1 << 1,  // USE_TEXTURE: the texture of the material, blended with the color if both are used
+    LIGHTING_FEATURE = 1 << 2, // USE_LIGHTING: the diffuse and specular light of the material
+    NB_SHADER_VARIANTS = 1 << 3
+} e_shaderFeature;
+
+/**
+ * every useful variant of a shader, compiled once from the same files with different #define.
+ * a variant only contains the features it uses, so the state of the display
+ * selects the cheapest program instead of a single program branching on uniforms.
+ * a variant without color nor texture has nothing to draw and isn't compiled
+ */
+class ShaderVariants
+{
+  private:
+    ShaderVariants() = delete;
+    ShaderVariants(const ShaderVariants &copy) = delete;
+    ShaderVariants &operator=(const ShaderVariants &copy) = delete;
+
+    std::array<std::optional<Shader>, NB_SHADER_VARIANTS> variants;
+    std::array<int, NB_SHADER_VARIANTS> materialLocations;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, unsigned int features);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    ShaderVariants(const std::string &vertexPath, const std::string &fragmentPath, const std::string &vertexInputs);
+    ShaderVariants(ShaderVariants &&move) = default;
+    ShaderVariants &operator=(ShaderVariants &&move) = default;
+
+    static bool isValid(unsigned int features);
+    static std::string getDefines(unsigned int features);
+    static unsigned int selectFeatures(float mixValue, bool lighting, bool wireframe);
+
+    const Shader &get(unsigned int features) const;
+    int getMaterialLocation(unsigned int features) const;
+    void setUniformBlock(const std::string &name, unsigned int binding) const;
+};
\ No newline at end of file
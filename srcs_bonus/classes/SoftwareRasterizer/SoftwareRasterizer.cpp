@@ -0,0 +1,592 @@
+#include "SoftwareRasterizer.hpp"
+#include "../JobSystem/JobSystem.hpp"
+#include "../MaterialClasses/MaterialBuffer/MaterialBuffer.hpp"
+#include "../MaterialClasses/MaterialRegistry/MaterialRegistry.hpp"
+#include "../TextureArray/TextureArray.hpp"
+#include "../Utils/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RASTER_LANES 4 // pixels of a row tested at once
+#else
+#define RASTER_LANES 1
+#endif
+
+static_assert(sizeof(s_rasterVertex) == 15 * sizeof(float), "a vertex is interpolated as an array of floats");
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+        throw(Exception("SOFTWARE_RASTERIZER", "INVALID_SIZE", std::to_string(width) + " * " + std::to_string(height)));
+    this->width = width;
+    this->height = height;
+    depthStride = (width + RASTER_LANES - 1) / RASTER_LANES * RASTER_LANES;
+    nbTilesX = (width + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+    nbTilesY = (height + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+    color.assign(static_cast<size_t>(width) * height * 4, 0);
+    depth.assign(static_cast<size_t>(depthStride) * height, 1);
+    nbTriangles = 0;
+    mixValue = 0;
+    lighting = false;
+}
+
+/*
+    the geometry is copied once, as initVAO uploads it. the objects must be prepared before.
+    every texture keeps its own size, the faces without material use the default texture
+*/
+void SoftwareRasterizer::setScene(const std::vector<Object> &objects, const std::string &defaultTexture)
+{
+    std::map<std::string, int> loadedTextures;
+    std::map<unsigned int, int> materialIndices;
+
+    meshes.clear();
+    materials.clear();
+    textures.clear();
+    loadTexture(defaultTexture, loadedTextures);
+    materialIndices[NO_MATERIAL] = 0;
+    materials.push_back({{0, 0, 0}, Material().getSpecularExponent(), 0});
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        s_mesh mesh;
+        objects[i].getGeometry(mesh.vertices, mesh.indices);
+        mesh.instances = objects[i].getInstances();
+        mesh.subMeshes = objects[i].getSubMeshes();
+        mesh.firstVertex = 0;
+        for (size_t j = 0; j < mesh.subMeshes.size(); j++)
+        {
+            const unsigned int materialID = mesh.subMeshes[j].materialID;
+            if (materialIndices.count(materialID) == 0)
+            {
+                const Material material = MaterialRegistry::getMaterial(materialID);
+                const std::string textureMap = MaterialBuffer::getTextureMap(material);
+                const std::array<float, 3> specular = material.getColor(SPECULAR_COLOR);
+                materialIndices[materialID] = materials.size();
+                materials.push_back({{specular[0], specular[1], specular[2]},
+                                     material.getSpecularExponent(),
+                                     textureMap.empty() ? 0 : loadTexture(textureMap, loadedTextures)});
+            }
+            mesh.subMeshes[j].materialID = materialIndices[materialID];
+        }
+        meshes.push_back(std::move(mesh));
+    }
+}
+
+/*
+    the first level of a texture container, as the GPU samples it
+*/
+int SoftwareRasterizer::loadTexture(const std::string &path, std::map<std::string, int> &loaded)
+{
+    auto it = loaded.find(path);
+    const std::string texturePath = TextureContainer::getContainerPath(path);
+
+    if (it != loaded.end())
+        return (it->second);
+    if (Utils::checkExtension(texturePath, ".stx"))
+    {
+        const TextureContainer container(texturePath);
+        textures.push_back({container.getWidth(), container.getHeight(), container.getPixels(0)});
+    }
+    else
+    {
+        const Image image(texturePath);
+        textures.push_back({image.getWidth(), image.getHeight(),
+                            TextureArray::resizeImage(image, image.getWidth(), image.getHeight())});
+    }
+    loaded[path] = textures.size() - 1;
+    return (textures.size() - 1);
+}
+
+/*
+    mixValue and lighting are the uniforms of shader.fs
+*/
+void SoftwareRasterizer::render(const Camera &camera, const Matrix &rotation, float mixValue, bool lighting)
+{
+    this->mixValue = mixValue;
+    this->lighting = lighting;
+    transformVertices(camera, rotation);
+    setupTriangles();
+    JobSystem::getShared().parallelFor(static_cast<size_t>(nbTilesX) * nbTilesY, 1, [this](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            rasterizeTile(i);
+    });
+}
+
+/*
+    the vertex shader of every instance. the matrices are read as OpenGL reads them,
+    one column after the other, so the products are written in the reverse order
+*/
+void SoftwareRasterizer::transformVertices(const Camera &camera, const Matrix &rotation)
+{
+    const Matrix modelView = rotation * camera.getView();
+    const Matrix modelViewProjection = modelView * camera.getProjection();
+    const float *mv = modelView.getData();
+    const float *mvp = modelViewProjection.getData();
+    size_t nbVertices = 0;
+
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        meshes[i].firstVertex = nbVertices;
+        nbVertices += meshes[i].vertices.size() / VERTEX_SIZE * meshes[i].instances.size();
+    }
+    vertices.resize(nbVertices);
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        const s_mesh &mesh = meshes[i];
+        const size_t meshSize = mesh.vertices.size() / VERTEX_SIZE;
+        JobSystem::getShared().parallelFor(
+            meshSize * mesh.instances.size(), 1024, [this, &mesh, meshSize, mv, mvp](size_t first, size_t last) {
+                for (size_t j = first; j < last; j++)
+                {
+                    const s_instance &instance = mesh.instances[j / meshSize];
+                    const float *vertex = mesh.vertices.data() + (j % meshSize) * VERTEX_SIZE;
+                    const float *position = vertex + ObjectVertexLayout::getOffset(POSITION_LOCATION);
+                    const float *texture = vertex + ObjectVertexLayout::getOffset(TEXTURE_LOCATION);
+                    const float *vertexColor = vertex + ObjectVertexLayout::getOffset(COLOR_LOCATION);
+                    const float *normal = vertex + ObjectVertexLayout::getOffset(NORMAL_LOCATION);
+                    const float point[4] = {position[0] + instance.translation[0],
+                                            position[1] + instance.translation[1],
+                                            position[2] + instance.translation[2], position[3]};
+                    s_rasterVertex &result = vertices[mesh.firstVertex + j];
+
+                    for (size_t row = 0; row < 4; row++)
+                    {
+                        result.clip[row] = mvp[row] * point[0] + mvp[4 + row] * point[1] + mvp[8 + row] * point[2] +
+                                           mvp[12 + row] * point[3];
+                    }
+                    for (size_t row = 0; row < 3; row++)
+                    {
+                        result.viewPosition[row] = mv[row] * point[0] + mv[4 + row] * point[1] +
+                                                   mv[8 + row] * point[2] + mv[12 + row] * point[3];
+                        result.normal[row] = mv[row] * normal[0] + mv[4 + row] * normal[1] + mv[8 + row] * normal[2];
+                        result.color[row] = vertexColor[row] * instance.color[row];
+                    }
+                    result.texture[0] = texture[0];
+                    result.texture[1] = texture[1];
+                }
+            });
+    }
+}
+
+/*
+    the faces of every instance are cut in bins of a fixed size, set up in parallel.
+    a tile reads the bins in order, so the triangles are drawn in the order of the faces
+*/
+void SoftwareRasterizer::setupTriangles()
+{
+    size_t nbBins = 0;
+
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        const size_t nbFaces = meshes[i].indices.size() / 3;
+        for (size_t j = 0; j < meshes[i].instances.size(); j++)
+        {
+            for (size_t face = 0; face < nbFaces; face += RASTER_TRIANGLES_PER_JOB)
+            {
+                if (nbBins == bins.size())
+                    bins.emplace_back();
+                bins[nbBins].mesh = i;
+                bins[nbBins].instance = j;
+                bins[nbBins].firstFace = face;
+                bins[nbBins].lastFace = std::min(nbFaces, face + RASTER_TRIANGLES_PER_JOB);
+                nbBins++;
+            }
+        }
+    }
+    bins.resize(nbBins);
+    JobSystem::getShared().parallelFor(nbBins, 1, [this](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            setupBin(bins[i]);
+    });
+    nbTriangles = 0;
+    for (size_t i = 0; i < bins.size(); i++)
+        nbTriangles += bins[i].triangles.size();
+}
+
+void SoftwareRasterizer::setupBin(s_triangleBin &bin)
+{
+    const s_mesh &mesh = meshes[bin.mesh];
+    const s_rasterVertex *instanceVertices =
+        vertices.data() + mesh.firstVertex + bin.instance * (mesh.vertices.size() / VERTEX_SIZE);
+    size_t subMesh = 0;
+
+    bin.triangles.clear();
+    bin.clippedVertices.clear();
+    bin.tiles.resize(static_cast<size_t>(nbTilesX) * nbTilesY);
+    for (size_t i = 0; i < bin.tiles.size(); i++)
+        bin.tiles[i].clear();
+    for (size_t face = bin.firstFace; face < bin.lastFace; face++)
+    {
+        while (subMesh + 1 < mesh.subMeshes.size() &&
+               face >= mesh.subMeshes[subMesh].firstFace + mesh.subMeshes[subMesh].nbFaces)
+            subMesh++;
+        const int material = mesh.subMeshes.empty() ? 0 : mesh.subMeshes[subMesh].materialID;
+        const s_rasterVertex *triangle[3] = {instanceVertices + mesh.indices[face * 3],
+                                             instanceVertices + mesh.indices[face * 3 + 1],
+                                             instanceVertices + mesh.indices[face * 3 + 2]};
+        bool outside = false;
+        bool clipped = false;
+
+        // a triangle on the outer side of a plane of the frustum is never seen
+        for (size_t axis = 0; axis < 3 && !outside; axis++)
+        {
+            bool below = true;
+            bool above = true;
+            for (size_t i = 0; i < 3; i++)
+            {
+                below = below && triangle[i]->clip[axis] < -triangle[i]->clip[3];
+                above = above && triangle[i]->clip[axis] > triangle[i]->clip[3];
+            }
+            outside = below || above;
+        }
+        if (outside)
+            continue;
+        for (size_t i = 0; i < 3; i++)
+            clipped = clipped || triangle[i]->clip[2] < -triangle[i]->clip[3];
+        if (!clipped)
+        {
+            setupTriangle(bin, triangle, material);
+            continue;
+        }
+        s_rasterVertex polygon[4];
+        const size_t nbPolygonVertices = clipNearPlane(triangle, polygon);
+        if (nbPolygonVertices < 3)
+            continue;
+        const size_t first = bin.clippedVertices.size();
+        bin.clippedVertices.insert(bin.clippedVertices.end(), polygon, polygon + nbPolygonVertices);
+        for (size_t i = 1; i + 1 < nbPolygonVertices; i++)
+        {
+            const s_rasterVertex *fan[3] = {&bin.clippedVertices[first], &bin.clippedVertices[first + i],
+                                            &bin.clippedVertices[first + i + 1]};
+            setupTriangle(bin, fan, material);
+        }
+    }
+}
+
+/*
+    the part of the triangle in front of the near plane (z >= -w), a triangle or a quad
+*/
+size_t SoftwareRasterizer::clipNearPlane(const s_rasterVertex *const triangle[3], s_rasterVertex polygon[4])
+{
+    size_t nbVertices = 0;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        const s_rasterVertex &a = *triangle[i];
+        const s_rasterVertex &b = *triangle[(i + 1) % 3];
+        const float distanceA = a.clip[2] + a.clip[3];
+        const float distanceB = b.clip[2] + b.clip[3];
+
+        if (distanceA >= 0)
+            polygon[nbVertices++] = a;
+        if ((distanceA >= 0) == (distanceB >= 0))
+            continue;
+        const float t = distanceA / (distanceA - distanceB);
+        const float *valuesA = reinterpret_cast<const float *>(&a);
+        const float *valuesB = reinterpret_cast<const float *>(&b);
+        float *values = reinterpret_cast<float *>(&polygon[nbVertices++]);
+        for (size_t j = 0; j < sizeof(s_rasterVertex) / sizeof(float); j++)
+            values[j] = valuesA[j] + (valuesB[j] - valuesA[j]) * t;
+    }
+    return (nbVertices);
+}
+
+/*
+    the triangles are turned counterclockwise, the faces seen from behind are drawn too.
+    the triangle is added to every tile its bounding box covers
+*/
+void SoftwareRasterizer::setupTriangle(s_triangleBin &bin, const s_rasterVertex *const triangle[3], int material)
+{
+    s_rasterTriangle result;
+
+    result.material = material;
+    for (size_t i = 0; i < 3; i++)
+    {
+        result.vertices[i] = triangle[i];
+        result.invW[i] = 1 / triangle[i]->clip[3];
+        result.screen[i][0] = (triangle[i]->clip[0] * result.invW[i] * 0.5f + 0.5f) * width;
+        result.screen[i][1] = (triangle[i]->clip[1] * result.invW[i] * 0.5f + 0.5f) * height;
+        result.depth[i] = triangle[i]->clip[2] * result.invW[i] * 0.5f + 0.5f;
+    }
+    const float area = (result.screen[1][0] - result.screen[0][0]) * (result.screen[2][1] - result.screen[0][1]) -
+                       (result.screen[2][0] - result.screen[0][0]) * (result.screen[1][1] - result.screen[0][1]);
+    if (!(area != 0) || !std::isfinite(area))
+        return;
+    result.frontFacing = (area > 0);
+    if (!result.frontFacing)
+    {
+        std::swap(result.vertices[1], result.vertices[2]);
+        std::swap(result.invW[1], result.invW[2]);
+        std::swap(result.screen[1], result.screen[2]);
+        std::swap(result.depth[1], result.depth[2]);
+    }
+
+    const float minX = std::min({result.screen[0][0], result.screen[1][0], result.screen[2][0]});
+    const float maxX = std::max({result.screen[0][0], result.screen[1][0], result.screen[2][0]});
+    const float minY = std::min({result.screen[0][1], result.screen[1][1], result.screen[2][1]});
+    const float maxY = std::max({result.screen[0][1], result.screen[1][1], result.screen[2][1]});
+    if (maxX < 0 || maxY < 0 || minX >= width || minY >= height)
+        return;
+    const int firstTileX = std::max(0, static_cast<int>(minX)) / RASTER_TILE_SIZE;
+    const int lastTileX = std::min(width - 1, static_cast<int>(maxX)) / RASTER_TILE_SIZE;
+    const int firstTileY = std::max(0, static_cast<int>(minY)) / RASTER_TILE_SIZE;
+    const int lastTileY = std::min(height - 1, static_cast<int>(maxY)) / RASTER_TILE_SIZE;
+    for (int y = firstTileY; y <= lastTileY; y++)
+    {
+        for (int x = firstTileX; x <= lastTileX; x++)
+            bin.tiles[static_cast<size_t>(y) * nbTilesX + x].push_back(bin.triangles.size());
+    }
+    bin.triangles.push_back(result);
+}
+
+/*
+    the tile is cleared with the color of the window, then its triangles are drawn
+*/
+void SoftwareRasterizer::rasterizeTile(size_t tileIndex)
+{
+    const int minX = (tileIndex % nbTilesX) * RASTER_TILE_SIZE;
+    const int minY = (tileIndex / nbTilesX) * RASTER_TILE_SIZE;
+    const int maxX = std::min(width, minX + RASTER_TILE_SIZE) - 1;
+    const int maxY = std::min(height, minY + RASTER_TILE_SIZE) - 1;
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        std::fill(depth.begin() + static_cast<size_t>(y) * depthStride + minX,
+                  depth.begin() + static_cast<size_t>(y) * depthStride + maxX + 1, 1.0f);
+        for (int x = minX; x <= maxX; x++)
+        {
+            unsigned char *pixel = color.data() + (static_cast<size_t>(y) * width + x) * 4;
+            pixel[0] = 51;
+            pixel[1] = 77;
+            pixel[2] = 77;
+            pixel[3] = 255;
+        }
+    }
+    for (size_t i = 0; i < bins.size(); i++)
+    {
+        const std::vector<uint32_t> &tile = bins[i].tiles[tileIndex];
+        for (size_t j = 0; j < tile.size(); j++)
+            rasterizeTriangle(bins[i].triangles[tile[j]], minX, minY, maxX, maxY);
+    }
+}
+
+/*
+    edge i is the edge in front of vertex i, its function is positive inside the triangle
+    and divided by the area it's the barycentric coordinate of vertex i.
+    a pixel on an edge shared by two triangles belongs to only one of them:
+    the edge is inclusive for a single direction of the two triangles
+*/
+void SoftwareRasterizer::rasterizeTriangle(const s_rasterTriangle &triangle, int minX, int minY, int maxX, int maxY)
+{
+    const float(*screen)[2] = triangle.screen;
+    float stepX[3];
+    float stepY[3];
+    float origin[3]; // the value of the edge function at (0, 0)
+    bool inclusive[3];
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        const float *a = screen[(i + 1) % 3];
+        const float *b = screen[(i + 2) % 3];
+        stepX[i] = a[1] - b[1];
+        stepY[i] = b[0] - a[0];
+        origin[i] = -stepY[i] * a[1] - stepX[i] * a[0];
+        inclusive[i] = stepX[i] > 0 || (stepX[i] == 0 && stepY[i] > 0);
+    }
+    const float area = origin[0] + stepX[0] * screen[0][0] + stepY[0] * screen[0][1];
+    const float invArea = 1 / area;
+    const float depthStep[2] = {triangle.depth[1] - triangle.depth[0], triangle.depth[2] - triangle.depth[0]};
+
+    minX = std::max(minX, static_cast<int>(std::min({screen[0][0], screen[1][0], screen[2][0]})));
+    maxX = std::min(maxX, static_cast<int>(std::max({screen[0][0], screen[1][0], screen[2][0]})));
+    minY = std::max(minY, static_cast<int>(std::min({screen[0][1], screen[1][1], screen[2][1]})));
+    maxY = std::min(maxY, static_cast<int>(std::max({screen[0][1], screen[1][1], screen[2][1]})));
+    for (int y = minY; y <= maxY; y++)
+    {
+        const float centerY = y + 0.5f;
+        float *depthRow = depth.data() + static_cast<size_t>(y) * depthStride;
+        float row[3];
+
+        for (size_t i = 0; i < 3; i++)
+            row[i] = origin[i] + stepY[i] * centerY;
+        // the rows of the depth buffer are padded, the first lane is aligned so the last one stays in the row
+        for (int x = minX / RASTER_LANES * RASTER_LANES; x <= maxX; x += RASTER_LANES)
+        {
+            float edges[3][RASTER_LANES];
+            float depths[RASTER_LANES];
+            unsigned int covered = (1u << RASTER_LANES) - 1;
+#if defined(__SSE2__)
+            const __m128 centerX = _mm_add_ps(_mm_set1_ps(x + 0.5f), _mm_set_ps(3, 2, 1, 0));
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            __m128 edge[3];
+            for (size_t i = 0; i < 3; i++)
+            {
+                edge[i] = _mm_add_ps(_mm_set1_ps(row[i]), _mm_mul_ps(_mm_set1_ps(stepX[i]), centerX));
+                inside = _mm_and_ps(inside, inclusive[i] ? _mm_cmpge_ps(edge[i], _mm_setzero_ps())
+                                                         : _mm_cmpgt_ps(edge[i], _mm_setzero_ps()));
+                _mm_storeu_ps(edges[i], edge[i]);
+            }
+            covered &= _mm_movemask_ps(inside);
+            if (covered == 0)
+                continue;
+            const __m128 l1 = _mm_mul_ps(edge[1], _mm_set1_ps(invArea));
+            const __m128 l2 = _mm_mul_ps(edge[2], _mm_set1_ps(invArea));
+            const __m128 pixelDepth =
+                _mm_add_ps(_mm_set1_ps(triangle.depth[0]), _mm_add_ps(_mm_mul_ps(l1, _mm_set1_ps(depthStep[0])),
+                                                                      _mm_mul_ps(l2, _mm_set1_ps(depthStep[1]))));
+            covered &= _mm_movemask_ps(_mm_cmplt_ps(pixelDepth, _mm_loadu_ps(depthRow + x)));
+            _mm_storeu_ps(depths, pixelDepth);
+#else
+            for (size_t i = 0; i < 3; i++)
+            {
+                edges[i][0] = row[i] + stepX[i] * (x + 0.5f);
+                if (inclusive[i] ? edges[i][0] < 0 : edges[i][0] <= 0)
+                    covered = 0;
+            }
+            if (covered == 0)
+                continue;
+            depths[0] = triangle.depth[0] + edges[1][0] * invArea * depthStep[0] + edges[2][0] * invArea * depthStep[1];
+            if (!(depths[0] < depthRow[x]))
+                continue;
+#endif
+            for (int lane = 0; lane < RASTER_LANES; lane++)
+            {
+                if (!(covered & (1u << lane)) || x + lane < minX || x + lane > maxX)
+                    continue;
+                depthRow[x + lane] = depths[lane];
+                shadePixel(triangle, x + lane, y, edges[1][lane] * invArea, edges[2][lane] * invArea);
+            }
+        }
+    }
+}
+
+/*
+    shader.fs, with the attributes interpolated in perspective
+*/
+void SoftwareRasterizer::shadePixel(const s_rasterTriangle &triangle, int x, int y, float l1, float l2)
+{
+    const float perspective[3] = {(1 - l1 - l2) * triangle.invW[0], l1 * triangle.invW[1], l2 * triangle.invW[2]};
+    const float invSum = 1 / (perspective[0] + perspective[1] + perspective[2]);
+    const float weights[3] = {perspective[0] * invSum, perspective[1] * invSum, perspective[2] * invSum};
+    const s_rasterMaterial &material = materials[triangle.material];
+    float values[sizeof(s_rasterVertex) / sizeof(float)] = {0};
+    s_rasterVertex &vertex = *reinterpret_cast<s_rasterVertex *>(values);
+    float result[3];
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        const float *vertexValues = reinterpret_cast<const float *>(triangle.vertices[i]);
+        for (size_t j = 0; j < sizeof(s_rasterVertex) / sizeof(float); j++)
+            values[j] += vertexValues[j] * weights[i];
+    }
+    std::copy(vertex.color, vertex.color + 3, result);
+    if (mixValue > 0)
+    {
+        float texel[3];
+        sampleTexture(textures[material.texture], vertex.texture[0], vertex.texture[1], texel);
+        for (size_t i = 0; i < 3; i++)
+            result[i] += (texel[i] - result[i]) * mixValue;
+    }
+    if (lighting)
+    {
+        const float viewLength = std::sqrt(vertex.viewPosition[0] * vertex.viewPosition[0] +
+                                           vertex.viewPosition[1] * vertex.viewPosition[1] +
+                                           vertex.viewPosition[2] * vertex.viewPosition[2]);
+        const float normalLength = std::sqrt(vertex.normal[0] * vertex.normal[0] + vertex.normal[1] * vertex.normal[1] +
+                                             vertex.normal[2] * vertex.normal[2]);
+        float diffuse = 0;
+        for (size_t i = 0; i < 3 && viewLength > 0 && normalLength > 0; i++)
+            diffuse -= vertex.viewPosition[i] / viewLength * vertex.normal[i] / normalLength;
+        diffuse = std::max((triangle.frontFacing) ? diffuse : -diffuse, 0.0f);
+        const float specular = (diffuse > 0) ? std::pow(diffuse, std::max(material.specularExponent, 1.0f)) : 0;
+        for (size_t i = 0; i < 3; i++)
+            result[i] = result[i] * (RASTER_AMBIANT_LIGHT + diffuse) + material.specularColor[i] * specular;
+    }
+    unsigned char *pixel = color.data() + (static_cast<size_t>(y) * width + x) * 4;
+    for (size_t i = 0; i < 3; i++)
+        pixel[i] = static_cast<unsigned char>(std::clamp(result[i], 0.0f, 1.0f) * 255 + 0.5f);
+    pixel[3] = 255;
+}
+
+/*
+    a linear filter with a mirrored repeat, like the texture array of the window (without its mipmaps)
+*/
+void SoftwareRasterizer::sampleTexture(const s_rasterTexture &texture, float s, float t, float result[3]) const
+{
+    const float u = s * texture.width - 0.5f;
+    const float v = t * texture.height - 0.5f;
+    const float floorU = std::floor(u);
+    const float floorV = std::floor(v);
+    const float fractionU = u - floorU;
+    const float fractionV = v - floorV;
+    const int x[2] = {mirror(static_cast<int>(floorU), texture.width),
+                      mirror(static_cast<int>(floorU) + 1, texture.width)};
+    const int y[2] = {mirror(static_cast<int>(floorV), texture.height),
+                      mirror(static_cast<int>(floorV) + 1, texture.height)};
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        const float texels[4] = {
+            texture.pixels[(static_cast<size_t>(y[0]) * texture.width + x[0]) * 3 + i] / 255.0f,
+            texture.pixels[(static_cast<size_t>(y[0]) * texture.width + x[1]) * 3 + i] / 255.0f,
+            texture.pixels[(static_cast<size_t>(y[1]) * texture.width + x[0]) * 3 + i] / 255.0f,
+            texture.pixels[(static_cast<size_t>(y[1]) * texture.width + x[1]) * 3 + i] / 255.0f};
+        const float bottom = texels[0] + (texels[1] - texels[0]) * fractionU;
+        const float top = texels[2] + (texels[3] - texels[2]) * fractionU;
+        result[i] = bottom + (top - bottom) * fractionV;
+    }
+}
+
+/*
+    GL_MIRRORED_REPEAT for a texel index: 0 1 2 2 1 0 0 1 2...
+*/
+int SoftwareRasterizer::mirror(int coordinate, int size)
+{
+    const int period = size * 2;
+    const int position = ((coordinate % period) + period) % period;
+
+    return ((position < size) ? position : period - 1 - position);
+}
+
+int SoftwareRasterizer::getWidth() const
+{
+    return (width);
+}
+
+int SoftwareRasterizer::getHeight() const
+{
+    return (height);
+}
+
+// the triangles set up by the last frame, after the culling and the clipping
+size_t SoftwareRasterizer::getNbTriangles() const
+{
+    return (nbTriangles);
+}
+
+const unsigned char *SoftwareRasterizer::getPixel(int x, int y) const
+{
+    return (color.data() + (static_cast<size_t>(y) * width + x) * 4);
+}
+
+float SoftwareRasterizer::getDepth(int x, int y) const
+{
+    return (depth[static_cast<size_t>(y) * depthStride + x]);
+}
+
+s_capturedFrame SoftwareRasterizer::getFrame() const
+{
+    return (s_capturedFrame{width, height, color});
+}
+
+SoftwareRasterizer::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                         const std::string &context)
+{
+    this->errorMessage = "SOFTWARE_RASTERIZER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + context + "\n|";
+}
+
+const char *SoftwareRasterizer::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
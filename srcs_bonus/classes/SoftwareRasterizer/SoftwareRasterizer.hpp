@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../Camera/Camera.hpp"
+#include "../FrameEncoder/FrameEncoder.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../ObjectClasses/Object/Object.hpp"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#define RASTER_TILE_SIZE 64           // pixels, a tile is rasterized by a single thread
+#define RASTER_TRIANGLES_PER_JOB 4096 // triangles set up and binned by a job
+#define RASTER_AMBIANT_LIGHT 0.2f     // as in shader.fs
+
+// a vertex after the vertex shader, every member is interpolated over the triangle
+typedef struct rasterVertex
+{
+    float clip[4];
+    float texture[2];
+    float color[3];
+    float normal[3];       // in view space
+    float viewPosition[3]; // the position relative to the camera
+} s_rasterVertex;
+
+// a triangle in the window, its vertices stay in the frame until the tiles are rasterized
+typedef struct rasterTriangle
+{
+    const s_rasterVertex *vertices[3];
+    float screen[3][2];
+    float depth[3]; // from 0 (near plane) to 1 (far plane)
+    float invW[3];
+    int material;
+    bool frontFacing;
+} s_rasterTriangle;
+
+// the part of a material read by shader.fs
+typedef struct rasterMaterial
+{
+    float specularColor[3];
+    float specularExponent;
+    int texture;
+} s_rasterMaterial;
+
+typedef struct rasterTexture
+{
+    int width;
+    int height;
+    std::vector<unsigned char> pixels; // RGB, the first row at t = 0
+} s_rasterTexture;
+
+/**
+ * renders a scene on the CPU, for the machines without OpenGL.
+ * the objects and the camera are the same as the window, the shading is the one of shader.fs:
+ * the color of the vertices mixed with the texture of the material, then the light from the camera.
+ * a frame goes through three parallel stages: the vertices of every instance are transformed,
+ * the triangles are clipped by the near plane, set up and binned in the tiles they cover,
+ * then each tile tests the edge functions of its triangles on several pixels at once against its depth buffer.
+ * the color buffer is RGBA with the bottom row first, like the pixels read from OpenGL
+ */
+class SoftwareRasterizer
+{
+  private:
+    SoftwareRasterizer() = delete;
+    SoftwareRasterizer(const SoftwareRasterizer &copy) = delete;
+    SoftwareRasterizer &operator=(const SoftwareRasterizer &copy) = delete;
+
+    typedef struct mesh
+    {
+        std::vector<float> vertices; // ObjectVertexLayout
+        std::vector<unsigned int> indices;
+        std::vector<s_instance> instances;
+        std::vector<s_subMesh> subMeshes; // the material ID is an index in the materials of the rasterizer
+        size_t firstVertex;               // of the first instance in the transformed vertices
+    } s_mesh;
+
+    // the faces of an instance set up by a job, and the triangles it gives to each tile in order
+    typedef struct triangleBin
+    {
+        size_t mesh;
+        size_t instance;
+        size_t firstFace;
+        size_t lastFace;
+        std::vector<s_rasterTriangle> triangles;
+        std::deque<s_rasterVertex> clippedVertices;
+        std::vector<std::vector<uint32_t>> tiles;
+    } s_triangleBin;
+
+    int width;
+    int height;
+    int depthStride; // the rows of the depth buffer are padded for the loads of several pixels
+    int nbTilesX;
+    int nbTilesY;
+    std::vector<unsigned char> color;
+    std::vector<float> depth;
+    std::vector<s_mesh> meshes;
+    std::vector<s_rasterMaterial> materials;
+    std::vector<s_rasterTexture> textures;
+    std::vector<s_rasterVertex> vertices;
+    std::vector<s_triangleBin> bins;
+    size_t nbTriangles;
+    float mixValue;
+    bool lighting;
+
+    int loadTexture(const std::string &path, std::map<std::string, int> &loaded);
+    void transformVertices(const Camera &camera, const Matrix &rotation);
+    void setupTriangles();
+    void setupBin(s_triangleBin &bin);
+    void setupTriangle(s_triangleBin &bin, const s_rasterVertex *const triangle[3], int material);
+    void rasterizeTile(size_t tileIndex);
+    void rasterizeTriangle(const s_rasterTriangle &triangle, int minX, int minY, int maxX, int maxY);
+    void shadePixel(const s_rasterTriangle &triangle, int x, int y, float l1, float l2);
+    void sampleTexture(const s_rasterTexture &texture, float s, float t, float result[3]) const;
+
+    static size_t clipNearPlane(const s_rasterVertex *const triangle[3], s_rasterVertex polygon[4]);
+    static int mirror(int coordinate, int size);
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &context);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    SoftwareRasterizer(int width, int height);
+
+    void setScene(const std::vector<Object> &objects, const std::string &defaultTexture);
+    void render(const Camera &camera, const Matrix &rotation, float mixValue, bool lighting);
+
+    int getWidth() const;
+    int getHeight() const;
+    size_t getNbTriangles() const;
+    const unsigned char *getPixel(int x, int y) const;
+    float getDepth(int x, int y) const;
+    s_capturedFrame getFrame() const;
+};
\ No newline at end of file
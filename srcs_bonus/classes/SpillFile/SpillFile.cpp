@@ -0,0 +1,87 @@
+#include "SpillFile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+SpillFile::SpillFile()
+{
+    const char *directory = std::getenv("TMPDIR");
+    std::string path = std::string((directory != NULL) ? directory : "/tmp") + "/scop_spill_XXXXXX";
+
+    data = nullptr;
+    size = 0;
+    capacity = 0;
+    fd = mkstemp(&path[0]);
+    if (fd == -1)
+        throw(Exception("SPILL_FILE", "CREATE_FAILED"));
+    unlink(path.c_str());
+}
+
+SpillFile::~SpillFile()
+{
+    if (data != nullptr)
+        munmap(data, capacity);
+    close(fd);
+}
+
+/*
+    the file is extended before it is mapped again,
+    the pages already written stay in the file
+*/
+void SpillFile::reserve(size_t capacity)
+{
+    if (capacity <= this->capacity)
+        return;
+    size_t newCapacity = std::max(this->capacity, static_cast<size_t>(SPILL_MIN_CAPACITY));
+    while (newCapacity < capacity)
+        newCapacity *= 2;
+
+    if (ftruncate(fd, newCapacity) == -1)
+        throw(Exception("RESERVE", "TRUNCATE_FAILED"));
+    void *address = mmap(NULL, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+        throw(Exception("RESERVE", "MMAP_FAILED"));
+    if (data != nullptr)
+        munmap(data, this->capacity);
+    data = static_cast<unsigned char *>(address);
+    this->capacity = newCapacity;
+}
+
+void SpillFile::append(const void *bytes, size_t count)
+{
+    reserve(size + count);
+    std::memcpy(data + size, bytes, count);
+    size += count;
+}
+
+/*
+    the capacity is kept, the next data is written over the previous one
+*/
+void SpillFile::clear()
+{
+    size = 0;
+}
+
+const unsigned char *SpillFile::getData() const
+{
+    return (data);
+}
+
+size_t SpillFile::getSize() const
+{
+    return (size);
+}
+
+SpillFile::Exception::Exception(const std::string &functionName, const std::string &errorMessage)
+{
+    this->errorMessage = "SPILL_FILE::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + std::string(std::strerror(errno)) + "\n|";
+}
+
+const char *SpillFile::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#define SPILL_MIN_CAPACITY 1048576 // the file grows by doubling from 1 MiB
+
+/**
+ * temporary file mapped in memory that grows while it is written.
+ * the file is removed as soon as it is created, it disappears with its descriptor.
+ * the pages are backed by the file instead of the swap,
+ * so the kernel can write them back and free them when the memory is needed.
+ * the data can move when the file grows, it has to be read again with getData after an append
+ */
+class SpillFile
+{
+  private:
+    SpillFile(const SpillFile &copy) = delete;
+    SpillFile &operator=(const SpillFile &copy) = delete;
+
+    void reserve(size_t capacity);
+
+    int fd;
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    SpillFile();
+    ~SpillFile();
+
+    void append(const void *bytes, size_t count);
+    void clear();
+
+    const unsigned char *getData() const;
+    size_t getSize() const;
+};
\ No newline at end of file
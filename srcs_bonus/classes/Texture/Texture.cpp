@@ -1,103 +1,109 @@
 #include "Texture.hpp"
 #include "../../../libs/glad/glad.h"
+#include "../LoadStats/LoadStats.hpp"
 #include "../Utils/Utils.hpp"
+#include <cstring>
 
 bool Texture::textureInit = false;
 
+/*
+    a texture container (.stx) already has all its mipmap levels,
+    an image needs them to be generated by the driver.
+    the container of an image is preferred when it exists
+*/
 Texture::Texture(const std::string &texturePath)
 {
+    const std::string path = TextureContainer::getContainerPath(texturePath);
+
     if (!textureInit)
         initTexParameter();
 
-    ID = 0;
-    loadImage(texturePath);
-
-    glGenTextures(1, &ID);
-    glBindTexture(GL_TEXTURE_2D, ID);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, &data[0]);
-    glGenerateMipmap(GL_TEXTURE_2D);
-}
+    texture = TextureHandle::create();
+    glBindTexture(GL_TEXTURE_2D, texture.get());
+    if (Utils::checkExtension(path, ".stx"))
+    {
+        uploadContainer(TextureContainer(path));
+        LoadStats::add(TEXTURE_CONTAINERS);
+    }
+    else
+    {
+        const Image image(path);
 
-Texture::Texture(const Texture &copy)
-{
-    *this = copy;
+        uploadImage(image);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
 }
 
-Texture &Texture::operator=(const Texture &copy)
+/*
+    the rows of a PNM image are tightly packed, so the unpack alignment is set to 1.
+    a gray image is stored in a single channel and duplicated in RGB by the swizzle,
+    it takes 3 times less memory than an RGB texture
+*/
+void Texture::uploadImage(const Image &image)
 {
-    if (&copy != this)
+    width = image.getWidth();
+    height = image.getHeight();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (image.getChannels() == 1)
     {
-        this->ID = copy.getID();
-    }
-    return (*this);
-}
+        const GLint swizzle[] = {GL_RED, GL_RED, GL_RED, GL_ONE};
 
-Texture::~Texture()
-{
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, image.getPixels());
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    else
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image.getPixels());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 }
 
-void Texture::checkHeader(const std::string &line, unsigned int nbLine)
+/*
+    the compressed levels are uploaded as they are stored in the file,
+    they are only decompressed on the CPU if the driver doesn't support BC1
+*/
+void Texture::uploadContainer(const TextureContainer &container)
 {
-    std::vector<std::string> words;
+    const std::vector<s_textureLevel> &levels = container.getLevels();
+    const bool compressed = (container.getFormat() == BC1_FORMAT && isCompressionSupported());
 
-    switch (nbLine)
+    width = container.getWidth();
+    height = container.getHeight();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (size_t i = 0; i < levels.size(); i++)
     {
-    case 0:
-        if (line != "P3")
-            throw(Exception("CHECK_HEADER", "INVALID_LINE", line, nbLine + 1));
-        break;
-    case 1: {
-        words = Utils::splitLine(line, " ");
-        if (words.size() != 2)
-            throw(Exception("CHECK_HEADER", "INVALID_LINE", line, nbLine + 1));
-
-        width = std::stoi(words[0]);
-        height = std::stoi(words[1]);
-        data = std::make_unique<unsigned char[]>(width * height * 3);
-        break;
-    }
-    case 2: {
-        words = Utils::splitLine(line, " ");
-        if (words.size() != 1)
-            throw(Exception("CHECK_HEADER", "INVALID_LINE", line, nbLine + 1));
-
-        valueMax = std::stoi(words[0]);
-        break;
-    }
-    default:
-        break;
+        if (compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, i, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, levels[i].width,
+                                   levels[i].height, 0, levels[i].size, levels[i].data);
+        else if (container.getFormat() == BC1_FORMAT)
+        {
+            const std::vector<unsigned char> pixels = TextureContainer::decompressBC1(levels[i]);
+            glTexImage2D(GL_TEXTURE_2D, i, GL_RGB, levels[i].width, levels[i].height, 0, GL_RGB, GL_UNSIGNED_BYTE,
+                         pixels.data());
+        }
+        else
+            glTexImage2D(GL_TEXTURE_2D, i, GL_RGB, levels[i].width, levels[i].height, 0, GL_RGB, GL_UNSIGNED_BYTE,
+                         levels[i].data);
     }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels.size() - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 }
 
-void Texture::loadImage(const std::string &texturePath)
+bool Texture::isCompressionSupported()
 {
-    std::stringstream textureStream;
-    std::string line;
-    std::vector<std::string> words;
-    unsigned int nbLine;
-    unsigned int pixel;
+    static int supported = -1;
+    GLint nbExtensions;
 
-    nbLine = 0;
-    pixel = 0;
-    textureStream = Utils::readFile(texturePath);
-    while (std::getline(textureStream, line))
+    if (supported == -1)
     {
-        line = line.substr(0, line.find("#"));
-        if (line.length() == 0)
-            continue;
-        else if (nbLine < 3)
-            checkHeader(line, nbLine);
-        else
+        supported = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &nbExtensions);
+        for (GLint i = 0; i < nbExtensions; i++)
         {
-            words = Utils::splitLine(line, " ");
-            for (size_t i = 0; i < words.size(); i++)
-            {
-                data[pixel] = std::stoi(words[i]);
-                pixel++;
-            }
+            const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension != NULL && std::strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0)
+                supported = 1;
         }
-        nbLine++;
     }
+    return (supported == 1);
 }
 
 void Texture::initTexParameter()
@@ -113,17 +119,15 @@ void Texture::initTexParameter()
 
 unsigned int Texture::getID() const
 {
-    return (ID);
+    return (texture.get());
 }
 
-Texture::Exception::Exception(const std::string &functionName, const std::string &errorMessage, const std::string &line,
-                              unsigned int lineIndex)
+int Texture::getWidth() const
 {
-    this->errorMessage = "TEXTURE::" + functionName + "::" + errorMessage;
-    this->errorMessage += "\n|\n| " + std::to_string(lineIndex) + ": " + line + "\n|";
+    return (width);
 }
 
-const char *Texture::Exception::what(void) const throw()
+int Texture::getHeight() const
 {
-    return (errorMessage.c_str());
-}
\ No newline at end of file
+    return (height);
+}
@@ -0,0 +1,247 @@
+#include "TextureArray.hpp"
+#include "../../../libs/glad/glad.h"
+#include "../LoadStats/LoadStats.hpp"
+#include "../Texture/Texture.hpp"
+#include "../Utils/Utils.hpp"
+#include <algorithm>
+
+/*
+    a path used by several materials is only loaded once,
+    the layer of an image is loaded from its container when it exists
+*/
+TextureArray::TextureArray(const std::vector<std::string> &paths)
+{
+    std::vector<std::string> layerPaths;
+    std::vector<TextureContainer> containers;
+
+    layerPaths.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (layers.find(paths[i]) != layers.end())
+            continue;
+        layers[paths[i]] = layerPaths.size();
+        layerPaths.push_back(TextureContainer::getContainerPath(paths[i]));
+    }
+    if (layerPaths.empty())
+        throw(Exception("TEXTURE_ARRAY", "NO_IMAGE", ""));
+    if (std::all_of(layerPaths.begin(), layerPaths.end(),
+                    [](const std::string &path) { return (Utils::checkExtension(path, ".stx")); }))
+    {
+        containers.reserve(layerPaths.size());
+        for (size_t i = 0; i < layerPaths.size(); i++)
+            containers.emplace_back(layerPaths[i]);
+    }
+    if (!containers.empty() && haveSameLevels(containers))
+    {
+        width = containers[0].getWidth();
+        height = containers[0].getHeight();
+        uploadContainers(containers);
+        LoadStats::add(TEXTURE_CONTAINERS, containers.size());
+    }
+    else
+        loadLayers(layerPaths);
+}
+
+/*
+    the layers can't share the stored levels of their containers,
+    their first level is resized like an image and the mipmaps are generated by the driver
+*/
+void TextureArray::loadLayers(const std::vector<std::string> &paths)
+{
+    std::vector<Image> images;
+    std::vector<std::vector<unsigned char>> decodedPixels;
+    std::vector<s_textureLayer> textureLayers;
+
+    width = 1;
+    height = 1;
+    images.reserve(paths.size());
+    decodedPixels.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (Utils::checkExtension(paths[i], ".stx"))
+        {
+            const TextureContainer container(paths[i]);
+            decodedPixels.push_back(container.getPixels(0));
+            textureLayers.push_back({container.getWidth(), container.getHeight(), 3, decodedPixels.back().data()});
+        }
+        else
+        {
+            images.emplace_back(paths[i]);
+            textureLayers.push_back(
+                {images.back().getWidth(), images.back().getHeight(), images.back().getChannels(),
+                 images.back().getPixels()});
+        }
+        width = std::max(width, textureLayers.back().width);
+        height = std::max(height, textureLayers.back().height);
+    }
+    uploadLayers(textureLayers);
+}
+
+void TextureArray::checkNbLayers(size_t nbLayers)
+{
+    GLint maxLayers;
+
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (nbLayers > static_cast<size_t>(maxLayers))
+        throw(Exception("CHECK_NB_LAYERS", "TOO_MANY_IMAGES", std::to_string(nbLayers)));
+}
+
+/*
+    glTexImage3D allocates every layer,
+    then each image is copied in its layer with glTexSubImage3D
+*/
+void TextureArray::uploadLayers(const std::vector<s_textureLayer> &images)
+{
+    checkNbLayers(images.size());
+    texture = TextureHandle::create();
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture.get());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGB8, width, height, images.size(), 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        if (images[i].width == width && images[i].height == height && images[i].channels == 3)
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, width, height, 1, GL_RGB, GL_UNSIGNED_BYTE,
+                            images[i].pixels);
+        else
+        {
+            const std::vector<unsigned char> pixels = resizeLayer(images[i], width, height);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, width, height, 1, GL_RGB, GL_UNSIGNED_BYTE,
+                            pixels.data());
+        }
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    setParameters();
+}
+
+/*
+    each level is allocated for every layer, then filled layer by layer.
+    as in Texture, the BC1 levels are only decompressed if the driver doesn't support them
+*/
+void TextureArray::uploadContainers(const std::vector<TextureContainer> &containers)
+{
+    const std::vector<s_textureLevel> &levels = containers[0].getLevels();
+    const bool compressed = (containers[0].getFormat() == BC1_FORMAT && Texture::isCompressionSupported());
+    const size_t nbLayers = containers.size();
+
+    checkNbLayers(nbLayers);
+    texture = TextureHandle::create();
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture.get());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        if (compressed)
+            glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, i, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, levels[i].width,
+                                   levels[i].height, nbLayers, 0, levels[i].size * nbLayers, NULL);
+        else
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, i, GL_RGB8, levels[i].width, levels[i].height, nbLayers, 0, GL_RGB,
+                         GL_UNSIGNED_BYTE, NULL);
+        for (size_t j = 0; j < nbLayers; j++)
+        {
+            const s_textureLevel &level = containers[j].getLevels()[i];
+            if (compressed)
+                glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, j, level.width, level.height, 1,
+                                          GL_COMPRESSED_RGB_S3TC_DXT1_EXT, level.size, level.data);
+            else
+            {
+                const std::vector<unsigned char> pixels = containers[j].getPixels(i);
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, j, level.width, level.height, 1, GL_RGB,
+                                GL_UNSIGNED_BYTE, pixels.data());
+            }
+        }
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels.size() - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    setParameters();
+}
+
+void TextureArray::setParameters() const
+{
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+/*
+    the layers of a single texture have the same size, format and number of levels
+*/
+bool TextureArray::haveSameLevels(const std::vector<TextureContainer> &containers)
+{
+    for (size_t i = 1; i < containers.size(); i++)
+    {
+        if (containers[i].getFormat() != containers[0].getFormat() ||
+            containers[i].getWidth() != containers[0].getWidth() ||
+            containers[i].getHeight() != containers[0].getHeight() ||
+            containers[i].getLevels().size() != containers[0].getLevels().size())
+            return (false);
+    }
+    return (true);
+}
+
+std::vector<unsigned char> TextureArray::resizeImage(const Image &image, int width, int height)
+{
+    return (resizeLayer({image.getWidth(), image.getHeight(), image.getChannels(), image.getPixels()}, width, height));
+}
+
+/*
+    nearest neighbour resize, a gray image is expanded to RGB
+*/
+std::vector<unsigned char> TextureArray::resizeLayer(const s_textureLayer &image, int width, int height)
+{
+    const unsigned int channels = image.channels;
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+
+    for (int y = 0; y < height; y++)
+    {
+        const size_t imageY = static_cast<size_t>(y) * image.height / height;
+        for (int x = 0; x < width; x++)
+        {
+            const size_t imageX = static_cast<size_t>(x) * image.width / width;
+            const unsigned char *pixel = image.pixels + (imageY * image.width + imageX) * channels;
+            for (size_t k = 0; k < 3; k++)
+                pixels[(static_cast<size_t>(y) * width + x) * 3 + k] = pixel[(channels == 1) ? 0 : k];
+        }
+    }
+    return (pixels);
+}
+
+unsigned int TextureArray::getID() const
+{
+    return (texture.get());
+}
+
+int TextureArray::getWidth() const
+{
+    return (width);
+}
+
+int TextureArray::getHeight() const
+{
+    return (height);
+}
+
+size_t TextureArray::getNbLayers() const
+{
+    return (layers.size());
+}
+
+int TextureArray::getLayer(const std::string &path) const
+{
+    auto it = layers.find(path);
+    if (it == layers.end())
+        throw(Exception("GET_LAYER", "UNKNOWN_IMAGE", path));
+    return (it->second);
+}
+
+TextureArray::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                   const std::string &path)
+{
+    this->errorMessage = "TEXTURE_ARRAY::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + path + "\n|";
+}
+
+const char *TextureArray::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
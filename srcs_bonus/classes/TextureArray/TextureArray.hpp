@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../GLHandle/GLHandle.hpp"
+#include "../Image/Image.hpp"
+#include "../TextureContainer/TextureContainer.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+#define DEFAULT_TEXTURE_PATH "srcs_bonus/textures/myLittlePony.ppm" // the texture of the faces without texture map
+
+// the pixels of an image or of the first level of a container, before their upload in a layer
+typedef struct textureLayer
+{
+    int width;
+    int height;
+    unsigned int channels;
+    const unsigned char *pixels;
+} s_textureLayer;
+
+/**
+ * every image of a scene stored in the layers of a single GL_TEXTURE_2D_ARRAY.
+ * the images are resized to the size of the biggest one,
+ * so an object only needs its layer index to sample its own image
+ * and the texture is bound once for the whole scene.
+ * when every layer is a texture container (.stx) of the same size and format,
+ * the stored mipmap levels are uploaded instead of being generated by the driver.
+ * the array owns its OpenGL name, it can be moved but not copied
+ */
+class TextureArray
+{
+  private:
+    TextureArray() = delete;
+    TextureArray(const TextureArray &copy) = delete;
+    TextureArray &operator=(const TextureArray &copy) = delete;
+    void loadLayers(const std::vector<std::string> &paths);
+    void uploadLayers(const std::vector<s_textureLayer> &images);
+    void uploadContainers(const std::vector<TextureContainer> &containers);
+    void setParameters() const;
+    static void checkNbLayers(size_t nbLayers);
+    static bool haveSameLevels(const std::vector<TextureContainer> &containers);
+
+    TextureHandle texture;
+    int width;
+    int height;
+    std::map<std::string, int> layers;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &path);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    TextureArray(const std::vector<std::string> &paths);
+    TextureArray(TextureArray &&move) = default;
+    TextureArray &operator=(TextureArray &&move) = default;
+
+    static std::vector<unsigned char> resizeImage(const Image &image, int width, int height);
+    static std::vector<unsigned char> resizeLayer(const s_textureLayer &layer, int width, int height);
+
+    unsigned int getID() const;
+    int getWidth() const;
+    int getHeight() const;
+    size_t getNbLayers() const;
+    int getLayer(const std::string &path) const;
+};
@@ -0,0 +1,394 @@
+#include "TextureContainer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+TextureContainer::TextureContainer(const std::string &path)
+{
+    this->path = path;
+    file = std::make_unique<MappedFile>(path);
+    readContainer(file->getData(), file->getSize());
+}
+
+/*
+    the levels are built from the image down to a 1 * 1 level,
+    each level is the average of 2 * 2 pixels of the previous one
+*/
+TextureContainer::TextureContainer(const Image &image, e_textureFormat format)
+{
+    int levelWidth = image.getWidth();
+    int levelHeight = image.getHeight();
+    unsigned int nbLevels = 1;
+    std::vector<unsigned char> pixels(static_cast<size_t>(levelWidth) * levelHeight * 3);
+
+    for (size_t i = 0; i < pixels.size(); i++)
+        pixels[i] = image.getPixels()[(image.getChannels() == 1) ? i / 3 : i];
+    while ((levelWidth >> nbLevels) > 0 || (levelHeight >> nbLevels) > 0)
+        nbLevels++;
+
+    this->format = format;
+    buffer.insert(buffer.end(), {'S', 'T', 'X', '1'});
+    writeUint(buffer, format);
+    writeUint(buffer, levelWidth);
+    writeUint(buffer, levelHeight);
+    writeUint(buffer, nbLevels);
+    for (unsigned int i = 0; i < nbLevels; i++)
+    {
+        writeLevel(levelWidth, levelHeight, pixels);
+        if (i + 1 == nbLevels)
+            break;
+        pixels = halveLevel(pixels, levelWidth, levelHeight);
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+    readContainer(buffer.data(), buffer.size());
+}
+
+TextureContainer::TextureContainer(const TextureContainer &copy)
+{
+    *this = copy;
+}
+
+TextureContainer &TextureContainer::operator=(const TextureContainer &copy)
+{
+    if (&copy != this)
+    {
+        path = "";
+        file.reset();
+        buffer.assign(copy.getData(), copy.getData() + copy.getDataSize());
+        readContainer(buffer.data(), buffer.size());
+    }
+    return (*this);
+}
+
+TextureContainer::~TextureContainer()
+{
+}
+
+void TextureContainer::readContainer(const unsigned char *begin, size_t size)
+{
+    const unsigned char *cursor = begin;
+    const unsigned char *end = begin + size;
+
+    data = begin;
+    dataSize = size;
+    if (size < 4 || std::memcmp(cursor, "STX1", 4) != 0)
+        throw(Exception("READ_CONTAINER", "INVALID_MAGIC_NUMBER", path));
+    cursor += 4;
+
+    uint32_t value = readUint(cursor, end);
+    if (value != RGB8_FORMAT && value != BC1_FORMAT)
+        throw(Exception("READ_CONTAINER", "INVALID_FORMAT", path));
+    format = static_cast<e_textureFormat>(value);
+    width = readUint(cursor, end);
+    height = readUint(cursor, end);
+    const uint32_t nbLevels = readUint(cursor, end);
+    if (width <= 0 || height <= 0 || nbLevels == 0 || nbLevels > 32)
+        throw(Exception("READ_CONTAINER", "INVALID_HEADER", path));
+
+    levels.clear();
+    for (uint32_t i = 0; i < nbLevels; i++)
+    {
+        s_textureLevel level;
+
+        level.width = readUint(cursor, end);
+        level.height = readUint(cursor, end);
+        level.size = readUint(cursor, end);
+        if (level.width != std::max(1, width >> i) || level.height != std::max(1, height >> i) ||
+            level.size != getLevelSize(format, level.width, level.height))
+            throw(Exception("READ_CONTAINER", "INVALID_LEVEL", path));
+        if (static_cast<size_t>(end - cursor) < level.size)
+            throw(Exception("READ_CONTAINER", "MISSING_DATA", path));
+        level.data = cursor;
+        levels.push_back(level);
+        cursor += std::min(static_cast<size_t>(end - cursor), (level.size + 3) / 4 * 4);
+    }
+}
+
+void TextureContainer::writeLevel(int width, int height, const std::vector<unsigned char> &pixels)
+{
+    const std::vector<unsigned char> levelData =
+        (format == BC1_FORMAT) ? compressBC1(pixels, width, height) : pixels;
+
+    writeUint(buffer, width);
+    writeUint(buffer, height);
+    writeUint(buffer, levelData.size());
+    buffer.insert(buffer.end(), levelData.begin(), levelData.end());
+    buffer.resize((buffer.size() + 3) / 4 * 4, 0);
+}
+
+void TextureContainer::save(const std::string &path) const
+{
+    std::ofstream output;
+
+    output.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    output.open(path, std::ios::binary);
+    output.write(reinterpret_cast<const char *>(data), dataSize);
+    output.close();
+}
+
+uint32_t TextureContainer::readUint(const unsigned char *&cursor, const unsigned char *end) const
+{
+    uint32_t value;
+
+    if (end - cursor < 4)
+        throw(Exception("READ_UINT", "MISSING_DATA", path));
+    value = cursor[0] | (cursor[1] << 8) | (cursor[2] << 16) | (static_cast<uint32_t>(cursor[3]) << 24);
+    cursor += 4;
+    return (value);
+}
+
+void TextureContainer::writeUint(std::vector<unsigned char> &buffer, uint32_t value)
+{
+    for (size_t i = 0; i < 4; i++)
+        buffer.push_back((value >> (i * 8)) & 0xFF);
+}
+
+std::vector<unsigned char> TextureContainer::halveLevel(const std::vector<unsigned char> &pixels, int width,
+                                                        int height)
+{
+    const int newWidth = std::max(1, width / 2);
+    const int newHeight = std::max(1, height / 2);
+    std::vector<unsigned char> newPixels(static_cast<size_t>(newWidth) * newHeight * 3);
+
+    for (int y = 0; y < newHeight; y++)
+    {
+        const size_t row0 = static_cast<size_t>(std::min(y * 2, height - 1)) * width;
+        const size_t row1 = static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * width;
+        for (int x = 0; x < newWidth; x++)
+        {
+            const size_t column0 = std::min(x * 2, width - 1);
+            const size_t column1 = std::min(x * 2 + 1, width - 1);
+            for (size_t k = 0; k < 3; k++)
+            {
+                unsigned int sum = pixels[(row0 + column0) * 3 + k] + pixels[(row0 + column1) * 3 + k] +
+                                   pixels[(row1 + column0) * 3 + k] + pixels[(row1 + column1) * 3 + k];
+                newPixels[(static_cast<size_t>(y) * newWidth + x) * 3 + k] = (sum + 2) / 4;
+            }
+        }
+    }
+    return (newPixels);
+}
+
+/*
+    the container converted from an image by scop_converter is used instead of the image:
+    texture.ppm is loaded from texture.stx when it exists next to it,
+    unless the image was modified after the conversion (the container is then stale)
+*/
+std::string TextureContainer::getContainerPath(const std::string &imagePath)
+{
+    std::filesystem::path containerPath(imagePath);
+    std::error_code error;
+
+    if (containerPath.extension() == ".stx")
+        return (imagePath);
+    containerPath.replace_extension(".stx");
+    if (!std::filesystem::is_regular_file(containerPath, error))
+        return (imagePath);
+    const std::filesystem::file_time_type imageTime = std::filesystem::last_write_time(imagePath, error);
+    if (!error && imageTime > std::filesystem::last_write_time(containerPath, error))
+        return (imagePath);
+    return (containerPath.string());
+}
+
+size_t TextureContainer::getLevelSize(e_textureFormat format, int width, int height)
+{
+    if (format == BC1_FORMAT)
+        return (static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 8);
+    return (static_cast<size_t>(width) * height * 3);
+}
+
+/*
+    BC1 stores each block of 4 * 4 pixels in 8 bytes:
+    2 colors in RGB565, then a 2 bits index per pixel in a palette of 4 colors
+    (the 2 colors and 2 interpolations between them)
+*/
+std::vector<unsigned char> TextureContainer::compressBC1(const std::vector<unsigned char> &pixels, int width,
+                                                         int height)
+{
+    const int nbBlocksX = (width + 3) / 4;
+    const int nbBlocksY = (height + 3) / 4;
+    std::vector<unsigned char> blocks(getLevelSize(BC1_FORMAT, width, height));
+    unsigned char block[16][3];
+
+    for (int blockY = 0; blockY < nbBlocksY; blockY++)
+    {
+        for (int blockX = 0; blockX < nbBlocksX; blockX++)
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                const size_t x = std::min(blockX * 4 + i % 4, width - 1);
+                const size_t y = std::min(blockY * 4 + i / 4, height - 1);
+                for (size_t k = 0; k < 3; k++)
+                    block[i][k] = pixels[(y * width + x) * 3 + k];
+            }
+            compressBC1Block(block, &blocks[(static_cast<size_t>(blockY) * nbBlocksX + blockX) * 8]);
+        }
+    }
+    return (blocks);
+}
+
+void TextureContainer::compressBC1Block(const unsigned char block[16][3], unsigned char *output)
+{
+    unsigned char minColor[3] = {255, 255, 255};
+    unsigned char maxColor[3] = {0, 0, 0};
+
+    for (size_t i = 0; i < 16; i++)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            minColor[k] = std::min(minColor[k], block[i][k]);
+            maxColor[k] = std::max(maxColor[k], block[i][k]);
+        }
+    }
+
+    uint16_t color0 = ((maxColor[0] >> 3) << 11) | ((maxColor[1] >> 2) << 5) | (maxColor[2] >> 3);
+    uint16_t color1 = ((minColor[0] >> 3) << 11) | ((minColor[1] >> 2) << 5) | (minColor[2] >> 3);
+    output[0] = color0 & 0xFF;
+    output[1] = color0 >> 8;
+    output[2] = color1 & 0xFF;
+    output[3] = color1 >> 8;
+
+    uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        unsigned char palette[4][3];
+        decodeBC1Colors(output, palette);
+        for (size_t i = 0; i < 16; i++)
+        {
+            unsigned int bestIndex = 0;
+            int bestDistance = -1;
+            for (unsigned int j = 0; j < 4; j++)
+            {
+                int distance = 0;
+                for (size_t k = 0; k < 3; k++)
+                    distance += (block[i][k] - palette[j][k]) * (block[i][k] - palette[j][k]);
+                if (bestDistance == -1 || distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestIndex = j;
+                }
+            }
+            indices |= bestIndex << (i * 2);
+        }
+    }
+    for (size_t i = 0; i < 4; i++)
+        output[4 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+/*
+    color0 > color1: 4 colors mode, the 2 last colors are at 1/3 and 2/3 between color0 and color1.
+    color0 <= color1: 3 colors mode, the third color is the middle and the last one is black
+*/
+void TextureContainer::decodeBC1Colors(const unsigned char *block, unsigned char colors[4][3])
+{
+    const uint16_t color0 = block[0] | (block[1] << 8);
+    const uint16_t color1 = block[2] | (block[3] << 8);
+    const uint16_t packedColors[2] = {color0, color1};
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        const unsigned int red = (packedColors[i] >> 11) & 0x1F;
+        const unsigned int green = (packedColors[i] >> 5) & 0x3F;
+        const unsigned int blue = packedColors[i] & 0x1F;
+        colors[i][0] = (red << 3) | (red >> 2);
+        colors[i][1] = (green << 2) | (green >> 4);
+        colors[i][2] = (blue << 3) | (blue >> 2);
+    }
+    for (size_t k = 0; k < 3; k++)
+    {
+        if (color0 > color1)
+        {
+            colors[2][k] = (2 * colors[0][k] + colors[1][k] + 1) / 3;
+            colors[3][k] = (colors[0][k] + 2 * colors[1][k] + 1) / 3;
+        }
+        else
+        {
+            colors[2][k] = (colors[0][k] + colors[1][k]) / 2;
+            colors[3][k] = 0;
+        }
+    }
+}
+
+std::vector<unsigned char> TextureContainer::decompressBC1(const s_textureLevel &level)
+{
+    const int nbBlocksX = (level.width + 3) / 4;
+    const int nbBlocksY = (level.height + 3) / 4;
+    std::vector<unsigned char> pixels(static_cast<size_t>(level.width) * level.height * 3);
+    unsigned char colors[4][3];
+
+    for (int blockY = 0; blockY < nbBlocksY; blockY++)
+    {
+        for (int blockX = 0; blockX < nbBlocksX; blockX++)
+        {
+            const unsigned char *block = level.data + (static_cast<size_t>(blockY) * nbBlocksX + blockX) * 8;
+            const uint32_t indices =
+                block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+
+            decodeBC1Colors(block, colors);
+            for (int i = 0; i < 16; i++)
+            {
+                const int x = blockX * 4 + i % 4;
+                const int y = blockY * 4 + i / 4;
+                if (x >= level.width || y >= level.height)
+                    continue;
+                for (size_t k = 0; k < 3; k++)
+                    pixels[(static_cast<size_t>(y) * level.width + x) * 3 + k] = colors[(indices >> (i * 2)) & 3][k];
+            }
+        }
+    }
+    return (pixels);
+}
+
+e_textureFormat TextureContainer::getFormat() const
+{
+    return (format);
+}
+
+int TextureContainer::getWidth() const
+{
+    return (width);
+}
+
+int TextureContainer::getHeight() const
+{
+    return (height);
+}
+
+const std::vector<s_textureLevel> &TextureContainer::getLevels() const
+{
+    return (levels);
+}
+
+const unsigned char *TextureContainer::getData() const
+{
+    return (data);
+}
+
+size_t TextureContainer::getDataSize() const
+{
+    return (dataSize);
+}
+
+/*
+    the RGB pixels of a level, a BC1 level is decompressed
+*/
+std::vector<unsigned char> TextureContainer::getPixels(size_t level) const
+{
+    if (format == BC1_FORMAT)
+        return (decompressBC1(levels[level]));
+    return (std::vector<unsigned char>(levels[level].data, levels[level].data + levels[level].size));
+}
+
+TextureContainer::Exception::Exception(const std::string &functionName, const std::string &errorMessage,
+                                       const std::string &path)
+{
+    this->errorMessage = "TEXTURE_CONTAINER::" + functionName + "::" + errorMessage;
+    this->errorMessage += "\n|\n| " + path + "\n|";
+}
+
+const char *TextureContainer::Exception::what(void) const throw()
+{
+    return (errorMessage.c_str());
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../Image/Image.hpp"
+#include "../MappedFile/MappedFile.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef enum textureFormat
+{
+    RGB8_FORMAT,
+    BC1_FORMAT
+} e_textureFormat;
+
+typedef struct textureLevel
+{
+    int width;
+    int height;
+    size_t size;
+    const unsigned char *data;
+} s_textureLevel;
+
+/**
+ * texture ready to be uploaded on the GPU (.stx file):
+ * every mipmap level is precomputed and can be compressed in BC1 (DXT1).
+ *
+ * layout (little endian):
+ * "STX1" | format | width | height | number of levels
+ * then for each level: width | height | size | data (padded to 4 bytes)
+ */
+class TextureContainer
+{
+  private:
+    TextureContainer() = delete;
+
+    void readContainer(const unsigned char *begin, size_t size);
+    void writeLevel(int width, int height, const std::vector<unsigned char> &pixels);
+
+    uint32_t readUint(const unsigned char *&cursor, const unsigned char *end) const;
+    static void writeUint(std::vector<unsigned char> &buffer, uint32_t value);
+    static std::vector<unsigned char> halveLevel(const std::vector<unsigned char> &pixels, int width, int height);
+    static std::vector<unsigned char> compressBC1(const std::vector<unsigned char> &pixels, int width, int height);
+    static void compressBC1Block(const unsigned char block[16][3], unsigned char *output);
+    static void decodeBC1Colors(const unsigned char *block, unsigned char colors[4][3]);
+
+    std::string path;
+    std::unique_ptr<MappedFile> file;
+    std::vector<unsigned char> buffer;
+    const unsigned char *data;
+    size_t dataSize;
+
+    e_textureFormat format;
+    int width;
+    int height;
+    std::vector<s_textureLevel> levels;
+
+    class Exception : public std::exception
+    {
+      public:
+        Exception(const std::string &functionName, const std::string &errorMessage, const std::string &path);
+        const char *what(void) const throw();
+
+      private:
+        std::string errorMessage;
+    };
+
+  public:
+    TextureContainer(const std::string &path);
+    TextureContainer(const Image &image, e_textureFormat format);
+    TextureContainer(const TextureContainer &copy);
+    TextureContainer &operator=(const TextureContainer &copy);
+    ~TextureContainer();
+
+    void save(const std::string &path) const;
+
+    e_textureFormat getFormat() const;
+    int getWidth() const;
+    int getHeight() const;
+    const std::vector<s_textureLevel> &getLevels() const;
+    const unsigned char *getData() const;
+    size_t getDataSize() const;
+    std::vector<unsigned char> getPixels(size_t level) const;
+
+    static std::string getContainerPath(const std::string &imagePath);
+    static size_t getLevelSize(e_textureFormat format, int width, int height);
+    static std::vector<unsigned char> decompressBC1(const s_textureLevel &level);
+};
@@ -1,22 +1,114 @@
 #include "Utils.hpp"
+#include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <fstream>
-std::vector<std::string> Utils::splitLine(std::string line, const std::string &delimiter)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SEPARATOR_BLOCK 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SEPARATOR_BLOCK 16
+#else
+#define SEPARATOR_BLOCK 32 // the size of the mask when the bytes are compared one by one
+#endif
+
+/*
+    bit i of the mask is set when data[i] is a whitespace or the separator.
+    a whole block is compared at once when the instruction set allows it, the end of a text byte per byte
+*/
+uint32_t Utils::separatorMask(const char *data, size_t size, char separator)
+{
+#if defined(__AVX2__) || defined(__SSE2__)
+    if (size >= SEPARATOR_BLOCK)
+    {
+#if defined(__AVX2__)
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+        // '\t' '\n' '\v' '\f' '\r' are the 5 characters from 9
+        const __m256i control = _mm256_sub_epi8(bytes, _mm256_set1_epi8(9));
+        const __m256i isControl = _mm256_cmpeq_epi8(_mm256_min_epu8(control, _mm256_set1_epi8(4)), control);
+        const __m256i isSpace = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+        const __m256i isSeparator = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(separator));
+        const __m256i separators = _mm256_or_si256(_mm256_or_si256(isControl, isSpace), isSeparator);
+        return (static_cast<uint32_t>(_mm256_movemask_epi8(separators)));
+#else
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        // '\t' '\n' '\v' '\f' '\r' are the 5 characters from 9
+        const __m128i control = _mm_sub_epi8(bytes, _mm_set1_epi8(9));
+        const __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8(4)), control);
+        const __m128i isSpace = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+        const __m128i isSeparator = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(separator));
+        const __m128i separators = _mm_or_si128(_mm_or_si128(isControl, isSpace), isSeparator);
+        return (static_cast<uint32_t>(_mm_movemask_epi8(separators)));
+#endif
+    }
+#endif
+    uint32_t mask = 0;
+    for (size_t i = 0; i < size && i < SEPARATOR_BLOCK; i++)
+    {
+        const unsigned char c = data[i];
+        if (c == ' ' || (c >= '\t' && c <= '\r') || c == static_cast<unsigned char>(separator))
+            mask |= 1u << i;
+    }
+    return (mask);
+}
+
+/*
+    the index of the first whitespace or separator from index, the size of the text if there is none
+*/
+size_t Utils::findSeparator(std::string_view text, size_t index, char separator)
+{
+    while (index < text.size())
+    {
+        const uint32_t mask = separatorMask(text.data() + index, text.size() - index, separator);
+        if (mask != 0)
+            return (index + __builtin_ctz(mask));
+        index += SEPARATOR_BLOCK;
+    }
+    return (text.size());
+}
+
+/*
+    the index of the first character from index that isn't a whitespace or the separator
+*/
+size_t Utils::skipSeparators(std::string_view text, size_t index, char separator)
+{
+    while (index < text.size())
+    {
+        const size_t size = std::min(text.size() - index, static_cast<size_t>(SEPARATOR_BLOCK));
+        const uint32_t valid = (size >= 32) ? UINT32_MAX : (1u << size) - 1;
+        const uint32_t mask = ~separatorMask(text.data() + index, size, separator) & valid;
+        if (mask != 0)
+            return (index + __builtin_ctz(mask));
+        index += size;
+    }
+    return (text.size());
+}
+
+/*
+    the words are views into the line, only the vector is allocated from the resource (the arena of the parser)
+*/
+std::pmr::vector<std::string_view> Utils::splitLine(std::string_view line, std::pmr::memory_resource *resource)
+{
+    return (splitLine(line, ' ', resource));
+}
+
+/*
+    the words are separated by whitespaces (spaces, tabs...) and by the separator ('/' between the indices of a face)
+*/
+std::pmr::vector<std::string_view> Utils::splitLine(std::string_view line, char separator,
+                                                    std::pmr::memory_resource *resource)
 {
-    size_t index;
-    std::string word;
-    std::vector<std::string> words;
+    std::pmr::vector<std::string_view> words(resource);
+    size_t index = skipSeparators(line, 0, separator);
 
-    index = 0;
-    while (index != std::string::npos)
+    while (index < line.size())
     {
-        index = line.find(delimiter);
-        word = line.substr(0, index);
-        if (word.length() > 0)
-            words.push_back(word);
-        line = line.substr(index + 1, std::string::npos);
+        const size_t end = findSeparator(line, index, separator);
+        words.push_back(line.substr(index, end - index));
+        index = skipSeparators(line, end, separator);
     }
-    return words;
+    return (words);
 }
 
 float Utils::DegToRad(float angle)
@@ -36,9 +128,9 @@ std::stringstream Utils::readFile(const std::string &path)
     return (stream);
 }
 
-bool Utils::checkExtension(const std::string &path, const std::string &extension)
+bool Utils::checkExtension(std::string_view path, std::string_view extension)
 {
-    std::string filename = path.substr(path.find_last_of("/") + 1, path.length());
+    std::string_view filename = path.substr(path.find_last_of("/") + 1, path.length());
     if (extension.size() >= filename.size())
         return (false);
     for (size_t i = 0; i < extension.size(); i++)
@@ -49,43 +141,29 @@ bool Utils::checkExtension(const std::string &path, const std::string &extension
     return (true);
 }
 
-bool Utils::isInt(const std::string &word)
+/*
+    the word is validated and converted in a single pass, without locale nor exception.
+    value is only meaningful when the whole word is a number
+*/
+bool Utils::parseInt(std::string_view word, long &value)
 {
-    const std::string numbers = "0123456789";
-    size_t start = 0;
-    if (word[0] == '-')
-        start++;
+    const char *last = word.data() + word.size();
+    const std::from_chars_result result = std::from_chars(word.data(), last, value);
 
-    for (size_t i = start; i < word.size(); i++)
-    {
-        if (numbers.find(word[i]) == std::string::npos)
-            return (false);
-    }
-    return (true);
+    return (result.ec == std::errc() && result.ptr == last);
 }
 
-bool Utils::isFloat(const std::string &word)
+/*
+    an optional '-', a digit, then the rest of a decimal number (fraction and exponent like 1e-5).
+    infinities, NaN and the values out of the range of a float are refused
+*/
+bool Utils::parseFloat(std::string_view word, float &value)
 {
-    const std::string numbers = "0123456789";
-    size_t start = 0;
-    bool pointFound = false;
-    if (word[0] == '-')
-        start++;
+    const char *last = word.data() + word.size();
+    const size_t start = (!word.empty() && word[0] == '-') ? 1 : 0;
 
-    for (size_t i = start; i < word.size(); i++)
-    {
-        if (word[i] == '.')
-        {
-            if (pointFound || i == 0 || (word[0] == '-' && i == 1))
-                return (false);
-            else
-            {
-                pointFound = true;
-                continue;
-            }
-        }
-        if (numbers.find(word[i]) == std::string::npos)
-            return (false);
-    }
-    return (true);
+    if (word.size() <= start || word[start] < '0' || word[start] > '9')
+        return (false);
+    const std::from_chars_result result = std::from_chars(word.data(), last, value);
+    return (result.ec == std::errc() && result.ptr == last);
 }
\ No newline at end of file
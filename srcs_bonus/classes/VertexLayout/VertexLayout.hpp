@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../../../libs/glad/glad.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * an attribute of a vertex: the location read by the vertex shader, its number of floats and its name in the shader.
+ * the name is a variable (inline constexpr char[]), a string literal can't be a template argument
+ */
+template <unsigned int Location, size_t Size, const char *Name> struct VertexAttribute
+{
+    static constexpr unsigned int location = Location;
+    static constexpr size_t size = Size;
+    static constexpr const char *name = Name;
+};
+
+/**
+ * the floats of a vertex in a buffer, the attributes one after the other in the order of the template.
+ * everything is known at compilation: the packing copies a constant number of floats per vertex,
+ * and the attribute pointers and the inputs of the vertex shader come from the same list,
+ * so the buffer and the shader can't disagree
+ */
+template <typename... Attributes> class VertexLayout
+{
+  private:
+    VertexLayout() = delete;
+
+  public:
+    static constexpr size_t nbAttributes = sizeof...(Attributes);
+    static constexpr size_t size = (Attributes::size + ...); // floats per vertex
+    static constexpr std::array<unsigned int, nbAttributes> locations = {Attributes::location...};
+    static constexpr std::array<size_t, nbAttributes> sizes = {Attributes::size...};
+    static constexpr std::array<const char *, nbAttributes> names = {Attributes::name...};
+
+    // floats before the attribute read at this location
+    static constexpr size_t getOffset(unsigned int location)
+    {
+        size_t offset = 0;
+
+        for (size_t i = 0; i < nbAttributes && locations[i] != location; i++)
+            offset += sizes[i];
+        return (offset);
+    }
+
+    // every vertex must have at least size floats
+    static std::unique_ptr<float[]> pack(const std::vector<std::vector<float>> &vertices)
+    {
+        std::unique_ptr<float[]> array = std::make_unique<float[]>(vertices.size() * size);
+
+        for (size_t i = 0; i < vertices.size(); i++)
+            std::copy(vertices[i].data(), vertices[i].data() + size, &array[i * size]);
+        return (array);
+    }
+
+    // the attributes of the bound buffer advance once per vertex, or once every divisor instances
+    static void setAttributes(unsigned int divisor = 0)
+    {
+        for (size_t i = 0; i < nbAttributes; i++)
+        {
+            glVertexAttribPointer(locations[i], sizes[i], GL_FLOAT, GL_FALSE, size * sizeof(float),
+                                  (void *)(getOffset(locations[i]) * sizeof(float)));
+            glEnableVertexAttribArray(locations[i]);
+            glVertexAttribDivisor(locations[i], divisor);
+        }
+    }
+
+    // the declarations of the inputs of the vertex shader
+    static std::string getShaderInputs()
+    {
+        std::string inputs;
+
+        for (size_t i = 0; i < nbAttributes; i++)
+        {
+            inputs += "layout (location = " + std::to_string(locations[i]) + ") in ";
+            inputs += ((sizes[i] == 1) ? "float" : "vec" + std::to_string(sizes[i])) + " " + names[i] + ";\n";
+        }
+        return (inputs);
+    }
+};
\ No newline at end of file
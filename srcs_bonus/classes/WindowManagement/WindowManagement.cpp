@@ -1,27 +1,40 @@
 #include "WindowManagement.hpp"
+#include "../JobSystem/JobSystem.hpp"
+#include "../Profiler/Profiler.hpp"
+#include "../MaterialClasses/MaterialRegistry/MaterialRegistry.hpp"
+#include "../ProgramCache/ProgramCache.hpp"
 #include "../Shader/Shader.hpp"
-#include "../Texture/Texture.hpp"
+#include "../ShaderVariants/ShaderVariants.hpp"
+#include "../TextureArray/TextureArray.hpp"
 #include "../Time/Time.hpp"
 #include "../Utils/Utils.hpp"
 #include <GLFW/glfw3.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <utility>
 
-WindowManagement::WindowManagement(const std::vector<Object> &objects)
+WindowManagement::WindowManagement(std::vector<Object> &&objects)
 {
-    start(objects);
+    start(std::move(objects));
     updateLoop();
 }
 
 WindowManagement::~WindowManagement()
 {
+    if (Profiler::isEnabled())
+        saveProfile();
+    Profiler::releaseQueries();
     glfwTerminate();
 }
 
-void WindowManagement::start(const std::vector<Object> &objects)
+void WindowManagement::start(std::vector<Object> &&objects)
 {
     initGLFW();
     initOpenGL();
-    initData(objects);
+    initData(std::move(objects));
 }
 
 void WindowManagement::initGLFW()
@@ -31,7 +44,7 @@ void WindowManagement::initGLFW()
 
     initWindow();
 
-    glfwSetWindowUserPointer(window, &camera);
+    glfwSetWindowUserPointer(window, static_cast<s_data *>(this));
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetCursorPosCallback(window, mouse_callback);
     glfwSetScrollCallback(window, scroll_callback);
@@ -54,18 +67,36 @@ void WindowManagement::initOpenGL()
 {
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
         throw(std::runtime_error("INIT_OPENGL::INITIALIZATION_FAILED"));
+    ProgramCache::loadFunctions((GLADloadproc)glfwGetProcAddress);
 
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     glEnable(GL_DEPTH_TEST);
 }
 
-void WindowManagement::initData(const std::vector<Object> &objects)
+void WindowManagement::initData(std::vector<Object> &&objects)
 {
-    this->objects = objects;
+    this->objects = std::move(objects);
+    // the objects are prepared in parallel, OpenGL is only called from this thread
+    JobSystem::getShared().parallelFor(this->objects.size(), 1, [this](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            this->objects[i].prepare();
+    });
     for (size_t i = 0; i < this->objects.size(); i++)
         this->objects[i].initVAO();
+    glfwGetFramebufferSize(window, &framebufferSize[0], &framebufferSize[1]);
     camera = Camera();
+    camera.setViewport(framebufferSize[0], framebufferSize[1]);
+    resolution = ResolutionScaler(DEFAULT_GPU_BUDGET, true);
+    framePacer = FramePacer(DEFAULT_FRAME_MODE, DEFAULT_FIXED_FPS, true);
+    glfwSwapInterval(framePacer.isVsync());
+    updateWindowTitle();
+    dirtyFlags = ALL_DIRTY;
     displayColor = true;
+    inputHeld = false;
+    lighting = true;
+    wireframe = false;
+    capturing = false;
+    picking = false;
     mixedValue = 0;
     for (size_t i = 0; i < 3; i++)
     {
@@ -86,24 +117,133 @@ void WindowManagement::initData(const std::vector<Object> &objects)
 
 void WindowManagement::updateLoop()
 {
-    const Texture texture("srcs_bonus/textures/myLittlePony.ppm");
-    const Shader shader("srcs_bonus/shaders/shader.vs", "srcs_bonus/shaders/shader.fs");
-
+    const TextureArray textures(getTexturePaths());
+    const MaterialBuffer materials(getMaterialIDs(), textures);
+    const std::string vertexInputs = ObjectVertexLayout::getShaderInputs() + InstanceLayout::getShaderInputs();
+    const ShaderVariants shaders("srcs_bonus/shaders/shader.vs", "srcs_bonus/shaders/shader.fs", vertexInputs);
+    RenderTarget target;
+    FrameCapture capture;
+    ObjectPicker picker("srcs_bonus/shaders/picking.vs", "srcs_bonus/shaders/picking.fs", vertexInputs);
+
+    const unsigned int features = ShaderVariants::selectFeatures(mixedValue, lighting, wireframe);
+
+    shaders.setUniformBlock("Materials", MATERIAL_BINDING);
+    initDrawCommands(shaders.get(features), shaders.getMaterialLocation(features), textures, materials);
     while (!glfwWindowShouldClose(window))
     {
+        waitEvents();
         Time::updateTime();
         processInput();
-        updateScene(texture, shader);
+        const bool rendered = dirtyFlags != 0 || !framePacer.isIdleMode();
+        if (rendered)
+            updateScene(textures, shaders, target, capture, picker);
+        framePacer.waitNextFrame(rendered);
+    }
+    stopCapture(capture);
+}
+
+std::vector<unsigned int> WindowManagement::getMaterialIDs() const
+{
+    std::vector<unsigned int> materialIDs;
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const std::vector<s_subMesh> subMeshes = objects[i].getSubMeshes();
+        for (size_t j = 0; j < subMeshes.size(); j++)
+            materialIDs.push_back(subMeshes[j].materialID);
+    }
+    return (materialIDs);
+}
+
+/*
+    the default texture is in the first layer,
+    it's used by the materials without texture map
+*/
+std::vector<std::string> WindowManagement::getTexturePaths() const
+{
+    const std::vector<unsigned int> materialIDs = getMaterialIDs();
+    std::vector<std::string> paths;
+
+    paths.push_back(DEFAULT_TEXTURE_PATH);
+    for (size_t i = 0; i < materialIDs.size(); i++)
+    {
+        if (materialIDs[i] == NO_MATERIAL)
+            continue;
+        const std::string textureMap = MaterialBuffer::getTextureMap(MaterialRegistry::getMaterial(materialIDs[i]));
+        if (!textureMap.empty())
+            paths.push_back(textureMap);
+    }
+    return (paths);
+}
+
+/*
+    one command per sub mesh, drawing every instance of its object.
+    sorted by shader, then texture, then material, then VAO
+*/
+void WindowManagement::initDrawCommands(const Shader &shader, int materialLocation, const TextureArray &textures,
+                                        const MaterialBuffer &materials)
+{
+    drawCommands.clear();
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const std::vector<s_subMesh> subMeshes = objects[i].getSubMeshes();
+        for (size_t j = 0; j < subMeshes.size(); j++)
+        {
+            drawCommands.push_back({shader.getID(), materialLocation, textures.getID(),
+                                    materials.getIndex(subMeshes[j].materialID), objects[i].getVAO(),
+                                    subMeshes[j].firstFace * 3, subMeshes[j].nbFaces * 3,
+                                    objects[i].getInstances().size()});
+        }
+    }
+    std::sort(drawCommands.begin(), drawCommands.end(), [](const s_drawCommand &a, const s_drawCommand &b) {
+        return (std::tie(a.shaderID, a.textureID, a.materialIndex, a.VAO, a.firstIndex) <
+                std::tie(b.shaderID, b.textureID, b.materialIndex, b.VAO, b.firstIndex));
+    });
+}
+
+/*
+    the variant of the shader depends on the display, every command uses the variant of the frame
+*/
+void WindowManagement::selectShader(const Shader &shader, int materialLocation)
+{
+    for (size_t i = 0; i < drawCommands.size(); i++)
+    {
+        drawCommands[i].shaderID = shader.getID();
+        drawCommands[i].materialLocation = materialLocation;
+    }
+}
+
+/*
+    while nothing changes and no key is held the thread sleeps until an event arrives,
+    the time spent waiting doesn't count in the next frame
+*/
+void WindowManagement::waitEvents()
+{
+    if (!framePacer.canWaitEvents(dirtyFlags != 0, inputHeld))
+    {
+        glfwPollEvents();
+        return;
     }
+    glfwWaitEventsTimeout(IDLE_TIMEOUT);
+    Time::resetTime();
 }
 
 void WindowManagement::processInput()
 {
+    const Profiler::Scope profile("processInput");
+
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
+    inputHeld = false;
     updateCameraPosition();
     updateSceneOrientation();
     updateDisplayMode();
+    updateFrameMode();
+    updateIdleMode();
+    updateProfilerMode();
+    updateResolutionMode();
+    updateCaptureMode();
+    updateMouseButton();
 }
 
 bool WindowManagement::isKeyPressed(int key)
@@ -123,6 +263,11 @@ void WindowManagement::updateCameraPosition()
 
     int up = isKeyPressed(GLFW_KEY_SPACE) - isKeyPressed(GLFW_KEY_LEFT_SHIFT);
     camera.addToPosition(up * camera.getUpDirection() * speed);
+    if (front != 0 || right != 0 || up != 0)
+    {
+        dirtyFlags |= CAMERA_DIRTY;
+        inputHeld = true;
+    }
 }
 
 void WindowManagement::updateSceneOrientation()
@@ -130,28 +275,36 @@ void WindowManagement::updateSceneOrientation()
     inputRotation[X_AXIS] = isKeyPressed(GLFW_KEY_U) - isKeyPressed(GLFW_KEY_Y);
     inputRotation[Y_AXIS] = isKeyPressed(GLFW_KEY_J) - isKeyPressed(GLFW_KEY_H);
     inputRotation[Z_AXIS] = isKeyPressed(GLFW_KEY_M) - isKeyPressed(GLFW_KEY_N);
+    if (inputRotation[X_AXIS] == 0 && inputRotation[Y_AXIS] == 0 && inputRotation[Z_AXIS] == 0)
+        return;
+    sceneRotation[X_AXIS] += inputRotation[X_AXIS] * Time::getDeltaTime();
+    sceneRotation[Y_AXIS] += inputRotation[Y_AXIS] * Time::getDeltaTime();
+    sceneRotation[Z_AXIS] += inputRotation[Z_AXIS] * Time::getDeltaTime();
+    dirtyFlags |= ROTATION_DIRTY;
+    inputHeld = true;
 }
 
 void WindowManagement::updateDisplayMode()
 {
     updateWireframeMode();
     updateTextureMode();
+    updateLightingMode();
 }
 
 void WindowManagement::updateWireframeMode()
 {
-    static bool wireFrameMode = false;
     static bool keyEnable = true;
 
     if (isKeyPressed(GLFW_KEY_F1))
     {
         if (keyEnable == true)
         {
-            wireFrameMode = !wireFrameMode;
-            if (wireFrameMode)
+            wireframe = !wireframe;
+            if (wireframe)
                 glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
             else
                 glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            dirtyFlags |= DISPLAY_DIRTY;
         }
         keyEnable = false;
     }
@@ -166,35 +319,297 @@ void WindowManagement::updateTextureMode()
     if (isKeyPressed(GLFW_KEY_F2))
     {
         if (keyEnable == true)
+        {
             displayColor = !displayColor;
+            dirtyFlags |= BLEND_DIRTY;
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+void WindowManagement::updateLightingMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F6))
+    {
+        if (keyEnable == true)
+        {
+            lighting = !lighting;
+            dirtyFlags |= DISPLAY_DIRTY;
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+void WindowManagement::updateFrameMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F3))
+    {
+        if (keyEnable == true)
+        {
+            framePacer.nextMode();
+            glfwSwapInterval(framePacer.isVsync());
+            updateWindowTitle();
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+void WindowManagement::updateIdleMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F4))
+    {
+        if (keyEnable == true)
+        {
+            framePacer.setIdleMode(!framePacer.isIdleMode());
+            updateWindowTitle();
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+/*
+    the profile is saved when the profiler is disabled
+*/
+void WindowManagement::updateProfilerMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F5))
+    {
+        if (keyEnable == true)
+        {
+            if (Profiler::isEnabled())
+                saveProfile();
+            else
+                Profiler::clear();
+            Profiler::setEnabled(!Profiler::isEnabled());
+            updateWindowTitle();
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+void WindowManagement::updateResolutionMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F7))
+    {
+        if (keyEnable == true)
+        {
+            resolution.setEnabled(!resolution.isEnabled());
+            updateWindowTitle();
+            dirtyFlags |= DISPLAY_DIRTY;
+        }
+        keyEnable = false;
+    }
+    else
+        keyEnable = true;
+}
+
+/*
+    the capture itself starts and stops with the next rendered frame
+*/
+void WindowManagement::updateCaptureMode()
+{
+    static bool keyEnable = true;
+
+    if (isKeyPressed(GLFW_KEY_F8))
+    {
+        if (keyEnable == true)
+        {
+            capturing = !capturing;
+            updateWindowTitle();
+            dirtyFlags |= CAPTURE_DIRTY;
+        }
         keyEnable = false;
     }
     else
         keyEnable = true;
 }
 
-void WindowManagement::updateScene(const Texture &texture, const Shader &shader)
+/*
+    the cursor is hidden by the camera, a click picks the center of the window
+*/
+void WindowManagement::updateMouseButton()
+{
+    static bool buttonEnable = true;
+
+    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
+    {
+        if (buttonEnable == true)
+        {
+            picking = true;
+            dirtyFlags |= PICKING_DIRTY;
+        }
+        buttonEnable = false;
+    }
+    else
+        buttonEnable = true;
+}
+
+/*
+    a profile that can't be saved doesn't stop the program
+*/
+void WindowManagement::saveProfile()
+{
+    try
+    {
+        Profiler::dumpChromeTrace(PROFILER_OUTPUT);
+        std::cout << "profile saved in " << PROFILER_OUTPUT << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void WindowManagement::updateWindowTitle()
+{
+    std::string title = "Scop - " + framePacer.getModeName();
+
+    if (framePacer.isIdleMode())
+        title += " - idle";
+    if (Profiler::isEnabled())
+        title += " - profiling";
+    if (!resolution.isEnabled())
+        title += " - native resolution";
+    if (capturing)
+        title += " - capturing";
+    glfwSetWindowTitle(window, title.c_str());
+}
+
+/*
+    the measures of the previous frames choose the resolution of this one.
+    while the image is below the native resolution the frames continue,
+    so a sharp image replaces it once the view stops
+*/
+void WindowManagement::updateScene(const TextureArray &textures, const ShaderVariants &shaders, RenderTarget &target,
+                                   FrameCapture &capture, ObjectPicker &picker)
 {
+    const unsigned int changes = dirtyFlags;
+    double frameTime;
+    float frameScale;
+
+    dirtyFlags = 0;
+    while (target.getFrameTime(frameTime, frameScale))
+        resolution.addFrameTime(frameTime, frameScale);
+    resolution.update(FramePacer::getTime(), (changes & (CAMERA_DIRTY | ROTATION_DIRTY)) != 0);
+    target.begin(resolution.getSize(framebufferSize[0], framebufferSize[1]), framebufferSize);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    updateCameraView();
     updateTexture();
+    const unsigned int features = ShaderVariants::selectFeatures(mixedValue, lighting, wireframe);
+    const Shader &shader = shaders.get(features);
+    selectShader(shader, shaders.getMaterialLocation(features));
+    updateShader(textures, shader);
+    renderDrawCommands(shader);
+    target.end();
+    updateCapture(capture);
+    updatePicking(picker);
+    swapBuffers();
+    Profiler::nextFrame();
+    if (!resolution.isNative())
+        dirtyFlags |= RESOLUTION_DIRTY;
+    if (capturing)
+        dirtyFlags |= CAPTURE_DIRTY;
+    if (picking || picker.isPending())
+        dirtyFlags |= PICKING_DIRTY;
+}
 
-    for (size_t i = 0; i < objects.size(); i++)
-        renderObject(objects[i], texture, shader);
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+/*
+    the image of the window is captured as shown, after the stretch of a lower resolution.
+    a capture keeps every frame rendered, so the idle mode doesn't stop it
+*/
+void WindowManagement::updateCapture(FrameCapture &capture)
+{
+    const Profiler::Scope profile("capture");
+
+    if (capturing && !capture.isCapturing())
+    {
+        const char *path = std::getenv(CAPTURE_ENV);
+        capture.start((path != NULL) ? path : DEFAULT_CAPTURE_PATH, CAPTURE_FPS);
+    }
+    else if (!capturing && capture.isCapturing())
+        stopCapture(capture);
+    capture.capture(framebufferSize[0], framebufferSize[1]);
 }
 
-void WindowManagement::updateCameraView()
+/*
+    a capture that can't be written doesn't stop the program
+*/
+void WindowManagement::stopCapture(FrameCapture &capture)
 {
-    Matrix direction(3, 1);
-    float directionValues[] = {cosf(Utils::DegToRad(camera.getYaw())) * cosf(Utils::DegToRad(camera.getPitch())),
-                               sinf(Utils::DegToRad(camera.getPitch())),
-                               sinf(Utils::DegToRad(camera.getYaw())) * cosf(Utils::DegToRad(camera.getPitch()))};
-    direction.setData(directionValues, 3);
-    camera.setFrontDirection(Matrix::normalize(direction));
-    camera.setRightDirection(
-        Matrix::normalize(Matrix::crossProduct(camera.getFrontDirection(), camera.getUpDirection())));
+    if (!capture.isCapturing())
+        return;
+    try
+    {
+        capture.stop();
+        std::cout << "capture saved: " << capture.getNbWritten() << " frames, " << capture.getNbDropped()
+                  << " dropped" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+/*
+    the result of the previous pick is read if the GPU is done with it,
+    a new pick waits until then. the frames continue while a pick is pending
+*/
+void WindowManagement::updatePicking(ObjectPicker &picker)
+{
+    const Profiler::Scope profile("picking");
+    s_pickResult result;
+
+    if (picker.getResult(result))
+        printPick(result);
+    if (!picking || picker.isPending())
+        return;
+    picker.pick(objects, getSceneRotation(), camera, framebufferSize, framebufferSize[0] / 2, framebufferSize[1] / 2);
+    picking = false;
+}
+
+void WindowManagement::printPick(const s_pickResult &result) const
+{
+    if (!result.hit || result.object >= objects.size())
+    {
+        std::cout << "picked: nothing" << std::endl;
+        return;
+    }
+    const Object &object = objects[result.object];
+    const std::vector<s_subMesh> subMeshes = object.getSubMeshes();
+    const unsigned int materialID = subMeshes[ObjectPicker::findSubMesh(subMeshes, result.face)].materialID;
+    const std::string objectName = object.getName().empty() ? "object " + std::to_string(result.object)
+                                                            : object.getName();
+    const std::string materialName =
+        (materialID == NO_MATERIAL) ? "none" : MaterialRegistry::getMaterial(materialID).getName();
+
+    std::cout << "picked: " << objectName << ", instance " << result.instance << ", face " << result.face
+              << ", material " << materialName << std::endl;
+}
+
+void WindowManagement::swapBuffers()
+{
+    const Profiler::Scope profile("glfwSwapBuffers");
+
+    glfwSwapBuffers(window);
 }
 
 void WindowManagement::updateTexture()
@@ -202,48 +617,89 @@ void WindowManagement::updateTexture()
     if (displayColor == true && mixedValue > 0)
     {
         mixedValue -= Time::getDeltaTime();
+        dirtyFlags |= BLEND_DIRTY;
         if (mixedValue < 0)
             mixedValue = 0;
     }
     else if (displayColor == false && mixedValue < 1)
     {
         mixedValue += Time::getDeltaTime();
+        dirtyFlags |= BLEND_DIRTY;
         if (mixedValue > 1)
             mixedValue = 1;
     }
 }
 
-void WindowManagement::renderObject(const Object &object, const Texture &texture, const Shader &shader)
+/*
+    the uniforms shared by every draw are set once per frame in updateShader,
+    a state is only changed when the next command needs another one
+*/
+void WindowManagement::renderDrawCommands(const Shader &shader)
 {
-    updateShader(texture, shader);
-    glBindVertexArray(object.getVAO());
-    glDrawElements(GL_TRIANGLES, object.getFaces().size() * 3, GL_UNSIGNED_INT, 0);
+    const Profiler::Scope profile("renderDrawCommands");
+    const Profiler::GPUScope gpuProfile("renderDrawCommands");
+    unsigned int currentShader = shader.getID();
+    unsigned int currentTexture = 0;
+    int currentMaterial = -1;
+    unsigned int currentVAO = 0;
+
+    for (size_t i = 0; i < drawCommands.size(); i++)
+    {
+        const s_drawCommand &command = drawCommands[i];
+
+        if (command.shaderID != currentShader)
+        {
+            glUseProgram(command.shaderID);
+            currentShader = command.shaderID;
+            currentMaterial = -1;
+        }
+        if (command.textureID != currentTexture)
+        {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, command.textureID);
+            currentTexture = command.textureID;
+        }
+        if (command.materialIndex != currentMaterial)
+        {
+            glUniform1i(command.materialLocation, command.materialIndex);
+            currentMaterial = command.materialIndex;
+        }
+        if (command.VAO != currentVAO)
+        {
+            glBindVertexArray(command.VAO);
+            currentVAO = command.VAO;
+        }
+        glDrawElementsInstanced(GL_TRIANGLES, command.nbIndices, GL_UNSIGNED_INT,
+                                reinterpret_cast<void *>(command.firstIndex * sizeof(unsigned int)),
+                                command.nbInstances);
+    }
 }
 
-void WindowManagement::updateShader(const Texture &texture, const Shader &shader)
+void WindowManagement::updateShader(const TextureArray &textures, const Shader &shader)
 {
+    const Profiler::Scope profile("updateShader");
+
     shader.use();
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture.getID());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textures.getID());
     shader.setInt("texture1", 0);
     shader.setFloat("aMixValue", mixedValue);
 
-    sceneRotation[X_AXIS] += inputRotation[X_AXIS] * Time::getDeltaTime();
-    sceneRotation[Y_AXIS] += inputRotation[Y_AXIS] * Time::getDeltaTime();
-    sceneRotation[Z_AXIS] += inputRotation[Z_AXIS] * Time::getDeltaTime();
+    shader.setMat4("rotation", getSceneRotation());
+
+    // only computed again when the camera moved or the window was resized
+    shader.setMat4("projection", camera.getProjection());
+    shader.setMat4("view", camera.getView());
+}
+
+Matrix WindowManagement::getSceneRotation() const
+{
     Matrix rotation(4, 4);
+
     rotation.uniform(1);
     rotation = Matrix::rotate(rotation, sceneRotation[X_AXIS], axis[X_AXIS]) *
                Matrix::rotate(rotation, sceneRotation[Y_AXIS], axis[Y_AXIS]) *
                Matrix::rotate(rotation, sceneRotation[Z_AXIS], axis[Z_AXIS]);
-    shader.setMat4("rotation", rotation);
-
-    Matrix projection = Matrix::perspective(camera.getFov(), (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT, 0.1f, 100.0f);
-    shader.setMat4("projection", projection);
-
-    Matrix view = Matrix::lookAt(camera.getPosition(), camera.getPosition() + camera.getFrontDirection(),
-                                 camera.getUpDirection());
-    shader.setMat4("view", view);
+    return (rotation);
 }
 
 /**
@@ -252,8 +708,11 @@ void WindowManagement::updateShader(const Texture &texture, const Shader &shader
  */
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
-    (void)window;
+    s_data *data = reinterpret_cast<s_data *>(glfwGetWindowUserPointer(window));
     glViewport(0, 0, width, height);
+    data->camera.setViewport(width, height);
+    data->framebufferSize = {width, height};
+    data->dirtyFlags |= DISPLAY_DIRTY | CAMERA_DIRTY;
 }
 
 void mouse_callback(GLFWwindow *window, double xPos, double yPos)
@@ -265,7 +724,9 @@ void mouse_callback(GLFWwindow *window, double xPos, double yPos)
 
     float xOffset;
     float yOffset;
-    Camera *camera = reinterpret_cast<Camera *>(glfwGetWindowUserPointer(window));
+    s_data *data = reinterpret_cast<s_data *>(glfwGetWindowUserPointer(window));
+    Camera *camera = &data->camera;
+    data->dirtyFlags |= CAMERA_DIRTY;
     xOffset = (xPos - lastX) * sensitivity;
     yOffset = (lastY - yPos) * sensitivity;
     lastX = xPos;
@@ -282,7 +743,9 @@ void scroll_callback(GLFWwindow *window, double xOffset, double yOffset)
 {
     (void)xOffset;
 
-    Camera *camera = reinterpret_cast<Camera *>(glfwGetWindowUserPointer(window));
+    s_data *data = reinterpret_cast<s_data *>(glfwGetWindowUserPointer(window));
+    Camera *camera = &data->camera;
+    data->dirtyFlags |= CAMERA_DIRTY;
     camera->addToFov((float)-yOffset);
     if (camera->getFov() < 1.0f)
         camera->setFov(1.0f);
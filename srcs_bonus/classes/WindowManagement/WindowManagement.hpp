@@ -4,13 +4,23 @@
 #include <GLFW/glfw3.h>
 
 #include "../Camera/Camera.hpp"
+#include "../FrameCapture/FrameCapture.hpp"
+#include "../FramePacer/FramePacer.hpp"
+#include "../MaterialClasses/MaterialBuffer/MaterialBuffer.hpp"
 #include "../ObjectClasses/Object/Object.hpp"
+#include "../ObjectPicker/ObjectPicker.hpp"
+#include "../RenderTarget/RenderTarget.hpp"
+#include "../ResolutionScaler/ResolutionScaler.hpp"
 #include "../Shader/Shader.hpp"
-#include "../Texture/Texture.hpp"
+#include "../ShaderVariants/ShaderVariants.hpp"
+#include "../TextureArray/TextureArray.hpp"
+#include <array>
 #include <vector>
 
 #define WINDOW_WIDTH 800
 #define WINDOW_HEIGHT 600
+#define DEFAULT_FRAME_MODE VSYNC_MODE
+#define IDLE_TIMEOUT 1.0 // seconds waited for an event before checking the window again
 
 typedef enum axis
 {
@@ -19,15 +29,52 @@ typedef enum axis
     Z_AXIS
 } e_axis;
 
+// what changed since the last rendered frame
+typedef enum dirtyFlag
+{
+    CAMERA_DIRTY = 1 << 0,
+    ROTATION_DIRTY = 1 << 1,
+    DISPLAY_DIRTY = 1 << 2,
+    BLEND_DIRTY = 1 << 3,
+    RESOLUTION_DIRTY = 1 << 4, // the last image was rendered below the native resolution
+    CAPTURE_DIRTY = 1 << 5,    // the frames are captured, even if nothing changes
+    PICKING_DIRTY = 1 << 6,    // a pick waits for a frame to be drawn or read back
+    ALL_DIRTY = CAMERA_DIRTY | ROTATION_DIRTY | DISPLAY_DIRTY | BLEND_DIRTY | RESOLUTION_DIRTY | CAPTURE_DIRTY |
+                PICKING_DIRTY
+} e_dirtyFlag;
+
+// a range of faces drawn with the same state, the commands are sorted to change the state as little as possible
+typedef struct drawCommand
+{
+    unsigned int shaderID;
+    int materialLocation; // of the material index in the shader
+    unsigned int textureID;
+    int materialIndex;
+    unsigned int VAO;
+    size_t firstIndex;
+    size_t nbIndices;
+    size_t nbInstances;
+} s_drawCommand;
+
 typedef struct data
 {
     std::vector<Object> objects;
+    std::vector<s_drawCommand> drawCommands;
     Camera camera;
+    FramePacer framePacer;
+    ResolutionScaler resolution;
+    std::array<int, 2> framebufferSize;
+    unsigned int dirtyFlags; // e_dirtyFlag
 
     bool displayColor;
+    bool lighting;
+    bool wireframe;
+    bool capturing;
+    bool picking; // a click waits for the next rendered frame
     float mixedValue;
     float sceneRotation[3];
     float inputRotation[3];
+    bool inputHeld; // a movement or rotation key is held, the next frame can't wait for an event
     Matrix axis[3];
 } s_data;
 
@@ -40,29 +87,50 @@ class WindowManagement : public s_data
   private:
     GLFWwindow *window;
 
-    void start(const std::vector<Object> &objects);
+    void start(std::vector<Object> &&objects);
     void initGLFW();
     void initWindow();
     void initOpenGL();
-    void initData(const std::vector<Object> &objects);
+    void initData(std::vector<Object> &&objects);
 
     void updateLoop();
+    void waitEvents();
+    std::vector<unsigned int> getMaterialIDs() const;
+    std::vector<std::string> getTexturePaths() const;
+    void initDrawCommands(const Shader &shader, int materialLocation, const TextureArray &textures,
+                          const MaterialBuffer &materials);
+    void selectShader(const Shader &shader, int materialLocation);
 
     void processInput();
     bool isKeyPressed(int key);
     void updateDisplayMode();
     void updateWireframeMode();
     void updateTextureMode();
+    void updateLightingMode();
+    void updateFrameMode();
+    void updateIdleMode();
+    void updateProfilerMode();
+    void updateResolutionMode();
+    void updateCaptureMode();
+    void updateMouseButton();
+    void saveProfile();
+    void updateWindowTitle();
     void updateCameraPosition();
     void updateSceneOrientation();
 
-    void updateScene(const Texture &texture, const Shader &shader);
-    void updateCameraView();
+    void updateScene(const TextureArray &textures, const ShaderVariants &shaders, RenderTarget &target,
+                     FrameCapture &capture, ObjectPicker &picker);
+    void updateCapture(FrameCapture &capture);
+    void stopCapture(FrameCapture &capture);
+    void updatePicking(ObjectPicker &picker);
+    void printPick(const s_pickResult &result) const;
+    Matrix getSceneRotation() const;
     void updateTexture();
-    void renderObject(const Object &object, const Texture &texture, const Shader &shader);
-    void updateShader(const Texture &texture, const Shader &shader);
+    void swapBuffers();
+    void renderDrawCommands(const Shader &shader);
+    void updateShader(const TextureArray &textures, const Shader &shader);
 
   public:
-    WindowManagement(const std::vector<Object> &objects);
+    WindowManagement(std::vector<Object> &&objects);
     ~WindowManagement();
 };
\ No newline at end of file
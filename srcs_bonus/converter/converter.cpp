@@ -0,0 +1,48 @@
+#include "../classes/Image/Image.hpp"
+#include "../classes/ObjectClasses/MeshStreamer/MeshStreamer.hpp"
+#include "../classes/TextureContainer/TextureContainer.hpp"
+#include "../classes/Utils/Utils.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * offline converter from a PNM image to a texture container (.stx).
+ * every mipmap level is computed here, so they are only uploaded when scop starts.
+ * --bc1 compresses the levels (8 bytes per block of 4 * 4 pixels)
+ *
+ * an object file is converted to a mesh cache (.smc) with a bounded memory,
+ * so an object larger than the memory can still be displayed
+ */
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        if (argc == 3 && Utils::checkExtension(argv[1], ".obj"))
+        {
+            const MeshStreamer streamer(argv[1]);
+            streamer.save(argv[2]);
+
+            std::cout << argv[2] << ": " << streamer.getNbVertices() << " vertices, " << streamer.getNbIndices() / 3
+                      << " triangles" << std::endl;
+            return (EXIT_SUCCESS);
+        }
+        if (argc != 3 && (argc != 4 || std::string(argv[3]) != "--bc1"))
+            throw(std::runtime_error("CONVERTER::USAGE: ./scop_converter <image.ppm> <texture.stx> [--bc1]\n"
+                                     "                  ./scop_converter <object.obj> <mesh.smc>"));
+
+        const Image image(argv[1]);
+        const TextureContainer container(image, (argc == 4) ? BC1_FORMAT : RGB8_FORMAT);
+        container.save(argv[2]);
+
+        std::cout << argv[2] << ": " << container.getLevels().size() << " levels, " << container.getDataSize()
+                  << " bytes" << std::endl;
+        return (EXIT_SUCCESS);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return (EXIT_FAILURE);
+    }
+}
@@ -1,9 +1,11 @@
+#include "classes/LoadStats/LoadStats.hpp"
 #include "classes/ObjectClasses/Object/Object.hpp"
 #include "classes/ObjectClasses/ObjectParser/ObjectParser.hpp"
 #include "classes/WindowManagement/WindowManagement.hpp"
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 /**
  * main function.
@@ -18,9 +20,11 @@ int main(int argc, char **argv)
     {
         if (argc != 2)
             throw(std::runtime_error("MAIN::NO_INPUT_FILE"));
+        LoadStats::setEnabled(std::getenv(LOAD_STATS_ENV) != NULL);
 
         std::vector<Object> objects = ObjectParser::parseObjectFile(argv[1]);
-        WindowManagement instance(objects);
+        WindowManagement instance(std::move(objects));
+        LoadStats::report();
 
         return (EXIT_SUCCESS);
     }
@@ -0,0 +1,94 @@
+#include "../classes/Camera/Camera.hpp"
+#include "../classes/FrameCapture/FrameCapture.hpp"
+#include "../classes/FrameEncoder/FrameEncoder.hpp"
+#include "../classes/JobSystem/JobSystem.hpp"
+#include "../classes/Matrix/Matrix.hpp"
+#include "../classes/ObjectClasses/Object/Object.hpp"
+#include "../classes/ObjectClasses/ObjectParser/ObjectParser.hpp"
+#include "../classes/SoftwareRasterizer/SoftwareRasterizer.hpp"
+#include "../classes/TextureArray/TextureArray.hpp"
+#include "../classes/Utils/Utils.hpp"
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define RENDER_WIDTH 800
+#define RENDER_HEIGHT 600
+#define RENDER_FRAMES 1
+
+/**
+ * renders an object without a window nor OpenGL, with the software rasterizer.
+ * the camera is the one scop starts with, the frames turn the scene once around the Y axis.
+ * the output follows the rules of the frame capture: a path ending with .y4m is a video,
+ * any other path is the prefix of a PPM file per frame.
+ * mix is the texture mixed with the colors (from 0 to 1), the light is always on
+ */
+
+static int parseArgument(const char *argument, const std::string &name)
+{
+    long value;
+
+    if (!Utils::parseInt(argument, value) || value <= 0 || value > INT_MAX)
+        throw(std::runtime_error("RENDER::INVALID_" + name + ": " + argument));
+    return (value);
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        if ((argc != 3 && argc != 5 && argc != 6 && argc != 7) || !Utils::checkExtension(argv[1], ".obj"))
+            throw(std::runtime_error(
+                "RENDER::USAGE: ./scop_render <object.obj> <output.y4m | prefix> [width height [frames [mix]]]"));
+        const int width = (argc >= 5) ? parseArgument(argv[3], "WIDTH") : RENDER_WIDTH;
+        const int height = (argc >= 5) ? parseArgument(argv[4], "HEIGHT") : RENDER_HEIGHT;
+        const int nbFrames = (argc >= 6) ? parseArgument(argv[5], "FRAMES") : RENDER_FRAMES;
+        float mixValue = 0;
+        if (argc == 7 && (!Utils::parseFloat(argv[6], mixValue) || mixValue < 0 || mixValue > 1))
+            throw(std::runtime_error(std::string("RENDER::INVALID_MIX: ") + argv[6]));
+
+        std::vector<Object> objects = ObjectParser::parseObjectFile(argv[1]);
+        JobSystem::getShared().parallelFor(objects.size(), 1, [&objects](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+                objects[i].prepare();
+        });
+        Camera camera;
+        camera.setViewport(width, height);
+        SoftwareRasterizer rasterizer(width, height);
+        rasterizer.setScene(objects, DEFAULT_TEXTURE_PATH);
+        FrameEncoder encoder(argv[2], CAPTURE_FPS);
+
+        float yAxisValues[3] = {0, 1, 0};
+        Matrix yAxis(3, 1);
+        yAxis.setData(yAxisValues, 3);
+        double totalTime = 0;
+        for (int i = 0; i < nbFrames; i++)
+        {
+            Matrix rotation(4, 4);
+            rotation.identity();
+            rotation = Matrix::rotate(rotation, 2 * M_PI * i / nbFrames, yAxis);
+
+            const auto start = std::chrono::steady_clock::now();
+            rasterizer.render(camera, rotation, mixValue, true);
+            const auto end = std::chrono::steady_clock::now();
+            totalTime += std::chrono::duration<double, std::milli>(end - start).count();
+            encoder.push(rasterizer.getFrame(), true);
+        }
+        encoder.finish();
+
+        std::cout << argv[2] << ": " << nbFrames << " frames of " << width << " * " << height << ", "
+                  << rasterizer.getNbTriangles() << " triangles, " << totalTime / nbFrames << " ms per frame"
+                  << std::endl;
+        return (EXIT_SUCCESS);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return (EXIT_FAILURE);
+    }
+}
\ No newline at end of file
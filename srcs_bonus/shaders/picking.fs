@@ -0,0 +1,12 @@
+#version 330 core
+
+uniform uint objectID; // the index of the object + 1, 0 is the background
+
+flat in uint instanceID;
+out uvec4 FragID;
+
+void main()
+{
+    // an object is drawn from its first index, the primitive is the face
+    FragID = uvec4(objectID, instanceID, uint(gl_PrimitiveID), 0u);
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#version 330 core
+// the inputs are inserted from the vertex layouts, only aPos and aTranslation are used
+
+uniform mat4 rotation;
+uniform mat4 view;
+uniform mat4 projection;
+
+flat out uint instanceID;
+
+void main()
+{
+    gl_Position = projection * view * rotation * (aPos + vec4(aTranslation, 0.0f));
+    instanceID = uint(gl_InstanceID);
+}
\ No newline at end of file
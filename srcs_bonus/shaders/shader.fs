@@ -1,13 +1,71 @@
 #version 330 core
 
-uniform sampler2D texture1;
+#define MAX_MATERIALS 256
+#define AMBIANT_LIGHT 0.2f
+
+struct Material
+{
+    vec4 ambiantColor;
+    vec4 diffuseColor;
+    vec4 specularColor;
+    vec4 parameters; // specular exponent, opacity, texture layer, unused
+};
+
+layout (std140) uniform Materials
+{
+    Material materials[MAX_MATERIALS];
+};
+
+// the features (USE_COLOR, USE_TEXTURE, USE_LIGHTING) are defined by the variant being compiled
+uniform sampler2DArray texture1;
+uniform int materialIndex;
 uniform float aMixValue;
 
 in vec2 TexCoord;
 in vec3 color;
+in vec3 normal;
+in vec3 viewPosition;
 out vec4 FragColor;
 
+#ifdef USE_LIGHTING
+/*
+    the light comes from the camera: the diffuse light is the cosine between the normal and the view,
+    the half vector of Blinn-Phong is the view direction itself
+*/
+vec3 light(vec3 baseColor)
+{
+    Material material = materials[materialIndex];
+    vec3 lightDirection = normalize(-viewPosition);
+    vec3 fragmentNormal = normalize(normal);
+    if (!gl_FrontFacing)
+        fragmentNormal = -fragmentNormal;
+
+    float diffuse = max(dot(fragmentNormal, lightDirection), 0.0f);
+    float specular = 0.0f;
+    if (diffuse > 0.0f)
+        specular = pow(diffuse, max(material.parameters.x, 1.0f));
+    return (baseColor * (AMBIANT_LIGHT + diffuse) + material.specularColor.rgb * specular);
+}
+#endif
+
+#ifdef USE_TEXTURE
+vec4 sampleTexture()
+{
+    float textureLayer = materials[materialIndex].parameters.z;
+    return (texture(texture1, vec3(TexCoord, textureLayer)));
+}
+#endif
+
 void main()
 {
-    FragColor = mix(vec4(color, 1.0f), texture(texture1, TexCoord), aMixValue);
+#if defined(USE_COLOR) && defined(USE_TEXTURE)
+    FragColor = mix(vec4(color, 1.0f), sampleTexture(), aMixValue);
+#elif defined(USE_TEXTURE)
+    FragColor = sampleTexture();
+#else
+    FragColor = vec4(color, 1.0f);
+#endif
+#ifdef USE_LIGHTING
+    FragColor.rgb = light(FragColor.rgb);
+#endif
 }
\ No newline at end of file
@@ -1,7 +1,6 @@
 #version 330 core
-layout (location = 0) in vec4 aPos;
-layout (location = 1) in vec3 aTexCoord;
-layout (location = 2) in vec3 aColor;
+// the features of the variant (USE_COLOR, USE_TEXTURE, USE_LIGHTING) are defined first,
+// then the inputs (aPos, aTexCoord, aColor, aNormal, aTranslation, aInstanceColor) are inserted from the vertex layouts
 
 uniform mat4 rotation;
 uniform mat4 view;
@@ -9,10 +8,16 @@ uniform mat4 projection;
 
 out vec2 TexCoord;
 out vec3 color;
+out vec3 normal;      // in view space
+out vec3 viewPosition; // the position relative to the camera
 
 void main()
 {
-    gl_Position = projection * view * rotation * aPos;
+    vec4 position = view * rotation * (aPos + vec4(aTranslation, 0.0f));
+    gl_Position = projection * position;
     TexCoord = vec2(aTexCoord.x, aTexCoord.y);
-    color = aColor;
+    color = aColor * aInstanceColor;
+    // the rotation and the view have no scale, the normal doesn't need the inverse transpose
+    normal = mat3(view) * mat3(rotation) * aNormal;
+    viewPosition = position.xyz;
 }
\ No newline at end of file
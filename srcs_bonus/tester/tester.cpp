@@ -1,30 +1,111 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../classes/Utils/Utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <future>
+#include <fstream>
+#include <map>
+#include <type_traits>
 
 // allow to use private methods only on this file
 #define private public
 
 #include "../../libs/doctest.h"
+#include "../classes/Camera/Camera.hpp"
+#include "../classes/FrameEncoder/FrameEncoder.hpp"
+#include "../classes/FramePacer/FramePacer.hpp"
+#include "../classes/GLHandle/GLHandle.hpp"
+#include "../classes/Image/Image.hpp"
+#include "../classes/JobSystem/JobSystem.hpp"
+#include "../classes/LoadStats/LoadStats.hpp"
+#include "../classes/ObjectPicker/ObjectPicker.hpp"
+#include "../classes/Profiler/Profiler.hpp"
+#include "../classes/ProgramCache/ProgramCache.hpp"
+#include "../classes/ResolutionScaler/ResolutionScaler.hpp"
+#include "../classes/Shader/Shader.hpp"
+#include "../classes/ShaderVariants/ShaderVariants.hpp"
+#include "../classes/SoftwareRasterizer/SoftwareRasterizer.hpp"
+#include "../classes/SpillFile/SpillFile.hpp"
+#include "../classes/TextureArray/TextureArray.hpp"
+#include "../classes/TextureContainer/TextureContainer.hpp"
+#include "../classes/MaterialClasses/MaterialBuffer/MaterialBuffer.hpp"
 #include "../classes/MaterialClasses/MaterialParser/MaterialParser.hpp"
+#include "../classes/MaterialClasses/MaterialRegistry/MaterialRegistry.hpp"
+#include "../classes/ObjectClasses/MeshStreamer/MeshStreamer.hpp"
+#include "../classes/ObjectClasses/NormalGenerator/NormalGenerator.hpp"
 #include "../classes/ObjectClasses/ObjectParser/ObjectParser.hpp"
 
-// maybe test texture too
 TEST_CASE("test useful functions")
 {
+    auto split = [](std::string_view line, char separator = ' ') {
+        const std::pmr::vector<std::string_view> words = Utils::splitLine(line, separator);
+        return (std::vector<std::string_view>(words.begin(), words.end()));
+    };
+
     SUBCASE("test the splitLine function")
     {
         std::string line1 = "hi ! How are you ?";
-        std::vector<std::string> lineSplit1 = {"hi", "!", "How", "are", "you", "?"};
-        CHECK_MESSAGE(Utils::splitLine(line1, " ") == lineSplit1, "line: ", line1);
+        std::vector<std::string_view> lineSplit1 = {"hi", "!", "How", "are", "you", "?"};
+        CHECK_MESSAGE(split(line1) == lineSplit1, "line: ", line1);
         std::string line2 = "     multiples     spaces     ";
-        std::vector<std::string> lineSplit2 = {"multiples", "spaces"};
-        CHECK_MESSAGE(Utils::splitLine(line2, " ") == lineSplit2, "line: ", line2);
+        std::vector<std::string_view> lineSplit2 = {"multiples", "spaces"};
+        CHECK_MESSAGE(split(line2) == lineSplit2, "line: ", line2);
         std::string line3 = "";
-        std::vector<std::string> lineSplit3 = {};
-        CHECK_MESSAGE(Utils::splitLine(line3, " ") == lineSplit3, "line: {nothing}");
+        std::vector<std::string_view> lineSplit3 = {};
+        CHECK_MESSAGE(split(line3) == lineSplit3, "line: {nothing}");
         std::string line4 = "            ";
-        std::vector<std::string> lineSplit4 = {};
-        CHECK_MESSAGE(Utils::splitLine(line4, " ") == lineSplit4, "line: {only space}");
+        std::vector<std::string_view> lineSplit4 = {};
+        CHECK_MESSAGE(split(line4) == lineSplit4, "line: {only space}");
+        std::string line5 = "v\t1.0 \t 2.0\r";
+        std::vector<std::string_view> lineSplit5 = {"v", "1.0", "2.0"};
+        CHECK_MESSAGE(split(line5) == lineSplit5, "line: {tabs}");
+        std::string line6 = "f 1/2 3/4";
+        std::vector<std::string_view> lineSplit6 = {"f", "1", "2", "3", "4"};
+        CHECK_MESSAGE(split(line6, '/') == lineSplit6, "line: ", line6);
+    }
+
+    SUBCASE("test the splitLine function on words across the blocks")
+    {
+        // the words and the separators cross the 16 or 32 bytes compared at once
+        const std::string whitespaces[] = {" ", "\t", "  \t ", "\r\n"};
+        std::string line;
+        std::vector<std::string> words;
+        for (size_t i = 0; i < 200; i++)
+        {
+            words.push_back(std::string(i % 37 + 1, 'a' + i % 26));
+            line += whitespaces[i % 4] + words.back();
+        }
+        const std::vector<std::string_view> lineSplit = split(line);
+        CHECK(std::equal(lineSplit.begin(), lineSplit.end(), words.begin(), words.end()));
+
+        const std::string letters(100, 'x');
+        const std::string spaces(100, ' ');
+        CHECK(Utils::findSeparator(letters, 0) == letters.size());
+        CHECK(Utils::findSeparator(letters + " x", 0) == letters.size());
+        CHECK(Utils::findSeparator("abc/def", 0, '/') == 3);
+        CHECK(Utils::skipSeparators(spaces, 0) == spaces.size());
+        CHECK(Utils::skipSeparators(spaces + "x", 10) == spaces.size());
+    }
+
+    SUBCASE("test the splitLine function with an arena")
+    {
+        char buffer[1024];
+        // nothing can be allocated out of the buffer
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        const std::vector<std::string> lines = {"hi ! How are you ?", "     multiples     spaces     ", "", "            "};
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            {
+                const std::pmr::vector<std::string_view> words = Utils::splitLine(lines[i], &arena);
+                const std::vector<std::string_view> lineSplit = split(lines[i]);
+                CHECK_MESSAGE(std::equal(words.begin(), words.end(), lineSplit.begin(), lineSplit.end()),
+                              "line: ", lines[i]);
+                CHECK(words.get_allocator().resource() == &arena);
+            }
+            arena.release();
+        }
     }
 
     // didn't test degToRad function because comparaison of float is always false
@@ -41,28 +122,42 @@ TEST_CASE("test useful functions")
 
     SUBCASE("testing if a string can be converted to an int")
     {
-        CHECK(Utils::isInt("0123456789"));
-        CHECK(Utils::isInt("-1"));
-        CHECK_FALSE(Utils::isInt("0.1"));
-        CHECK_FALSE(Utils::isInt("1-"));
-        CHECK_FALSE(Utils::isInt("-100-1"));
-        CHECK_FALSE(Utils::isInt("1a"));
-        CHECK_FALSE(Utils::isInt("a1"));
+        long integer;
+        CHECK(Utils::parseInt("0123456789", integer));
+        CHECK(Utils::parseInt("-1", integer));
+        CHECK_FALSE(Utils::parseInt("0.1", integer));
+        CHECK_FALSE(Utils::parseInt("1-", integer));
+        CHECK_FALSE(Utils::parseInt("-100-1", integer));
+        CHECK_FALSE(Utils::parseInt("1a", integer));
+        CHECK_FALSE(Utils::parseInt("a1", integer));
+        CHECK_FALSE(Utils::parseInt("", integer));
+        CHECK_FALSE(Utils::parseInt("+1", integer));
+        CHECK_FALSE(Utils::parseInt("99999999999999999999", integer));
+        CHECK((Utils::parseInt("-42", integer) && integer == -42));
     }
 
     SUBCASE("testing if a string can be converted to a float")
     {
-        CHECK(Utils::isFloat("0123456789"));
-        CHECK(Utils::isFloat("0.01"));
-        CHECK(Utils::isFloat("-0.01"));
-        CHECK_FALSE(Utils::isFloat(".1"));
-        CHECK_FALSE(Utils::isFloat("0..1"));
-        CHECK_FALSE(Utils::isFloat("-.1"));
-        CHECK_FALSE(Utils::isFloat("a.1"));
-        CHECK_FALSE(Utils::isFloat("1-"));
-        CHECK_FALSE(Utils::isFloat("-100-1"));
-        CHECK_FALSE(Utils::isFloat("1a"));
-        CHECK_FALSE(Utils::isFloat("a1"));
+        float number;
+        CHECK(Utils::parseFloat("0123456789", number));
+        CHECK(Utils::parseFloat("0.01", number));
+        CHECK(Utils::parseFloat("-0.01", number));
+        CHECK_FALSE(Utils::parseFloat(".1", number));
+        CHECK_FALSE(Utils::parseFloat("0..1", number));
+        CHECK_FALSE(Utils::parseFloat("-.1", number));
+        CHECK_FALSE(Utils::parseFloat("a.1", number));
+        CHECK_FALSE(Utils::parseFloat("1-", number));
+        CHECK_FALSE(Utils::parseFloat("-100-1", number));
+        CHECK_FALSE(Utils::parseFloat("1a", number));
+        CHECK_FALSE(Utils::parseFloat("a1", number));
+        CHECK_FALSE(Utils::parseFloat("", number));
+        CHECK_FALSE(Utils::parseFloat("inf", number));
+        CHECK_FALSE(Utils::parseFloat("nan", number));
+        CHECK_FALSE(Utils::parseFloat("1e", number));
+        CHECK_FALSE(Utils::parseFloat("1e99", number));
+        CHECK((Utils::parseFloat("1e-5", number) && number == 1e-5f));
+        CHECK((Utils::parseFloat("-2.5E+2", number) && number == -250.0f));
+        CHECK((Utils::parseFloat("0.125", number) && number == 0.125f));
     }
 }
 
@@ -86,6 +181,27 @@ TEST_CASE("test the definition of an object")
         CHECK_THROWS(ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/objectWrongSymbol.obj"));
     }
 
+    SUBCASE("testing the parsing of files at the same time")
+    {
+        const std::vector<Face> expectedFaces =
+            ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/object.obj")[0].getFaces();
+        std::vector<std::future<bool>> results;
+        for (size_t i = 0; i < 4; i++)
+        {
+            results.push_back(std::async(std::launch::async, [&expectedFaces]() {
+                for (size_t j = 0; j < 50; j++)
+                {
+                    if (ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/object.obj")[0].getFaces() !=
+                        expectedFaces)
+                        return (false);
+                }
+                return (true);
+            }));
+        }
+        for (size_t i = 0; i < results.size(); i++)
+            CHECK(results[i].get());
+    }
+
     ObjectData objectData;
     SUBCASE("testing the definition of a name")
     {
@@ -100,6 +216,8 @@ TEST_CASE("test the definition of an object")
         objectData.reset();
         CHECK_NOTHROW(ObjectParser::defineVertex(objectData, "v -0.5 0 0.5 ", 0));
         CHECK_NOTHROW(ObjectParser::defineVertex(objectData, "v -0.5 0 0.5 1", 0));
+        CHECK_NOTHROW(ObjectParser::defineVertex(objectData, "v -5e-1 0 5E-1", 0));
+        CHECK(objectData.getVertex(objectData.getNbVertices() - 1) == Vertex({-0.5f, 0, 0.5f, 1}));
         CHECK_THROWS(ObjectParser::defineVertex(objectData, "v -0.5 0 0 0", 0));
         CHECK_THROWS(ObjectParser::defineVertex(objectData, "v -0.5 0", 0));
         CHECK_THROWS(ObjectParser::defineVertex(objectData, "v -0.5 0 0.5 1 1", 0));
@@ -124,6 +242,19 @@ TEST_CASE("test the definition of an object")
         CHECK_THROWS(ObjectParser::defineTextureVertex(objectData, "vt 0.5a 0.5", 0));
     }
 
+    SUBCASE("testing the definition of a normal")
+    {
+        objectData.reset();
+        CHECK_NOTHROW(ObjectParser::defineNormal(objectData, "vn 0 0 1", 0));
+        CHECK_NOTHROW(ObjectParser::defineNormal(objectData, "vn 0 3 -4 ", 0));
+        CHECK(objectData.getNormal(1) == Vertex({0, 0.6f, -0.8f}));
+        CHECK_NOTHROW(ObjectParser::defineNormal(objectData, "vn 0 0 0", 0));
+        CHECK(objectData.getNormal(2) == Vertex({0, 0, 0}));
+        CHECK_THROWS(ObjectParser::defineNormal(objectData, "vn 0 1", 0));
+        CHECK_THROWS(ObjectParser::defineNormal(objectData, "vn 0 0 1 1", 0));
+        CHECK_THROWS(ObjectParser::defineNormal(objectData, "vn 0 a 1", 0));
+    }
+
     SUBCASE("testing the definition of a face")
     {
         objectData.reset();
@@ -147,6 +278,14 @@ TEST_CASE("test the definition of an object")
         CHECK_THROWS(ObjectParser::defineFace(objectData, "f 1/1 / 2/2 3/3 4/4", 0));
         CHECK_THROWS(ObjectParser::defineFace(objectData, "f 1/1 / 2/2 3/3 4/4a", 0));
         CHECK_THROWS(ObjectParser::defineFace(objectData, "f 1/1 / 2/2 3/3 4/3.5", 0));
+
+        ObjectParser::defineNormal(objectData, "vn 0 0 2", 0);
+        CHECK_NOTHROW(ObjectParser::defineFace(objectData, "f 1/1/1 2/2/1 3/3/-1", 0));
+        CHECK(objectData.getCombinedVertex(objectData.getNbCombinedVertices() - 1) ==
+              Vertex({1, 1, 0, 1, 1, 1, 0, 0, 0, 1}));
+        CHECK_THROWS(ObjectParser::defineFace(objectData, "f 1/1/2 2/2/1 3/3/1", 0));
+        CHECK_THROWS(ObjectParser::defineFace(objectData, "f 1/1/1/1 2/2/1 3/3/1", 0));
+        CHECK_THROWS(ObjectParser::defineFace(objectData, "f 1//1 2//1 3//1", 0));
     }
 
     SUBCASE("testing the definition of smooth shading")
@@ -156,20 +295,36 @@ TEST_CASE("test the definition of an object")
         CHECK_NOTHROW(ObjectParser::defineSmoothShading(objectData, "s off", 0));
         CHECK_NOTHROW(ObjectParser::defineSmoothShading(objectData, "s 0", 0));
         CHECK_NOTHROW(ObjectParser::defineSmoothShading(objectData, "s 1", 0));
+        CHECK_NOTHROW(ObjectParser::defineSmoothShading(objectData, "s 2", 0));
+        CHECK(objectData.getSmoothingGroup() == 2);
         CHECK_THROWS(ObjectParser::defineSmoothShading(objectData, "s", 0));
         CHECK_THROWS(ObjectParser::defineSmoothShading(objectData, "s 1 1", 0));
         CHECK_THROWS(ObjectParser::defineSmoothShading(objectData, "s -1", 0));
-        CHECK_THROWS(ObjectParser::defineSmoothShading(objectData, "s 2", 0));
+        CHECK_THROWS(ObjectParser::defineSmoothShading(objectData, "s 99999999999", 0));
         CHECK_THROWS(ObjectParser::defineSmoothShading(objectData, "s iufhrng", 0));
+
+        ObjectParser::defineVertex(objectData, "v 0 0 0", 0);
+        ObjectParser::defineTextureVertex(objectData, "vt 0 0", 0);
+        ObjectParser::defineFace(objectData, "f 1/1 1/1 1/1", 0);
+        ObjectParser::defineSmoothShading(objectData, "s off", 0);
+        ObjectParser::defineFace(objectData, "f 1/1 1/1 1/1", 0);
+        CHECK(objectData.getSmoothingGroups() == std::vector<unsigned int>({2, 0}));
     }
 
     SUBCASE("testing the usage of a mtllib")
     {
         objectData.reset();
+        MaterialRegistry::clear();
         CHECK_NOTHROW(ObjectParser::saveNewMTL(objectData, "mtllib srcs_bonus/tester/ressources/material.mtl", 0));
-        CHECK(ObjectParser::materials.size() == 2);
-        CHECK(ObjectParser::materials[0].getName() == "Material");
-        CHECK(ObjectParser::materials[1].getName() == "Material2");
+        CHECK_NOTHROW(ObjectParser::saveNewMTL(objectData, "mtllib ./srcs_bonus/tester/ressources/material.mtl", 0));
+        CHECK(MaterialRegistry::getNbMaterials() == 2);
+        CHECK(MaterialRegistry::getMaterial(0u).getName() == "Material");
+        CHECK(MaterialRegistry::getMaterial(1u).getName() == "Material2");
+        CHECK(MaterialRegistry::getMaterialID("Material2") == 1);
+        CHECK_THROWS(MaterialRegistry::getMaterialID("dontExist"));
+        CHECK_NOTHROW(ObjectParser::saveNewMTL(objectData, "mtllib srcs_bonus/tester/ressources/materialWronSymbol.mtl", 0));
+        CHECK_THROWS(MaterialRegistry::waitAll());
+        CHECK_NOTHROW(MaterialRegistry::waitAll());
         CHECK_THROWS(ObjectParser::saveNewMTL(objectData, "mtllib ", 0));
         CHECK_THROWS(ObjectParser::saveNewMTL(objectData, "mtllib first.mtl second.mtl", 0));
     }
@@ -184,6 +339,98 @@ TEST_CASE("test the definition of an object")
         CHECK_THROWS(ObjectParser::defineMTL(objectData, "usemtl first second", 0));
         CHECK_THROWS(ObjectParser::defineMTL(objectData, "usemtl dontExist ", 0));
     }
+
+    SUBCASE("testing the split of an object by material")
+    {
+        const Face face = {1, 2, 3};
+
+        objectData.reset();
+        MaterialRegistry::clear();
+        ObjectParser::saveNewMTL(objectData, "mtllib srcs_bonus/tester/ressources/material.mtl", 0);
+        MaterialRegistry::waitAll();
+        objectData.addFace(face);
+        ObjectParser::defineMTL(objectData, "usemtl Material2", 0);
+        ObjectParser::defineMTL(objectData, "usemtl Material", 0);
+        objectData.addFace(face);
+        objectData.addFace(face);
+        ObjectParser::defineMTL(objectData, "usemtl Material2", 0);
+        objectData.addFace(face);
+        ObjectParser::defineMTL(objectData, "usemtl Material", 0);
+        objectData.addFace(face);
+        CHECK(objectData.getSubMeshes().size() == 4);
+        CHECK(objectData.getSubMeshes()[1].materialID == MaterialRegistry::getMaterialID("Material"));
+        CHECK(objectData.getSubMeshes()[1].nbFaces == 2);
+        CHECK(objectData.getCurrentMaterialID() == MaterialRegistry::getMaterialID("Material"));
+
+        objectData.groupFacesByMaterial();
+        std::vector<s_subMesh> subMeshes = objectData.getSubMeshes();
+        CHECK(subMeshes.size() == 3);
+        CHECK(subMeshes[0].materialID == 0);
+        CHECK(subMeshes[0].firstFace == 0);
+        CHECK(subMeshes[0].nbFaces == 3);
+        CHECK(subMeshes[1].materialID == 1);
+        CHECK(subMeshes[1].firstFace == 3);
+        CHECK(subMeshes[2].materialID == NO_MATERIAL);
+        CHECK(subMeshes[2].firstFace == 4);
+        CHECK(objectData.getFaces().size() == 5);
+
+        std::vector<Object> objects = ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/objectMaterials.obj");
+        CHECK(objects.size() == 2);
+        CHECK(objects[0].getSubMeshes().size() == 2);
+        CHECK(objects[0].getSubMeshes()[0].materialID == MaterialRegistry::getMaterialID("Material2"));
+        CHECK(objects[1].getSubMeshes().size() == 1);
+        CHECK(objects[1].getSubMeshes()[0].materialID == MaterialRegistry::getMaterialID("Material"));
+    }
+
+    SUBCASE("testing the materials of a previous scene")
+    {
+        MaterialRegistry::clear();
+        MaterialRegistry::prefetch("srcs_bonus/tester/ressources/materialOther.mtl");
+        CHECK(MaterialRegistry::hasMaterial("Other"));
+        CHECK(MaterialRegistry::getMaterial("Material").getColor(AMBIANT_COLOR)[0] == doctest::Approx(0.1f));
+
+        std::vector<Object> objects = ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/objectMaterials.obj");
+        CHECK_FALSE(MaterialRegistry::hasMaterial("Other"));
+        CHECK(MaterialRegistry::getNbMaterials() == 2);
+        CHECK(MaterialRegistry::getMaterial("Material").getColor(AMBIANT_COLOR)[0] == doctest::Approx(0.5f));
+
+        // a file changed after being parsed keeps its first result: it isn't parsed again by the next scenes
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string materialPath = (directory / "scop_test_scene.mtl").string();
+        const std::string objectPath = (directory / "scop_test_scene.obj").string();
+        std::ofstream(materialPath) << "newmtl Scene\nKa 0.1 0.1 0.1\n";
+        std::ofstream(objectPath) << "mtllib " << materialPath << "\nv 0 0 0\nv 1 0 0\nv 1 1 0\nvt 0 0\n"
+                                  << "usemtl Scene\nf 1/1 2/1 3/1";
+        ObjectParser::parseObjectFile(objectPath);
+        const size_t nbFiles = MaterialRegistry::files.size();
+        std::ofstream(materialPath) << "newmtl Scene\nKa 0.9 0.9 0.9\n";
+        objects = ObjectParser::parseObjectFile(objectPath);
+        CHECK(MaterialRegistry::files.size() == nbFiles);
+        CHECK(MaterialRegistry::getNbMaterials() == 1);
+        CHECK(MaterialRegistry::getMaterial("Scene").getColor(AMBIANT_COLOR)[0] == doctest::Approx(0.1f));
+        std::filesystem::remove(materialPath);
+        std::filesystem::remove(objectPath);
+    }
+
+    SUBCASE("testing the instances of a repeated geometry")
+    {
+        std::vector<Object> objects = ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/objectInstances.obj");
+        CHECK(objects.size() == 2);
+        CHECK(objects[0].getGeometryHash() != objects[1].getGeometryHash());
+        CHECK_FALSE(objects[0].hasSameGeometry(objects[1]));
+        CHECK(objects[0].hasSameGeometry(objects[0]));
+        std::vector<s_instance> instances = objects[0].getInstances();
+        CHECK(instances.size() == 2);
+        CHECK(objects[1].getInstances().size() == 1);
+        CHECK(instances[1].translation[0] - instances[0].translation[0] == doctest::Approx(2));
+        CHECK(instances[1].translation[2] - instances[0].translation[2] == doctest::Approx(1));
+        CHECK(instances[0].color[0] == 1);
+        CHECK(instances[1].color[0] >= 0.5f);
+
+        objects = ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/object.obj");
+        CHECK(objects.size() == 1);
+        CHECK(objects[0].getInstances()[0].translation[0] == 0);
+    }
 }
 
 TEST_CASE("test the definition of a material")
@@ -294,4 +541,1140 @@ TEST_CASE("test the definition of a material")
         CHECK_THROWS(MaterialParser::defineIllum(materialData, "illum 0.1", 0));
         CHECK_THROWS(MaterialParser::defineIllum(materialData, "illum 1a", 0));
     }
+    SUBCASE("testing the definition of texture maps")
+    {
+        materialData.reset();
+        CHECK_NOTHROW(MaterialParser::defineDiffuseMap(materialData, "map_Kd textures/diffuse.ppm", 0));
+        CHECK_NOTHROW(MaterialParser::defineAmbiantMap(materialData, "map_Ka textures/ambiant.pgm", 0));
+        CHECK(materialData.getTextureMap(DIFFUSE_COLOR) == "textures/diffuse.ppm");
+        CHECK(materialData.getTextureMap(AMBIANT_COLOR) == "textures/ambiant.pgm");
+        CHECK(Material(materialData).getTextureMap(DIFFUSE_COLOR) == "textures/diffuse.ppm");
+        CHECK_NOTHROW(MaterialParser::defineDiffuseMap(materialData, "map_Kd textures/diffuse.stx", 0));
+        CHECK(materialData.getTextureMap(DIFFUSE_COLOR) == "textures/diffuse.stx");
+        CHECK_THROWS(MaterialParser::defineDiffuseMap(materialData, "map_Kd", 0));
+        CHECK_THROWS(MaterialParser::defineDiffuseMap(materialData, "map_Kd -s 1 1 1 textures/diffuse.ppm", 0));
+        CHECK_THROWS(MaterialParser::defineDiffuseMap(materialData, "map_Kd textures/diffuse.png", 0));
+        CHECK_THROWS(MaterialParser::defineAmbiantMap(materialData, "map_Ka first.ppm second.ppm", 0));
+    }
+}
+
+TEST_CASE("test the loading of an image")
+{
+    const unsigned char expectedPixels[] = {255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255};
+
+    SUBCASE("testing the loading of an ascii image")
+    {
+        Image image("srcs_bonus/tester/ressources/image.ppm");
+        CHECK(image.getWidth() == 2);
+        CHECK(image.getHeight() == 2);
+        CHECK(image.getChannels() == 3);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, image.getPixels()));
+    }
+
+    SUBCASE("testing the loading of a binary image")
+    {
+        Image image("srcs_bonus/tester/ressources/imageBinary.ppm");
+        CHECK(image.getChannels() == 3);
+        CHECK(image.data == nullptr);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, image.getPixels()));
+
+        Image image16Bits("srcs_bonus/tester/ressources/image16Bits.ppm");
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, image16Bits.getPixels()));
+
+        Image copy(image);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, copy.getPixels()));
+    }
+
+    SUBCASE("testing the loading of a gray image")
+    {
+        const unsigned char expectedGray[] = {0, 85, 170, 255};
+        Image image("srcs_bonus/tester/ressources/imageGray.pgm");
+        CHECK(image.getChannels() == 1);
+        CHECK(image.getSize() == 4);
+        CHECK(std::equal(expectedGray, expectedGray + 4, image.getPixels()));
+    }
+
+    SUBCASE("testing the loading of an invalid image")
+    {
+        CHECK_THROWS(Image("srcs_bonus/tester/ressources/dontExist.ppm"));
+        CHECK_THROWS(Image("srcs_bonus/tester/ressources/imageWrongHeader.ppm"));
+        CHECK_THROWS(Image("srcs_bonus/tester/ressources/imageWrongValue.ppm"));
+        CHECK_THROWS(Image("srcs_bonus/tester/ressources/imageMissingPixels.ppm"));
+
+        // an ascii header larger than the file is rejected before allocating its pixels
+        const std::string path = (std::filesystem::temp_directory_path() / "scop_test_ascii.ppm").string();
+        std::ofstream(path) << "P3 1000000 1000000 255\n0 0 0\n";
+        CHECK_THROWS_WITH(Image{path}, doctest::Contains("READ_ASCII_PIXELS::MISSING_PIXELS"));
+        std::filesystem::remove(path);
+        CHECK_THROWS(Image("srcs_bonus/tester/ressources/material.mtl"));
+    }
+}
+
+TEST_CASE("test the material buffer")
+{
+    SUBCASE("testing the layout of a material")
+    {
+        MaterialData materialData;
+        materialData.setColor(DIFFUSE_COLOR, {0.1f, 0.2f, 0.3f});
+        materialData.setSpecularExponent(250);
+        materialData.setOpacity(0.5f);
+        materialData.setTextureMap(AMBIANT_COLOR, "textures/ambiant.pgm");
+
+        const s_materialBlock block = MaterialBuffer::packMaterial(Material(materialData), 3);
+        CHECK(sizeof(s_materialBlock) == 4 * 4 * sizeof(float));
+        CHECK(block.diffuseColor[2] == doctest::Approx(0.3f));
+        CHECK(block.diffuseColor[3] == 1);
+        CHECK(block.ambiantColor[0] == 0);
+        CHECK(block.parameters[0] == 250);
+        CHECK(block.parameters[1] == doctest::Approx(0.5f));
+        CHECK(block.parameters[2] == 3);
+        CHECK(MaterialBuffer::getTextureMap(Material(materialData)) == "textures/ambiant.pgm");
+        materialData.setTextureMap(DIFFUSE_COLOR, "textures/diffuse.ppm");
+        CHECK(MaterialBuffer::getTextureMap(Material(materialData)) == "textures/diffuse.ppm");
+    }
+}
+
+TEST_CASE("test the texture array")
+{
+    SUBCASE("testing the resizing of an image for its layer")
+    {
+        const Image image("srcs_bonus/tester/ressources/imageGray.pgm");
+        const std::vector<unsigned char> pixels = TextureArray::resizeImage(image, 4, 4);
+        CHECK(pixels.size() == 4 * 4 * 3);
+        CHECK(pixels[0] == 0);
+        CHECK(pixels[3 * 3] == 85);
+        CHECK(pixels[(3 * 4 + 3) * 3 + 2] == 255);
+    }
+
+    SUBCASE("testing the layers uploaded from their containers")
+    {
+        const Image image("srcs_bonus/tester/ressources/image.ppm");
+        const Image bigImage(DEFAULT_TEXTURE_PATH);
+        std::vector<TextureContainer> containers;
+        containers.emplace_back(image, BC1_FORMAT);
+        containers.emplace_back(image, BC1_FORMAT);
+        CHECK(TextureArray::haveSameLevels(containers));
+        containers.emplace_back(image, RGB8_FORMAT);
+        CHECK_FALSE(TextureArray::haveSameLevels(containers));
+        containers.pop_back();
+        containers.emplace_back(bigImage, BC1_FORMAT);
+        CHECK_FALSE(TextureArray::haveSameLevels(containers));
+
+        const std::vector<unsigned char> pixels = TextureContainer(image, RGB8_FORMAT).getPixels(0);
+        CHECK(std::equal(image.getPixels(), image.getPixels() + 12, pixels.begin()));
+        CHECK(TextureContainer(image, BC1_FORMAT).getPixels(1).size() == 3);
+    }
+}
+
+TEST_CASE("test the texture container")
+{
+    const Image image("srcs_bonus/tester/ressources/image.ppm");
+    const Image grayImage("srcs_bonus/tester/ressources/imageGray.pgm");
+
+    SUBCASE("testing the generation of the mipmap levels")
+    {
+        const unsigned char expectedLevel[] = {128, 128, 128};
+        TextureContainer container(image, RGB8_FORMAT);
+        CHECK(container.getLevels().size() == 2);
+        CHECK(container.getLevels()[0].width == 2);
+        CHECK(container.getLevels()[1].width == 1);
+        CHECK(std::equal(image.getPixels(), image.getPixels() + 12, container.getLevels()[0].data));
+        CHECK(std::equal(expectedLevel, expectedLevel + 3, container.getLevels()[1].data));
+    }
+
+    SUBCASE("testing the BC1 compression")
+    {
+        const unsigned char expectedPixels[] = {0, 0, 0, 85, 85, 85, 170, 170, 170, 255, 255, 255};
+        TextureContainer container(grayImage, BC1_FORMAT);
+        CHECK(container.getLevels()[0].size == 8);
+        std::vector<unsigned char> pixels = TextureContainer::decompressBC1(container.getLevels()[0]);
+        CHECK(std::equal(expectedPixels, expectedPixels + 12, pixels.data()));
+    }
+
+    SUBCASE("testing the saving and the loading of a container")
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "scop_test.stx").string();
+        TextureContainer container(image, BC1_FORMAT);
+        container.save(path);
+        TextureContainer loadedContainer(path);
+        CHECK(loadedContainer.getFormat() == BC1_FORMAT);
+        CHECK(loadedContainer.getDataSize() == container.getDataSize());
+        CHECK(std::equal(container.getData(), container.getData() + container.getDataSize(),
+                         loadedContainer.getData()));
+        std::filesystem::remove(path);
+        CHECK_THROWS(TextureContainer("srcs_bonus/tester/ressources/image.ppm"));
+    }
+
+    SUBCASE("testing the container preferred to an image")
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string imagePath = (directory / "scop_test_texture.ppm").string();
+        const std::string containerPath = (directory / "scop_test_texture.stx").string();
+        std::filesystem::remove(containerPath);
+        CHECK(TextureContainer::getContainerPath(imagePath) == imagePath);
+        TextureContainer(image, RGB8_FORMAT).save(containerPath);
+        CHECK(TextureContainer::getContainerPath(imagePath) == containerPath);
+        CHECK(TextureContainer::getContainerPath(containerPath) == containerPath);
+        // an image modified after its conversion is loaded instead of its stale container
+        std::filesystem::copy_file("srcs_bonus/tester/ressources/image.ppm", imagePath,
+                                   std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::last_write_time(imagePath, std::filesystem::last_write_time(containerPath) -
+                                                        std::chrono::seconds(10));
+        CHECK(TextureContainer::getContainerPath(imagePath) == containerPath);
+        std::filesystem::last_write_time(imagePath, std::filesystem::last_write_time(containerPath) +
+                                                        std::chrono::seconds(10));
+        CHECK(TextureContainer::getContainerPath(imagePath) == imagePath);
+        std::filesystem::remove(imagePath);
+        std::filesystem::remove(containerPath);
+        CHECK(TextureContainer::getContainerPath("srcs_bonus/tester/ressources/image.ppm") ==
+              "srcs_bonus/tester/ressources/image.ppm");
+    }
+}
+
+/*
+    the normals of a mesh summed one corner at a time, to compare with the threads
+*/
+static std::vector<float> referenceNormals(const std::vector<float> &vertices, const std::vector<uint32_t> &indices,
+                                           const std::vector<uint32_t> &groups)
+{
+    std::map<std::array<float, 4>, std::array<float, 3>> sums;
+    std::vector<float> normals(indices.size() * 3);
+
+    for (size_t pass = 0; pass < 2; pass++)
+    {
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            const float *a = &vertices[indices[i / 3 * 3] * VERTEX_SIZE];
+            const float *b = &vertices[indices[i / 3 * 3 + 1] * VERTEX_SIZE];
+            const float *c = &vertices[indices[i / 3 * 3 + 2] * VERTEX_SIZE];
+            const float *p = &vertices[indices[i] * VERTEX_SIZE];
+            const float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const float ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            std::array<float, 3> normal = {ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2],
+                                           ab[0] * ac[1] - ab[1] * ac[0]};
+            const std::array<float, 4> key = {p[0], p[1], p[2], static_cast<float>(groups[i / 3])};
+            if (groups[i / 3] != 0 && pass == 0)
+            {
+                for (size_t j = 0; j < 3; j++)
+                    sums[key][j] += normal[j];
+                continue;
+            }
+            if (groups[i / 3] != 0)
+                normal = sums[key];
+            const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            for (size_t j = 0; j < 3 && pass == 1; j++)
+                normals[i * 3 + j] = normal[j] / length;
+        }
+    }
+    return (normals);
+}
+
+TEST_CASE("test the normal generation")
+{
+    SUBCASE("testing the smoothing groups")
+    {
+        // a roof: 2 faces folded along the Y axis, without shared vertices
+        const float roof[6][3] = {{0, 0, 0}, {0, 1, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {-1, 0, 1}};
+        const std::vector<uint32_t> indices = {0, 1, 2, 3, 4, 5};
+        std::vector<float> vertices(6 * VERTEX_SIZE, 0);
+        for (size_t i = 0; i < 6; i++)
+            std::copy(roof[i], roof[i] + 3, &vertices[i * VERTEX_SIZE]);
+
+        std::vector<float> flatVertices = vertices;
+        const std::vector<uint32_t> flatGroups = {0, 0};
+        NormalGenerator::generate(flatVertices.data(), {VERTEX_SIZE, VERTEX_NORMAL_OFFSET}, indices.data(), 2,
+                                  flatGroups.data());
+        CHECK(flatVertices[VERTEX_NORMAL_OFFSET] == doctest::Approx(std::sqrt(0.5f)));
+        CHECK(flatVertices[VERTEX_NORMAL_OFFSET + 2] == doctest::Approx(-std::sqrt(0.5f)));
+        CHECK(flatVertices[3 * VERTEX_SIZE + VERTEX_NORMAL_OFFSET] == doctest::Approx(-std::sqrt(0.5f)));
+
+        std::vector<float> smoothVertices = vertices;
+        const std::vector<uint32_t> smoothGroups = {1, 1};
+        smoothVertices[2 * VERTEX_SIZE + VERTEX_NORMAL_OFFSET] = 1;
+        NormalGenerator::generate(smoothVertices.data(), {VERTEX_SIZE, VERTEX_NORMAL_OFFSET}, indices.data(), 2,
+                                  smoothGroups.data());
+        for (size_t i : {0, 1, 3, 4})
+        {
+            CHECK(smoothVertices[i * VERTEX_SIZE + VERTEX_NORMAL_OFFSET] == doctest::Approx(0));
+            CHECK(smoothVertices[i * VERTEX_SIZE + VERTEX_NORMAL_OFFSET + 2] == doctest::Approx(-1));
+        }
+        CHECK(smoothVertices[2 * VERTEX_SIZE + VERTEX_NORMAL_OFFSET] == 1);
+        CHECK(smoothVertices[2 * VERTEX_SIZE + VERTEX_NORMAL_OFFSET + 2] == 0);
+        CHECK(smoothVertices[5 * VERTEX_SIZE + VERTEX_NORMAL_OFFSET] == doctest::Approx(-std::sqrt(0.5f)));
+
+        std::vector<float> splitVertices = vertices;
+        const std::vector<uint32_t> splitGroups = {1, 2};
+        NormalGenerator::generate(splitVertices.data(), {VERTEX_SIZE, VERTEX_NORMAL_OFFSET}, indices.data(), 2,
+                                  splitGroups.data());
+        CHECK(std::equal(splitVertices.begin(), splitVertices.end(), flatVertices.begin()));
+    }
+
+    SUBCASE("testing the vertices shared by the faces of a cube")
+    {
+        // 8 corners shared by the 12 triangles, as the parser combines them when the file has no normal
+        const float corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                     {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+        const int triangles[12][3] = {{0, 2, 1}, {0, 3, 2}, {4, 5, 6}, {4, 6, 7}, {0, 1, 5}, {0, 5, 4},
+                                      {3, 7, 6}, {3, 6, 2}, {0, 4, 7}, {0, 7, 3}, {1, 2, 6}, {1, 6, 5}};
+        auto generateCube = [&](const std::vector<uint32_t> &groups, size_t nbVertices) {
+            ObjectData cube;
+            for (size_t i = 0; i < 8; i++)
+            {
+                Vertex vertex(VERTEX_SIZE, 0);
+                std::copy(corners[i], corners[i] + 3, vertex.begin());
+                vertex[3] = 1;
+                cube.addCombinedVertex(vertex);
+            }
+            for (size_t i = 0; i < 12; i++)
+            {
+                cube.setSmoothingGroup(groups[i]);
+                cube.addFace(Face(triangles[i], triangles[i] + 3));
+            }
+            cube.splitVerticesByNormal();
+            CHECK(cube.getNbCombinedVertices() == nbVertices);
+
+            std::unique_ptr<float[]> verticesArray = cube.getCombinedVerticesIntoArray();
+            std::unique_ptr<unsigned int[]> facesArray = cube.getFacesIntoArray();
+            cube.generateNormals(verticesArray.get(), facesArray.get());
+            const std::vector<float> vertices(verticesArray.get(), verticesArray.get() + nbVertices * VERTEX_SIZE);
+            const std::vector<uint32_t> indices(facesArray.get(), facesArray.get() + 12 * 3);
+            const std::vector<float> expected = referenceNormals(vertices, indices, groups);
+            size_t nbDifferent = 0;
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                for (size_t j = 0; j < 3; j++)
+                    nbDifferent += std::abs(vertices[indices[i] * VERTEX_SIZE + VERTEX_NORMAL_OFFSET + j] -
+                                            expected[i * 3 + j]) > 1e-5f;
+            }
+            CHECK(nbDifferent == 0);
+            return (vertices);
+        };
+
+        // s off: each triangle gets its own corners
+        const std::vector<float> flatVertices = generateCube(std::vector<uint32_t>(12, 0), 36);
+        CHECK(flatVertices[VERTEX_NORMAL_OFFSET + 2] == doctest::Approx(-1));
+
+        // back and front in group 1, bottom and top in group 2, left and right flat:
+        // a corner per group, and one per flat triangle
+        const std::vector<uint32_t> mixedGroups = {1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0};
+        const std::vector<float> mixedVertices = generateCube(mixedGroups, 8 + 8 + 12);
+        CHECK(mixedVertices[VERTEX_NORMAL_OFFSET + 2] == doctest::Approx(-1));
+    }
+
+    SUBCASE("testing the partitions between the threads")
+    {
+        // a height field with its triangles in 3 groups, every corner has its own vertex
+        const size_t size = 120;
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> groups;
+        for (size_t y = 0; y < size; y++)
+        {
+            for (size_t x = 0; x < size; x++)
+            {
+                const size_t corners[6][2] = {{x, y}, {x + 1, y}, {x, y + 1}, {x + 1, y}, {x + 1, y + 1}, {x, y + 1}};
+                for (size_t i = 0; i < 6; i++)
+                {
+                    const float cx = corners[i][0];
+                    const float cy = corners[i][1];
+                    const float vertex[VERTEX_SIZE] = {cx, cy, std::sin(cx * 0.3f) * std::cos(cy * 0.2f), 1};
+                    vertices.insert(vertices.end(), vertex, vertex + VERTEX_SIZE);
+                    indices.push_back(indices.size());
+                }
+                groups.push_back((x / 7 + y / 5) % 3);
+                groups.push_back((x / 7 + y / 5) % 3);
+            }
+        }
+        const std::vector<float> expected = referenceNormals(vertices, indices, groups);
+        NormalGenerator::generate(vertices.data(), {VERTEX_SIZE, VERTEX_NORMAL_OFFSET}, indices.data(),
+                                  groups.size(), groups.data(), 4);
+        size_t nbDifferent = 0;
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            for (size_t j = 0; j < 3; j++)
+                nbDifferent += std::abs(vertices[i * VERTEX_SIZE + VERTEX_NORMAL_OFFSET + j] - expected[i * 3 + j]) >
+                               1e-5f;
+        }
+        CHECK(nbDifferent == 0);
+        CHECK(NormalGenerator::getNbThreads(1) == 1);
+    }
+}
+
+TEST_CASE("test the mesh streamer")
+{
+    const std::string objectPath = (std::filesystem::temp_directory_path() / "scop_test.obj").string();
+    const std::string cachePath = (std::filesystem::temp_directory_path() / "scop_test.smc").string();
+
+    SUBCASE("testing the growth of a spill file")
+    {
+        SpillFile spill;
+        const std::vector<unsigned int> values(SPILL_MIN_CAPACITY / sizeof(unsigned int), 42);
+        spill.append(values.data(), values.size() * sizeof(unsigned int));
+        spill.append(values.data(), sizeof(unsigned int));
+        CHECK(spill.getSize() == SPILL_MIN_CAPACITY + sizeof(unsigned int));
+        CHECK(spill.capacity == SPILL_MIN_CAPACITY * 2);
+        CHECK(reinterpret_cast<const unsigned int *>(spill.getData())[values.size()] == 42);
+        spill.clear();
+        CHECK(spill.getSize() == 0);
+        CHECK(spill.capacity == SPILL_MIN_CAPACITY * 2);
+    }
+
+    SUBCASE("testing the conversion of an object to a mesh cache")
+    {
+        MeshStreamer streamer("srcs_bonus/tester/ressources/objectStream.obj");
+        CHECK(streamer.getNbVertices() == 7);
+        CHECK(streamer.getNbIndices() == 9);
+        streamer.save(cachePath);
+
+        // the 2 triangles of the quad share its corners
+        const s_meshBuffers buffers = MeshStreamer::loadCache(cachePath);
+        const uint32_t indices[9] = {0, 1, 2, 0, 2, 3, 4, 5, 6};
+        CHECK(buffers.nbVertices == 7);
+        CHECK(buffers.nbIndices == 9);
+        CHECK(std::equal(indices, indices + 9, buffers.indices));
+        const float *quad = buffers.vertices;
+        const float *triangle = buffers.vertices + 4 * MESH_CACHE_VERTEX_SIZE;
+        CHECK(quad[0] == doctest::Approx(-1 - 3.0f / 7));
+        CHECK(quad[1] == doctest::Approx(-1 - 2.0f / 7));
+        CHECK(quad[2] == doctest::Approx(-3.0f / 7));
+        CHECK(quad[3] == 1);
+        CHECK(quad[MESH_CACHE_VERTEX_SIZE * 2 + 4] == 1);
+        CHECK(quad[MESH_CACHE_VERTEX_SIZE * 2 + 5] == 1);
+        CHECK(quad[7] == quad[MESH_CACHE_VERTEX_SIZE * 3 + 7]);
+        CHECK(triangle[MESH_CACHE_VERTEX_SIZE + 0] == doctest::Approx(2 - 3.0f / 7));
+        CHECK(triangle[MESH_CACHE_VERTEX_SIZE + 4] == 0);
+        CHECK(quad[12] == doctest::Approx(1));
+        CHECK(quad[MESH_CACHE_VERTEX_SIZE * 3 + 12] == doctest::Approx(1));
+        CHECK(triangle[12] == doctest::Approx(1));
+        CHECK(triangle[MESH_CACHE_VERTEX_SIZE + 12] == -1);
+
+        std::vector<Object> objects = ObjectParser::parseObjectFile(cachePath);
+        CHECK(objects.size() == 1);
+        CHECK(objects[0].getSubMeshes().size() == 1);
+        CHECK(objects[0].getSubMeshes()[0].materialID == NO_MATERIAL);
+        CHECK(objects[0].getSubMeshes()[0].nbFaces == 3);
+        std::filesystem::remove(cachePath);
+    }
+
+    SUBCASE("testing the lines across the blocks")
+    {
+        std::ofstream file(objectPath);
+        const size_t nbTriangles = 30000;
+        for (size_t i = 0; i < nbTriangles; i++)
+            file << "v 0.123456 0.123456 0.123456\nv 1.123456 0.123456 0.123456\nv 0.123456 1.123456 0.123456\n"
+                 << "f -3 -2 -1\n";
+        file.close();
+        CHECK(std::filesystem::file_size(objectPath) > STREAM_BUFFER_SIZE * 2);
+
+        MeshStreamer streamer(objectPath);
+        CHECK(streamer.getNbVertices() == nbTriangles * 3);
+        streamer.save(cachePath);
+        const s_meshBuffers buffers = MeshStreamer::loadCache(cachePath);
+        CHECK(buffers.nbIndices == nbTriangles * 3);
+        CHECK(buffers.vertices[(nbTriangles * 3 - 1) * MESH_CACHE_VERTEX_SIZE + 1] == doctest::Approx(2.0f / 3));
+        std::filesystem::remove(cachePath);
+    }
+
+    SUBCASE("testing the invalid files")
+    {
+        std::ofstream file(objectPath);
+        file << "v 0 0 0\n#" << std::string(STREAM_BUFFER_SIZE, ' ') << "\nf 1 1 1\n";
+        file.close();
+        CHECK_THROWS(MeshStreamer(objectPath));
+        file.open(objectPath);
+        file << "v 0 0 0\nf 1 2 1\n";
+        file.close();
+        CHECK_THROWS(MeshStreamer(objectPath));
+        file.open(objectPath);
+        file << "v 0 0 0\nvp 0 0 1\nf 1 1 1\n";
+        file.close();
+        CHECK_THROWS(MeshStreamer(objectPath));
+        CHECK_THROWS(MeshStreamer::loadCache("srcs_bonus/tester/ressources/objectStream.obj"));
+    }
+    std::filesystem::remove(objectPath);
+}
+
+TEST_CASE("test the frame pacer")
+{
+    SUBCASE("testing the modes")
+    {
+        FramePacer framePacer(VSYNC_MODE, 60, true);
+        CHECK(framePacer.isVsync());
+        framePacer.nextMode();
+        CHECK(framePacer.getMode() == UNCAPPED_MODE);
+        framePacer.nextMode();
+        CHECK(framePacer.getModeName() == "60 fps");
+        framePacer.nextMode();
+        CHECK(framePacer.getMode() == VSYNC_MODE);
+        CHECK_THROWS(framePacer.setFPS(0));
+        CHECK_THROWS(framePacer.setFPS(-30));
+    }
+
+    SUBCASE("testing the wait for events while a key is held")
+    {
+        FramePacer framePacer(VSYNC_MODE, 60, true);
+        CHECK(framePacer.canWaitEvents(false, false));
+        CHECK_FALSE(framePacer.canWaitEvents(true, false));
+        CHECK_FALSE(framePacer.canWaitEvents(false, true));
+        framePacer.setIdleMode(false);
+        CHECK_FALSE(framePacer.canWaitEvents(false, false));
+    }
+
+    SUBCASE("testing the wait between frames")
+    {
+        FramePacer framePacer(FIXED_FPS_MODE, 200, true);
+        double start = FramePacer::getTime();
+        for (int i = 0; i < 5; i++)
+            framePacer.waitNextFrame(true);
+        CHECK(FramePacer::getTime() - start >= 4.0 / 200);
+
+        framePacer.setMode(UNCAPPED_MODE);
+        start = FramePacer::getTime();
+        framePacer.waitNextFrame(true);
+        CHECK(FramePacer::getTime() - start < 1.0 / 200);
+
+        framePacer.setMode(FIXED_FPS_MODE);
+        start = FramePacer::getTime();
+        framePacer.waitNextFrame(false);
+        CHECK(FramePacer::getTime() - start < 1.0 / 200);
+
+        start = FramePacer::getTime();
+        FramePacer::sleepUntil(start + 0.005);
+        CHECK(FramePacer::getTime() >= start + 0.005);
+    }
+}
+
+TEST_CASE("test the frame encoder")
+{
+    // the bottom row first: red, green, then blue, white
+    const s_capturedFrame frame = {2, 2, {255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 255, 255}};
+
+    CHECK(FrameEncoder::getFormat("video.y4m") == Y4M_STREAM);
+    CHECK(FrameEncoder::getFormat("y4m") == PPM_SEQUENCE);
+    CHECK(FrameEncoder::getFormat("frames/capture") == PPM_SEQUENCE);
+    CHECK(FrameEncoder::getFramePath("capture", 42) == "capture_00042.ppm");
+
+    SUBCASE("PPM")
+    {
+        const std::vector<unsigned char> file = FrameEncoder::encodePPM(frame);
+        const std::string header = "P6\n2 2\n255\n";
+        const std::vector<unsigned char> pixels = {0, 0, 255, 255, 255, 255, 255, 0, 0, 0, 255, 0};
+
+        REQUIRE(file.size() == header.size() + pixels.size());
+        CHECK(std::string(file.begin(), file.begin() + header.size()) == header);
+        CHECK(std::vector<unsigned char>(file.begin() + header.size(), file.end()) == pixels);
+    }
+    SUBCASE("Y4M")
+    {
+        const std::vector<unsigned char> data = FrameEncoder::encodeY4MFrame(frame);
+        const std::vector<unsigned char> planes = {29, 255, 76, 150, 128, 128};
+
+        CHECK(FrameEncoder::getY4MHeader(800, 600, 60) == "YUV4MPEG2 W800 H600 F60:1 Ip A1:1 C420jpeg\n");
+        REQUIRE(data.size() == 6 + planes.size());
+        CHECK(std::string(data.begin(), data.begin() + 6) == "FRAME\n");
+        CHECK(std::vector<unsigned char>(data.begin() + 6, data.end()) == planes);
+
+        // an odd width cuts the last block of the chroma
+        const s_capturedFrame odd = {3, 1, {255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255}};
+        const std::vector<unsigned char> oddData = FrameEncoder::encodeY4MFrame(odd);
+        REQUIRE(oddData.size() == 6 + 3 + 2 * 2);
+        CHECK(oddData[6 + 3] == 64);
+        CHECK(oddData[6 + 4] == 255);
+        CHECK(oddData[6 + 5] == 138);
+        CHECK(oddData[6 + 6] == 107);
+    }
+    SUBCASE("background thread")
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string prefix = (directory / "scop_test_capture").string();
+        const std::string video = (directory / "scop_test_capture.y4m").string();
+        {
+            FrameEncoder encoder(prefix, 60);
+            s_capturedFrame copy = frame;
+            CHECK(encoder.push(std::move(copy)));
+            encoder.finish();
+            CHECK(encoder.getNbWritten() == 1);
+
+            // nothing is accepted once the encoder is finished
+            copy = frame;
+            CHECK(!encoder.push(std::move(copy)));
+            CHECK(encoder.getNbDropped() == 1);
+        }
+        CHECK(std::filesystem::file_size(FrameEncoder::getFramePath(prefix, 0)) == 11 + 12);
+        std::filesystem::remove(FrameEncoder::getFramePath(prefix, 0));
+        {
+            // a video keeps the size of its first frame
+            FrameEncoder encoder(video, 30);
+            const s_capturedFrame resized = {1, 1, {0, 0, 0, 255}};
+            for (size_t i = 0; i < 3; i++)
+            {
+                s_capturedFrame copy = (i == 1) ? resized : frame;
+                CHECK(encoder.push(std::move(copy)));
+            }
+            encoder.finish();
+            CHECK(encoder.getNbWritten() == 2);
+            CHECK(encoder.getNbDropped() == 1);
+        }
+        const std::string header = FrameEncoder::getY4MHeader(2, 2, 30);
+        CHECK(std::filesystem::file_size(video) == header.size() + (6 + 6) * 2);
+        {
+            // an offline renderer waits for the encoder instead of dropping its frames
+            FrameEncoder encoder(video, 30);
+            for (size_t i = 0; i < CAPTURE_QUEUE_SIZE * 2; i++)
+            {
+                s_capturedFrame copy = frame;
+                CHECK(encoder.push(std::move(copy), true));
+            }
+            encoder.finish();
+            CHECK(encoder.getNbWritten() == CAPTURE_QUEUE_SIZE * 2);
+            CHECK(encoder.getNbDropped() == 0);
+        }
+        std::filesystem::remove(video);
+    }
+}
+
+TEST_CASE("test the software rasterizer")
+{
+    const unsigned char clearColor[4] = {51, 77, 77, 255};
+
+    CHECK_THROWS(SoftwareRasterizer(0, 10));
+    CHECK(SoftwareRasterizer::mirror(0, 3) == 0);
+    CHECK(SoftwareRasterizer::mirror(3, 3) == 2);
+    CHECK(SoftwareRasterizer::mirror(5, 3) == 0);
+    CHECK(SoftwareRasterizer::mirror(-1, 3) == 0);
+    CHECK(SoftwareRasterizer::mirror(-4, 3) == 2);
+
+    SUBCASE("near plane")
+    {
+        s_rasterVertex vertices[3] = {};
+        const s_rasterVertex *triangle[3] = {&vertices[0], &vertices[1], &vertices[2]};
+        s_rasterVertex polygon[4];
+
+        for (size_t i = 0; i < 3; i++)
+            vertices[i].clip[3] = 1;
+        vertices[1].clip[2] = -3; // behind the near plane
+        vertices[1].color[0] = 1;
+        REQUIRE(SoftwareRasterizer::clipNearPlane(triangle, polygon) == 4);
+        // the new vertices are on the plane, their attributes are interpolated
+        CHECK(polygon[1].clip[2] == doctest::Approx(-1));
+        CHECK(polygon[1].color[0] == doctest::Approx(1.0f / 3));
+        CHECK(polygon[2].clip[2] == doctest::Approx(-1));
+        vertices[0].clip[2] = -3;
+        CHECK(SoftwareRasterizer::clipNearPlane(triangle, polygon) == 3);
+        vertices[2].clip[2] = -3;
+        CHECK(SoftwareRasterizer::clipNearPlane(triangle, polygon) == 0);
+    }
+    SUBCASE("scene")
+    {
+        std::vector<Object> objects = ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/object.obj");
+        for (size_t i = 0; i < objects.size(); i++)
+            objects[i].prepare();
+        Camera camera;
+        camera.setViewport(70, 50);
+        Matrix rotation(4, 4);
+        rotation.identity();
+        SoftwareRasterizer rasterizer(70, 50);
+        rasterizer.setScene(objects, DEFAULT_TEXTURE_PATH);
+        REQUIRE(rasterizer.textures.size() == 1);
+
+        rasterizer.render(camera, rotation, 0, false);
+        CHECK(rasterizer.getNbTriangles() == 2);
+        CHECK(std::equal(clearColor, clearColor + 4, rasterizer.getPixel(0, 0)));
+        CHECK(std::equal(clearColor, clearColor + 4, rasterizer.getPixel(69, 49)));
+        CHECK(rasterizer.getDepth(0, 0) == 1);
+        CHECK(!std::equal(clearColor, clearColor + 4, rasterizer.getPixel(35, 25)));
+        CHECK(rasterizer.getDepth(35, 25) > 0);
+        CHECK(rasterizer.getDepth(35, 25) < 1);
+
+        // the texture only, without light
+        rasterizer.render(camera, rotation, 1, false);
+        float texel[3];
+        rasterizer.sampleTexture(rasterizer.textures[0], 0.5f, 0.5f, texel);
+        for (size_t i = 0; i < 3; i++)
+            CHECK(std::abs(rasterizer.getPixel(35, 25)[i] - texel[i] * 255) <= 24);
+
+        // a frame is a copy of the color buffer
+        const s_capturedFrame frame = rasterizer.getFrame();
+        CHECK(frame.width == 70);
+        CHECK(frame.height == 50);
+        CHECK(frame.pixels == rasterizer.color);
+
+        // the scene turned away from the camera is still drawn, its back faces too
+        rasterizer.render(camera, Matrix::rotate(rotation, M_PI, camera.getUpDirection()), 0, true);
+        CHECK(!std::equal(clearColor, clearColor + 4, rasterizer.getPixel(35, 25)));
+    }
+}
+
+TEST_CASE("test the resolution scaler")
+{
+    ResolutionScaler scaler(0.012, true);
+
+    CHECK_THROWS_AS(scaler.setBudget(0), std::exception);
+    CHECK(scaler.isNative());
+    CHECK(scaler.getSize(800, 600) == std::array<int, 2>{800, 600});
+
+    // a still image stays at the native resolution
+    scaler.update(0, false);
+    scaler.addFrameTime(0.048, 1);
+    CHECK(scaler.isNative());
+
+    // a frame 4 times too long needs half the width and half the height, the scale moves by steps
+    scaler.update(1, true);
+    scaler.addFrameTime(0.048, 1);
+    CHECK(scaler.getScale() == doctest::Approx(1 - RESOLUTION_MAX_STEP));
+    for (size_t i = 0; i < 50; i++)
+    {
+        const float scale = scaler.getScale();
+        scaler.addFrameTime(0.048 * scale * scale, scale);
+    }
+    CHECK(scaler.getScale() > 0.45f);
+    CHECK(scaler.getScale() < 0.55f);
+    const std::array<int, 2> size = scaler.getSize(800, 600);
+    CHECK(size[0] == std::lround(800 * scaler.getScale()));
+    CHECK(size[1] == std::lround(600 * scaler.getScale()));
+
+    // a late measure of a frame rendered at the native resolution is corrected
+    const float scale = scaler.getScale();
+    scaler.addFrameTime(0.048, 1);
+    CHECK(scaler.getScale() == doctest::Approx(scale));
+
+    // the scale never goes below the minimum
+    for (size_t i = 0; i < 50; i++)
+        scaler.addFrameTime(1, scaler.getScale());
+    CHECK(scaler.getScale() == doctest::Approx(RESOLUTION_MIN_SCALE));
+    CHECK(scaler.getSize(2, 2) == std::array<int, 2>{1, 1});
+
+    // back to the native resolution once the view has been still long enough
+    scaler.update(1 + RESOLUTION_SETTLE_TIME / 2, false);
+    CHECK(!scaler.isNative());
+    scaler.update(1 + RESOLUTION_SETTLE_TIME, false);
+    CHECK(scaler.isNative());
+
+    // disabled, the resolution never drops
+    scaler.setEnabled(false);
+    scaler.update(2, true);
+    scaler.addFrameTime(1, 1);
+    CHECK(scaler.isNative());
+}
+
+TEST_CASE("test the profiler")
+{
+    Profiler::clear();
+    Profiler::setEnabled(false);
+
+    SUBCASE("testing the scoped timers")
+    {
+        {
+            const Profiler::Scope profile("disabled");
+        }
+        CHECK(Profiler::getEvents().empty());
+        Profiler::setEnabled(true);
+        {
+            const Profiler::Scope profile("enabled");
+            FramePacer::sleepUntil(FramePacer::getTime() + 0.002);
+        }
+        Profiler::nextFrame();
+        {
+            const Profiler::Scope profile("nextFrame");
+        }
+        std::vector<s_profileEvent> events = Profiler::getEvents();
+        CHECK(events.size() == 2);
+        CHECK(std::string(events[0].name) == "enabled");
+        CHECK(events[0].clock == CPU_CLOCK);
+        CHECK(events[0].duration >= 0.002);
+        CHECK(events[0].frame == 0);
+        CHECK(events[1].frame == 1);
+        CHECK(events[1].start >= events[0].start + events[0].duration);
+    }
+
+    SUBCASE("testing the ring buffer")
+    {
+        for (size_t i = 0; i < PROFILER_CAPACITY + 10; i++)
+            Profiler::record((i < 10) ? "old" : "new", CPU_CLOCK, Profiler::getTime(), 0);
+        std::vector<s_profileEvent> events = Profiler::getEvents();
+        CHECK(events.size() == PROFILER_CAPACITY);
+        CHECK(std::string(events.front().name) == "new");
+        CHECK(std::string(events.back().name) == "new");
+    }
+
+    SUBCASE("testing the chrome trace")
+    {
+        Profiler::record("processInput", CPU_CLOCK, Profiler::getTime(), 0.001);
+        Profiler::record("renderObject", GPU_CLOCK, Profiler::getTime(), 0.002);
+        const std::string trace = Profiler::toChromeTrace();
+        CHECK(trace.find("{\"traceEvents\":[") == 0);
+        CHECK(trace.find("\"name\":\"processInput\",\"cat\":\"cpu\",\"ph\":\"X\"") != std::string::npos);
+        CHECK(trace.find("\"dur\":2000.000,\"pid\":1,\"tid\":1") != std::string::npos);
+
+        const std::string path = (std::filesystem::temp_directory_path() / "scop_test_trace.json").string();
+        CHECK_NOTHROW(Profiler::dumpChromeTrace(path));
+        CHECK(std::filesystem::file_size(path) == trace.size());
+        std::filesystem::remove(path);
+        CHECK_THROWS(Profiler::dumpChromeTrace("dontExist/trace.json"));
+    }
+    Profiler::setEnabled(false);
+    Profiler::clear();
+}
+
+TEST_CASE("test the vertex layout")
+{
+    const std::vector<Vertex> vertices = {{1, 2, 3, 1, 0, 1, 0, 0.5f, 0.5f, 0.5f, 0, 0, 1, 9},
+                                          {4, 5, 6, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 9}};
+    const std::vector<float> expected = {1, 2, 3, 1, 0, 1, 0, 0.5f, 0.5f, 0.5f, 0, 0, 1,
+                                         4, 5, 6, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0};
+    const std::string inputs =
+        "layout (location = 3) in vec3 aTranslation;\nlayout (location = 4) in vec3 aInstanceColor;\n";
+
+    CHECK(ObjectVertexLayout::size == VERTEX_SIZE);
+    CHECK(ObjectVertexLayout::getOffset(COLOR_LOCATION) == 7);
+    CHECK(ObjectVertexLayout::getOffset(NORMAL_LOCATION) == 10);
+    CHECK(InstanceLayout::size * sizeof(float) == sizeof(s_instance));
+    CHECK(ObjectVertexLayout::getShaderInputs().find("layout (location = 5) in vec3 aNormal;\n") != std::string::npos);
+    CHECK(InstanceLayout::getShaderInputs() == inputs);
+
+    // the floats after the layout are ignored
+    const std::unique_ptr<float[]> array = ObjectVertexLayout::pack(vertices);
+    CHECK(std::equal(expected.begin(), expected.end(), array.get()));
+
+    const std::string code = "// comment\n#version 330 core\nvoid main() {}";
+    CHECK(Shader::insertAfterVersion(code, "in vec4 a;\n", "test.vs") ==
+          "// comment\n#version 330 core\nin vec4 a;\nvoid main() {}");
+    CHECK(Shader::insertAfterVersion(code, "", "test.vs") == code);
+    CHECK_THROWS_AS(Shader::insertAfterVersion("void main() {}", "in vec4 a;\n", "test.vs"), std::exception);
+}
+
+// a handle that counts its names instead of calling OpenGL
+static unsigned int nbFakeNames = 0;
+static unsigned int nbFakeDeletions = 0;
+
+static unsigned int createFakeName()
+{
+    return (++nbFakeNames);
+}
+
+static void deleteFakeName(unsigned int)
+{
+    nbFakeDeletions++;
+}
+
+typedef GLHandle<createFakeName, deleteFakeName> FakeHandle;
+
+TEST_CASE("test the GL handles")
+{
+    CHECK(!std::is_copy_constructible_v<FakeHandle>);
+    CHECK(!std::is_copy_constructible_v<Object>);
+    CHECK(!std::is_copy_constructible_v<Shader>);
+    CHECK(std::is_nothrow_move_constructible_v<BufferHandle>);
+    CHECK(std::is_nothrow_move_assignable_v<TextureHandle>);
+    CHECK(std::is_move_constructible_v<Object>);
+
+    {
+        FakeHandle first = FakeHandle::create();
+        CHECK(first.get() == 1);
+        FakeHandle second(std::move(first));
+        CHECK(first.get() == 0);
+        CHECK(second.get() == 1);
+
+        // the names follow the handles when the vector grows
+        std::vector<FakeHandle> handles;
+        handles.push_back(std::move(second));
+        for (size_t i = 0; i < 100; i++)
+            handles.push_back(FakeHandle::create());
+        CHECK(nbFakeDeletions == 0);
+        CHECK(handles[0].get() == 1);
+
+        handles[0] = FakeHandle::create();
+        CHECK(nbFakeDeletions == 1);
+        handles[1].reset();
+        handles[1].reset();
+        CHECK(nbFakeDeletions == 2);
+    }
+    // every name is deleted once
+    CHECK(nbFakeDeletions == nbFakeNames);
+
+    // the objects are moved, not copied
+    std::vector<Object> objects = ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/object.obj");
+    REQUIRE(objects.size() > 0);
+    const size_t nbFaces = objects[0].getFaces().size();
+    std::vector<Object> moved = std::move(objects);
+    Object object(std::move(moved[0]));
+    CHECK(object.getFaces().size() == nbFaces);
+    CHECK(moved[0].getFaces().size() == 0);
+    CHECK(!object.isVAOInit());
+}
+
+TEST_CASE("test the camera")
+{
+    Camera camera;
+
+    // looks from (0, 0, 3) to -z
+    CHECK(camera.dirtyFlags == CAMERA_ALL_DIRTY);
+    CHECK(camera.getFrontDirection().getZ() == doctest::Approx(-1));
+    CHECK(camera.dirtyFlags == (CAMERA_VIEW_DIRTY | CAMERA_PROJECTION_DIRTY));
+    CHECK(camera.getView().getData(3, 2) == doctest::Approx(-3));
+    CHECK(camera.dirtyFlags == 0);
+
+    // the cache is kept until a change
+    const float *view = camera.getView().getData();
+    camera.setSpeed(5);
+    CHECK(camera.dirtyFlags == 0);
+    CHECK(camera.getView().getData() == view);
+    camera.addToYaw(10);
+    CHECK(camera.dirtyFlags == (CAMERA_DIRECTIONS_DIRTY | CAMERA_VIEW_DIRTY));
+    camera.addToYaw(-10);
+    camera.getViewProjection();
+    CHECK(camera.dirtyFlags == 0);
+
+    // the projection follows the framebuffer
+    camera.setViewport(800, 400);
+    CHECK(camera.getAspectRatio() == doctest::Approx(2));
+    CHECK(camera.dirtyFlags == CAMERA_PROJECTION_DIRTY);
+    camera.setViewport(0, 0);
+    CHECK(camera.getAspectRatio() == doctest::Approx(2));
+    const Matrix projection = Matrix::perspective(camera.getFov(), 2, CAMERA_NEAR_PLANE, CAMERA_FAR_PLANE);
+    for (unsigned int i = 0; i < 16; i++)
+        CHECK(camera.getProjection().getData()[i] == doctest::Approx(projection.getData()[i]));
+    const Matrix viewProjection = camera.getView() * camera.getProjection();
+    for (unsigned int i = 0; i < 16; i++)
+        CHECK(camera.getViewProjection().getData()[i] == doctest::Approx(viewProjection.getData()[i]));
+
+    // the planes of the frustum
+    const std::array<s_plane, NB_FRUSTUM_PLANES> &frustum = camera.getFrustum();
+    CHECK(frustum[NEAR_PLANE].normal[2] == doctest::Approx(-1));
+    CHECK(frustum[NEAR_PLANE].distance == doctest::Approx(3 - CAMERA_NEAR_PLANE));
+    CHECK(frustum[FAR_PLANE].normal[2] == doctest::Approx(1));
+    CHECK(camera.isSphereVisible({0, 0, 0}, 1));
+    CHECK(!camera.isSphereVisible({0, 0, 10}, 1));
+    CHECK(camera.isSphereVisible({0, 0, 10}, 8));
+    CHECK(!camera.isSphereVisible({0, 0, -200}, 1));
+    CHECK(!camera.isSphereVisible({50, 0, 0}, 1));
+    CHECK(camera.isSphereVisible({2.5f, 0, 0}, 0.1f));
+    CHECK(!camera.isSphereVisible({0, 2.5f, 0}, 0.1f));
+}
+
+TEST_CASE("test the shader variants")
+{
+    CHECK(ShaderVariants::getDefines(0) == "");
+    CHECK(ShaderVariants::getDefines(COLOR_FEATURE | LIGHTING_FEATURE) == "#define USE_COLOR\n#define USE_LIGHTING\n");
+    CHECK(ShaderVariants::getDefines(TEXTURE_FEATURE) == "#define USE_TEXTURE\n");
+    CHECK(!ShaderVariants::isValid(0));
+    CHECK(!ShaderVariants::isValid(LIGHTING_FEATURE));
+    CHECK(!ShaderVariants::isValid(NB_SHADER_VARIANTS));
+    CHECK(ShaderVariants::isValid(COLOR_FEATURE | TEXTURE_FEATURE | LIGHTING_FEATURE));
+
+    // the cheapest variant for the display
+    CHECK(ShaderVariants::selectFeatures(0, false, false) == COLOR_FEATURE);
+    CHECK(ShaderVariants::selectFeatures(1, false, false) == TEXTURE_FEATURE);
+    CHECK(ShaderVariants::selectFeatures(0.5f, false, false) == (COLOR_FEATURE | TEXTURE_FEATURE));
+    CHECK(ShaderVariants::selectFeatures(0, true, false) == (COLOR_FEATURE | LIGHTING_FEATURE));
+    CHECK(ShaderVariants::selectFeatures(1, true, false) == (TEXTURE_FEATURE | LIGHTING_FEATURE));
+    CHECK(ShaderVariants::selectFeatures(0.5f, true, true) == COLOR_FEATURE);
+    for (unsigned int i = 0; i <= 10; i++)
+    {
+        CHECK(ShaderVariants::isValid(ShaderVariants::selectFeatures(i / 10.0f, i % 2, false)));
+        CHECK(ShaderVariants::isValid(ShaderVariants::selectFeatures(i / 10.0f, i % 2, true)));
+    }
+}
+
+TEST_CASE("test the object picker")
+{
+    const unsigned int background[4] = {0, 0, 0, 0};
+    const unsigned int face[4] = {3, 1, 42, 0};
+    const std::vector<s_subMesh> subMeshes = {{NO_MATERIAL, 0, 10}, {7, 10, 1}, {2, 11, 5}};
+
+    CHECK(!ObjectPicker::decode(background).hit);
+    const s_pickResult result = ObjectPicker::decode(face);
+    CHECK(result.hit);
+    CHECK(result.object == 2);
+    CHECK(result.instance == 1);
+    CHECK(result.face == 42);
+
+    // the material of a face is the one of its sub mesh
+    CHECK(ObjectPicker::findSubMesh(subMeshes, 0) == 0);
+    CHECK(ObjectPicker::findSubMesh(subMeshes, 9) == 0);
+    CHECK(ObjectPicker::findSubMesh(subMeshes, 10) == 1);
+    CHECK(ObjectPicker::findSubMesh(subMeshes, 11) == 2);
+    CHECK(ObjectPicker::findSubMesh(subMeshes, 15) == 2);
+    CHECK_THROWS(ObjectPicker::findSubMesh(subMeshes, 16));
+    CHECK_THROWS(ObjectPicker::findSubMesh({}, 0));
+}
+
+TEST_CASE("test the program cache")
+{
+    const uint64_t key = ProgramCache::getKey("vertex", "fragment", "driver");
+    s_programBinary binary = {0x1234, {1, 2, 3, 4, 5}};
+    s_programBinary parsed = {0, {}};
+
+    // any change of the sources or of the driver changes the key
+    CHECK(key == ProgramCache::getKey("vertex", "fragment", "driver"));
+    CHECK(key != ProgramCache::getKey("vertex ", "fragment", "driver"));
+    CHECK(key != ProgramCache::getKey("vertex", "fragment", "other driver"));
+    CHECK(key != ProgramCache::getKey("vertexf", "ragment", "driver"));
+    CHECK(ProgramCache::getPath(0xabc) == std::string(PROGRAM_CACHE_DIRECTORY) + "/abc" + PROGRAM_CACHE_EXTENSION);
+
+    std::vector<unsigned char> file = ProgramCache::serialize(key, binary);
+    CHECK(file.size() == PROGRAM_CACHE_HEADER_SIZE + binary.data.size());
+    CHECK(ProgramCache::parse(file, key, parsed));
+    CHECK(parsed.format == binary.format);
+    CHECK(parsed.data == binary.data);
+
+    // a file of other sources, cut short or of another version is compiled again
+    CHECK(!ProgramCache::parse(file, key + 1, parsed));
+    CHECK(!ProgramCache::parse(std::vector<unsigned char>(file.begin(), file.end() - 1), key, parsed));
+    CHECK(!ProgramCache::parse(std::vector<unsigned char>(file.begin(), file.begin() + 10), key, parsed));
+    file[3] = '2';
+    CHECK(!ProgramCache::parse(file, key, parsed));
+    binary.data.clear();
+    CHECK(!ProgramCache::parse(ProgramCache::serialize(key, binary), key, parsed));
+
+    // without the functions of the driver, nothing is read nor written
+    CHECK(!ProgramCache::isSupported());
+    CHECK(!ProgramCache::load(0, "vertex", "fragment"));
+    CHECK(!ProgramCache::save(0, "vertex", "fragment"));
+}
+
+TEST_CASE("test the job system")
+{
+    JobSystem jobs(3);
+
+    SUBCASE("testing a parallel loop")
+    {
+        std::vector<size_t> values(10000, 0);
+        size_t nbWrong = 0;
+        size_t nbIndices = 0;
+
+        jobs.parallelFor(values.size(), 16, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+                values[i] += i;
+        });
+        for (size_t i = 0; i < values.size(); i++)
+            nbWrong += (values[i] != i);
+        CHECK(nbWrong == 0);
+        jobs.parallelFor(0, 1, [&](size_t first, size_t last) { nbIndices += last - first + 1; });
+        jobs.parallelFor(5, 16, [&](size_t first, size_t last) { nbIndices += last - first; });
+        CHECK(nbIndices == 5);
+        CHECK(jobs.getNbThreads() == 4);
+        CHECK(JobSystem(0).getNbThreads() == 1);
+    }
+
+    SUBCASE("testing the jobs started by a job")
+    {
+        std::atomic<size_t> total(0);
+
+        jobs.parallelFor(8, 1, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+                jobs.parallelFor(1000, 10, [&](size_t start, size_t end) { total += end - start; });
+        });
+        CHECK(total == 8000);
+    }
+
+    SUBCASE("testing a graph of jobs")
+    {
+        std::mutex mutex;
+        std::string order;
+        JobSystem::Graph graph;
+        auto record = [&](char name) {
+            return ([&, name]() {
+                const std::lock_guard<std::mutex> lock(mutex);
+                order += name;
+            });
+        };
+
+        const size_t a = graph.add(record('a'));
+        const size_t b = graph.add(record('b'), {a});
+        const size_t c = graph.add(record('c'), {a});
+        graph.add(record('d'), {b, c});
+        jobs.run(graph);
+        CHECK((order == "abcd" || order == "acbd"));
+        order.clear();
+        jobs.run(graph);
+        CHECK(order.size() == 4);
+        CHECK_THROWS_AS(graph.add(record('e'), {4}), std::exception);
+        CHECK(graph.getSize() == 4);
+    }
+
+    SUBCASE("testing the exceptions of the jobs")
+    {
+        JobSystem::Group group;
+        JobSystem::Graph graph;
+        std::atomic<size_t> nbDone(0);
+        bool dependentRun = false;
+
+        for (size_t i = 0; i < 10; i++)
+        {
+            jobs.run(group, [&nbDone, i]() {
+                if (i == 5)
+                    throw(std::runtime_error("job 5"));
+                nbDone++;
+            });
+        }
+        CHECK_THROWS_WITH(jobs.wait(group), "job 5");
+        CHECK(nbDone == 9);
+        CHECK_NOTHROW(jobs.wait(group));
+
+        const size_t failing = graph.add([]() { throw(std::runtime_error("failed")); });
+        graph.add([&]() { dependentRun = true; }, {failing});
+        CHECK_THROWS_WITH(jobs.run(graph), "failed");
+        CHECK(!dependentRun);
+    }
+}
+
+TEST_CASE("test the load stats")
+{
+    LoadStats::reset();
+
+    SUBCASE("testing the counters of a loading")
+    {
+        LoadStats::setEnabled(true);
+        std::vector<Object> objects = ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/object.obj");
+        objects[0].GenerateFacesColor();
+        LoadStats::setEnabled(false);
+        CHECK(LoadStats::getSymbolCount("v") == 4);
+        CHECK(LoadStats::getSymbolCount("vt") == 4);
+        CHECK(LoadStats::getSymbolCount("f") == 1);
+        CHECK(LoadStats::getCounter(TRIANGLES) == 2);
+        CHECK(LoadStats::getCounter(EARS_CLIPPED) == 1);
+        CHECK(LoadStats::getCounter(UNIQUE_VERTICES) == 4);
+        CHECK(LoadStats::getCounter(DEDUP_HITS) == 0);
+        CHECK(LoadStats::getStage(COMBINE_VERTICES_STAGE).calls == 1);
+        CHECK(LoadStats::getStage(TRIANGULATE_STAGE).calls == 1);
+        CHECK(LoadStats::getCounter(UNIQUE_COLORED_VERTICES) + LoadStats::getCounter(COLORED_DEDUP_HITS) == 6);
+        CHECK(LoadStats::getStage(READ_FILE_STAGE).calls == 1);
+        CHECK(LoadStats::getStage(PARSE_STAGE).calls == 1);
+        CHECK(LoadStats::getStage(PARSE_STAGE).peakRSS > 0);
+        CHECK(LoadStats::getStage(GENERATE_COLORS_STAGE).calls == 1);
+        CHECK(LoadStats::getStage(UPLOAD_STAGE).calls == 0);
+
+        ObjectParser::parseObjectFile("srcs_bonus/tester/ressources/object.obj");
+        CHECK(LoadStats::getSymbolCount("v") == 4);
+        CHECK(LoadStats::getStage(PARSE_STAGE).calls == 1);
+    }
+
+    SUBCASE("testing the counters of another thread")
+    {
+        LoadStats::setEnabled(true);
+        std::async(std::launch::async, []() {
+            const LoadStats::Stage stage(UPLOAD_STAGE);
+            LoadStats::add(BYTES_UPLOADED, 8);
+            LoadStats::add(BYTES_UPLOADED, 4);
+        }).wait();
+        LoadStats::setEnabled(false);
+        CHECK(LoadStats::getCounter(BYTES_UPLOADED) == 12);
+        CHECK(LoadStats::getStage(UPLOAD_STAGE).calls == 1);
+    }
+
+    SUBCASE("testing the reports")
+    {
+        LoadStats::setEnabled(true);
+        LoadStats::countSymbol("v");
+        LoadStats::countSymbol("a\"b");
+        LoadStats::add(TRIANGLES, 12);
+        LoadStats::setEnabled(false);
+        const std::string json = LoadStats::toJSON();
+        CHECK(json.find("\"triangles\":12") != std::string::npos);
+        CHECK(json.find("\"lines\":{\"a\\\"b\":1,\"v\":1}") != std::string::npos);
+        CHECK(json.find("\"readFile\":{\"wallTimeMs\":0,\"calls\":0,\"peakRSSKB\":0}") != std::string::npos);
+        CHECK(LoadStats::toText().find("triangles: 12") != std::string::npos);
+    }
+    LoadStats::reset();
 }
\ No newline at end of file